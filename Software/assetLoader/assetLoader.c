@@ -0,0 +1,440 @@
+/*
+ * assetLoader.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Sends an asset pack (pictureFiles.txt from bitmapToArray) to a watch
+ * built with LOAD_NEW_IMAGES, using the framed protocol in
+ * storeInFlash_task.c. Works with any POSIX serial port or pty.
+ *
+ * By default only the 4 KB sectors whose CRC differs from what the
+ * watch already has are sent, --full sends the whole pack.
+ *
+ *   cc -O2 -o assetLoader assetLoader.c
+ *   ./assetLoader /dev/ttyUSB0 pictureFiles.txt [baud] [--full]
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+//Has to match storeInFlash_task.c
+#define LOADER_SOF 0xA5
+#define LOADER_FRAME_HELLO 0x01
+#define LOADER_FRAME_DATA 0x02
+#define LOADER_FRAME_END 0x03
+#define LOADER_FRAME_HASHES 0x04
+#define LOADER_FRAME_ACK 0x80
+#define LOADER_FRAME_NAK 0x81
+#define LOADER_HELLO_DELTA 0x01
+#define LOADER_MAX_PAYLOAD 4096
+#define LOADER_SECTOR_SIZE 4096
+#define LOADER_MAX_HASHES 256
+#define LOADER_HEADER_SIZE 8
+#define LOADER_CRC_SIZE 4
+#define LOADER_DEFAULT_BAUD 115200
+#define LOADER_REPLY_TIMEOUT_MS 1000
+//Checking the CRC of the whole pack in flash takes the watch a while
+#define LOADER_END_TIMEOUT_MS 15000
+#define LOADER_RETRIES 8
+//A watch that has just switched banks turns HELLOs away until its face
+//has moved over, which can take a few seconds
+#define LOADER_BUSY_WAIT_MS 1000
+
+typedef struct
+{
+        uint8_t type;
+        uint16_t length;
+        uint32_t offset;
+        uint8_t payload[LOADER_MAX_HASHES*4];
+} loaderReply_t;
+
+static int loaderPort = -1;
+
+static const uint32_t loaderCrcTable[256] =
+{
+        0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F,
+        0xE963A535, 0x9E6495A3, 0x0EDB8832, 0x79DCB8A4, 0xE0D5E91E, 0x97D2D988,
+        0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91, 0x1DB71064, 0x6AB020F2,
+        0xF3B97148, 0x84BE41DE, 0x1ADAD47D, 0x6DDDE4EB, 0xF4D4B551, 0x83D385C7,
+        0x136C9856, 0x646BA8C0, 0xFD62F97A, 0x8A65C9EC, 0x14015C4F, 0x63066CD9,
+        0xFA0F3D63, 0x8D080DF5, 0x3B6E20C8, 0x4C69105E, 0xD56041E4, 0xA2677172,
+        0x3C03E4D1, 0x4B04D447, 0xD20D85FD, 0xA50AB56B, 0x35B5A8FA, 0x42B2986C,
+        0xDBBBC9D6, 0xACBCF940, 0x32D86CE3, 0x45DF5C75, 0xDCD60DCF, 0xABD13D59,
+        0x26D930AC, 0x51DE003A, 0xC8D75180, 0xBFD06116, 0x21B4F4B5, 0x56B3C423,
+        0xCFBA9599, 0xB8BDA50F, 0x2802B89E, 0x5F058808, 0xC60CD9B2, 0xB10BE924,
+        0x2F6F7C87, 0x58684C11, 0xC1611DAB, 0xB6662D3D, 0x76DC4190, 0x01DB7106,
+        0x98D220BC, 0xEFD5102A, 0x71B18589, 0x06B6B51F, 0x9FBFE4A5, 0xE8B8D433,
+        0x7807C9A2, 0x0F00F934, 0x9609A88E, 0xE10E9818, 0x7F6A0DBB, 0x086D3D2D,
+        0x91646C97, 0xE6635C01, 0x6B6B51F4, 0x1C6C6162, 0x856530D8, 0xF262004E,
+        0x6C0695ED, 0x1B01A57B, 0x8208F4C1, 0xF50FC457, 0x65B0D9C6, 0x12B7E950,
+        0x8BBEB8EA, 0xFCB9887C, 0x62DD1DDF, 0x15DA2D49, 0x8CD37CF3, 0xFBD44C65,
+        0x4DB26158, 0x3AB551CE, 0xA3BC0074, 0xD4BB30E2, 0x4ADFA541, 0x3DD895D7,
+        0xA4D1C46D, 0xD3D6F4FB, 0x4369E96A, 0x346ED9FC, 0xAD678846, 0xDA60B8D0,
+        0x44042D73, 0x33031DE5, 0xAA0A4C5F, 0xDD0D7CC9, 0x5005713C, 0x270241AA,
+        0xBE0B1010, 0xC90C2086, 0x5768B525, 0x206F85B3, 0xB966D409, 0xCE61E49F,
+        0x5EDEF90E, 0x29D9C998, 0xB0D09822, 0xC7D7A8B4, 0x59B33D17, 0x2EB40D81,
+        0xB7BD5C3B, 0xC0BA6CAD, 0xEDB88320, 0x9ABFB3B6, 0x03B6E20C, 0x74B1D29A,
+        0xEAD54739, 0x9DD277AF, 0x04DB2615, 0x73DC1683, 0xE3630B12, 0x94643B84,
+        0x0D6D6A3E, 0x7A6A5AA8, 0xE40ECF0B, 0x9309FF9D, 0x0A00AE27, 0x7D079EB1,
+        0xF00F9344, 0x8708A3D2, 0x1E01F268, 0x6906C2FE, 0xF762575D, 0x806567CB,
+        0x196C3671, 0x6E6B06E7, 0xFED41B76, 0x89D32BE0, 0x10DA7A5A, 0x67DD4ACC,
+        0xF9B9DF6F, 0x8EBEEFF9, 0x17B7BE43, 0x60B08ED5, 0xD6D6A3E8, 0xA1D1937E,
+        0x38D8C2C4, 0x4FDFF252, 0xD1BB67F1, 0xA6BC5767, 0x3FB506DD, 0x48B2364B,
+        0xD80D2BDA, 0xAF0A1B4C, 0x36034AF6, 0x41047A60, 0xDF60EFC3, 0xA867DF55,
+        0x316E8EEF, 0x4669BE79, 0xCB61B38C, 0xBC66831A, 0x256FD2A0, 0x5268E236,
+        0xCC0C7795, 0xBB0B4703, 0x220216B9, 0x5505262F, 0xC5BA3BBE, 0xB2BD0B28,
+        0x2BB45A92, 0x5CB36A04, 0xC2D7FFA7, 0xB5D0CF31, 0x2CD99E8B, 0x5BDEAE1D,
+        0x9B64C2B0, 0xEC63F226, 0x756AA39C, 0x026D930A, 0x9C0906A9, 0xEB0E363F,
+        0x72076785, 0x05005713, 0x95BF4A82, 0xE2B87A14, 0x7BB12BAE, 0x0CB61B38,
+        0x92D28E9B, 0xE5D5BE0D, 0x7CDCEFB7, 0x0BDBDF21, 0x86D3D2D4, 0xF1D4E242,
+        0x68DDB3F8, 0x1FDA836E, 0x81BE16CD, 0xF6B9265B, 0x6FB077E1, 0x18B74777,
+        0x88085AE6, 0xFF0F6A70, 0x66063BCA, 0x11010B5C, 0x8F659EFF, 0xF862AE69,
+        0x616BFFD3, 0x166CCF45, 0xA00AE278, 0xD70DD2EE, 0x4E048354, 0x3903B3C2,
+        0xA7672661, 0xD06016F7, 0x4969474D, 0x3E6E77DB, 0xAED16A4A, 0xD9D65ADC,
+        0x40DF0B66, 0x37D83BF0, 0xA9BCAE53, 0xDEBB9EC5, 0x47B2CF7F, 0x30B5FFE9,
+        0xBDBDF21C, 0xCABAC28A, 0x53B39330, 0x24B4A3A6, 0xBAD03605, 0xCDD70693,
+        0x54DE5729, 0x23D967BF, 0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94,
+        0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D
+};
+
+//Same CRC32 as displayAssetCrc32 on the watch
+static uint32_t loaderCrc32(uint32_t CRC, const uint8_t DATA[], size_t SIZE)
+{
+        CRC = ~CRC;
+        for(size_t i=0;i<SIZE;i++)
+        {
+                CRC = (CRC>>8)^loaderCrcTable[(CRC^DATA[i])&0xFF];
+        }
+        return ~CRC;
+}
+static void loaderPut32(uint8_t *DATA, uint32_t VALUE)
+{
+        DATA[0] = VALUE;
+        DATA[1] = VALUE>>8;
+        DATA[2] = VALUE>>16;
+        DATA[3] = VALUE>>24;
+}
+static uint32_t loaderGet32(const uint8_t *DATA)
+{
+        return DATA[0]|(DATA[1]<<8)|(DATA[2]<<16)|((uint32_t)DATA[3]<<24);
+}
+static speed_t loaderSpeed(uint32_t BAUD_RATE)
+{
+        switch(BAUD_RATE)
+        {
+#ifdef B1000000
+                case 1000000: return B1000000;
+#endif
+#ifdef B921600
+                case 921600: return B921600;
+#endif
+#ifdef B500000
+                case 500000: return B500000;
+#endif
+#ifdef B230400
+                case 230400: return B230400;
+#endif
+                default: return B115200;
+        }
+}
+static bool loaderSetBaud(uint32_t BAUD_RATE)
+{
+        struct termios settings;
+
+        if(tcgetattr(loaderPort,&settings)!=0)
+        {
+                return false;
+        }
+        cfmakeraw(&settings);
+        settings.c_cflag |= CLOCAL|CREAD;
+        settings.c_cc[VMIN] = 0;
+        settings.c_cc[VTIME] = 0;
+        cfsetispeed(&settings,loaderSpeed(BAUD_RATE));
+        cfsetospeed(&settings,loaderSpeed(BAUD_RATE));
+        return tcsetattr(loaderPort,TCSADRAIN,&settings)==0;
+}
+static bool loaderRead(uint8_t *DATA, size_t SIZE, int TIMEOUT_MS)
+{
+        struct pollfd portPoll = {loaderPort,POLLIN,0};
+        while(SIZE>0)
+        {
+                ssize_t received = 0;
+                if(poll(&portPoll,1,TIMEOUT_MS)<=0)
+                {
+                        return false;
+                }
+                received = read(loaderPort,DATA,SIZE);
+                if(received<=0)
+                {
+                        return false;
+                }
+                DATA += received;
+                SIZE -= received;
+        }
+        return true;
+}
+static bool loaderSend(uint8_t TYPE, uint32_t OFFSET, const uint8_t *PAYLOAD, uint16_t LENGTH)
+{
+        static uint8_t frame[LOADER_HEADER_SIZE+LOADER_MAX_PAYLOAD+LOADER_CRC_SIZE];
+        size_t frameSize = LOADER_HEADER_SIZE+LENGTH+LOADER_CRC_SIZE;
+        const uint8_t *position = frame;
+
+        frame[0] = LOADER_SOF;
+        frame[1] = TYPE;
+        frame[2] = LENGTH;
+        frame[3] = LENGTH>>8;
+        loaderPut32(&frame[4],OFFSET);
+        memcpy(&frame[LOADER_HEADER_SIZE],PAYLOAD,LENGTH);
+        loaderPut32(&frame[LOADER_HEADER_SIZE+LENGTH],loaderCrc32(0,frame,LOADER_HEADER_SIZE+LENGTH));
+        while(frameSize>0)
+        {
+                ssize_t sent = write(loaderPort,position,frameSize);
+                if(sent<=0)
+                {
+                        return false;
+                }
+                position += sent;
+                frameSize -= sent;
+        }
+        return true;
+}
+//Waits for an ACK or NAK, skipping whatever else the watch prints
+static bool loaderReceive(loaderReply_t *REPLY, int TIMEOUT_MS)
+{
+        uint8_t frame[LOADER_HEADER_SIZE+sizeof(REPLY->payload)+LOADER_CRC_SIZE];
+
+        do
+        {
+                if(!loaderRead(frame,1,TIMEOUT_MS))
+                {
+                        return false;
+                }
+        } while(frame[0]!=LOADER_SOF);
+        if(!loaderRead(&frame[1],LOADER_HEADER_SIZE-1,LOADER_REPLY_TIMEOUT_MS))
+        {
+                return false;
+        }
+        REPLY->type = frame[1];
+        REPLY->length = frame[2]|(frame[3]<<8);
+        REPLY->offset = loaderGet32(&frame[4]);
+        if((REPLY->length>sizeof(REPLY->payload))||
+           !loaderRead(&frame[LOADER_HEADER_SIZE],REPLY->length+LOADER_CRC_SIZE,LOADER_REPLY_TIMEOUT_MS))
+        {
+                return false;
+        }
+        if(loaderCrc32(0,frame,LOADER_HEADER_SIZE+REPLY->length)!=loaderGet32(&frame[LOADER_HEADER_SIZE+REPLY->length]))
+        {
+                return false;
+        }
+        memcpy(REPLY->payload,&frame[LOADER_HEADER_SIZE],REPLY->length);
+        return (REPLY->type==LOADER_FRAME_ACK)||(REPLY->type==LOADER_FRAME_NAK);
+}
+//Introduces the pack at the default rate and moves to the agreed one.
+//Returns where the watch wants the pack to carry on from, or -1
+static long loaderHello(uint32_t PACK_SIZE, uint32_t PACK_CRC, uint32_t BAUD_RATE, uint32_t FLAGS)
+{
+        uint8_t hello[16];
+        loaderReply_t reply;
+
+        loaderPut32(&hello[0],PACK_SIZE);
+        loaderPut32(&hello[4],PACK_CRC);
+        loaderPut32(&hello[8],BAUD_RATE);
+        loaderPut32(&hello[12],FLAGS);
+        for(int attempt=0;attempt<LOADER_RETRIES;attempt++)
+        {
+                loaderSetBaud(LOADER_DEFAULT_BAUD);
+                tcflush(loaderPort,TCIOFLUSH);
+                if(!loaderSend(LOADER_FRAME_HELLO,0,hello,sizeof(hello)))
+                {
+                        return -1;
+                }
+                bool isAnswered = loaderReceive(&reply,LOADER_REPLY_TIMEOUT_MS);
+                if(isAnswered&&(reply.type==LOADER_FRAME_ACK)&&(reply.length>=4))
+                {
+                        uint32_t agreed = loaderGet32(reply.payload);
+                        //Give the watch time to switch before talking at the new rate
+                        usleep(50000);
+                        loaderSetBaud(agreed);
+                        printf("Talking at %u baud\n",agreed);
+                        if((FLAGS&LOADER_HELLO_DELTA)==0)
+                        {
+                                printf("Watch has %u of %u bytes\n",reply.offset,PACK_SIZE);
+                        }
+                        return reply.offset;
+                }
+                if(isAnswered&&(reply.type==LOADER_FRAME_NAK))
+                {
+                        usleep(LOADER_BUSY_WAIT_MS*1000);
+                }
+        }
+        return -1;
+}
+
+//Sends the pack from wherever the watch says it got to. Returns false
+//if the watch stops answering
+static bool loaderSendFull(const uint8_t *PACK, long PACK_SIZE, uint32_t PACK_CRC, uint32_t BAUD_RATE)
+{
+        long offset = loaderHello(PACK_SIZE,PACK_CRC,BAUD_RATE,0);
+        int failures = 0;
+        loaderReply_t reply;
+
+        while((offset>=0)&&(offset<PACK_SIZE))
+        {
+                uint16_t length = ((PACK_SIZE-offset)>LOADER_MAX_PAYLOAD)?LOADER_MAX_PAYLOAD:(PACK_SIZE-offset);
+                if(loaderSend(LOADER_FRAME_DATA,offset,&PACK[offset],length)&&loaderReceive(&reply,LOADER_REPLY_TIMEOUT_MS))
+                {
+                        //Either way the watch says where it is
+                        failures = (reply.type==LOADER_FRAME_ACK)?0:failures+1;
+                        offset = reply.offset;
+                        printf("\r%ld / %ld",offset,PACK_SIZE);
+                        fflush(stdout);
+                }
+                else
+                {
+                        failures++;
+                }
+                //Lost at the fast rate, start over slowly and pick up from there
+                if(failures>=LOADER_RETRIES/2)
+                {
+                        printf("\n");
+                        offset = loaderHello(PACK_SIZE,PACK_CRC,BAUD_RATE,0);
+                        failures = 0;
+                }
+        }
+        printf("\n");
+        return offset>=0;
+}
+//Asks the watch for the CRC of every sector the pack covers and sends
+//just the ones that differ. Anything that goes wrong starts the load
+//again into a fresh bank, and as the CRCs are always of the active
+//bank every changed sector is sent again, not just the ones left over
+static bool loaderSendDelta(const uint8_t *PACK, long PACK_SIZE, uint32_t PACK_CRC, uint32_t BAUD_RATE)
+{
+        long sectorCount = (PACK_SIZE+LOADER_SECTOR_SIZE-1)/LOADER_SECTOR_SIZE;
+        uint8_t end[4];
+        loaderReply_t reply;
+        //The sector CRCs stay in reply while the changed sectors go
+        loaderReply_t dataReply;
+
+        loaderPut32(end,PACK_SIZE);
+        for(int attempt=0;attempt<LOADER_RETRIES;attempt++)
+        {
+                long changed = 0;
+                long sent = 0;
+                bool isLost = loaderHello(PACK_SIZE,PACK_CRC,BAUD_RATE,LOADER_HELLO_DELTA)<0;
+                for(long sector=0;!isLost&&(sector<sectorCount);)
+                {
+                        long hashCount = 0;
+                        if(!loaderSend(LOADER_FRAME_HASHES,sector*LOADER_SECTOR_SIZE,end,sizeof(end))||
+                           !loaderReceive(&reply,LOADER_END_TIMEOUT_MS)||(reply.type!=LOADER_FRAME_ACK)||(reply.length<4))
+                        {
+                                isLost = true;
+                                break;
+                        }
+                        hashCount = reply.length/4;
+                        for(long i=0;!isLost&&(i<hashCount)&&(sector<sectorCount);i++,sector++)
+                        {
+                                long offset = sector*LOADER_SECTOR_SIZE;
+                                uint16_t length = ((PACK_SIZE-offset)>LOADER_SECTOR_SIZE)?LOADER_SECTOR_SIZE:(PACK_SIZE-offset);
+                                if(loaderGet32(&reply.payload[i*4])==loaderCrc32(0,&PACK[offset],length))
+                                {
+                                        continue;
+                                }
+                                changed++;
+                                isLost = !loaderSend(LOADER_FRAME_DATA,offset,&PACK[offset],length)||
+                                         !loaderReceive(&dataReply,LOADER_REPLY_TIMEOUT_MS)||(dataReply.type!=LOADER_FRAME_ACK);
+                                sent += isLost?0:length;
+                        }
+                }
+                if(!isLost)
+                {
+                        printf("%ld of %ld sectors changed, sent %ld bytes\n",changed,sectorCount,sent);
+                        return true;
+                }
+        }
+        return false;
+}
+
+int main(int argc, char *argv[])
+{
+        FILE *packFile = NULL;
+        uint8_t *pack = NULL;
+        long packSize = 0;
+        uint32_t packCrc = 0;
+        uint32_t baudRate = 921600;
+        bool isFull = false;
+        int argument = 3;
+        loaderReply_t reply;
+
+        if(argc<3)
+        {
+                fprintf(stderr,"usage: %s <serial port> <asset pack> [baud] [--full]\n",argv[0]);
+                return 2;
+        }
+        for(;argument<argc;argument++)
+        {
+                if(strcmp(argv[argument],"--full")==0)
+                {
+                        isFull = true;
+                }
+                else
+                {
+                        baudRate = strtoul(argv[argument],NULL,10);
+                }
+        }
+        packFile = fopen(argv[2],"rb");
+        if(packFile==NULL)
+        {
+                perror(argv[2]);
+                return 1;
+        }
+        fseek(packFile,0,SEEK_END);
+        packSize = ftell(packFile);
+        fseek(packFile,0,SEEK_SET);
+        pack = malloc(packSize);
+        if((pack==NULL)||(fread(pack,1,packSize,packFile)!=(size_t)packSize))
+        {
+                fprintf(stderr,"can't read %s\n",argv[2]);
+                return 1;
+        }
+        fclose(packFile);
+        packCrc = loaderCrc32(0,pack,packSize);
+
+        loaderPort = open(argv[1],O_RDWR|O_NOCTTY);
+        if(loaderPort<0)
+        {
+                perror(argv[1]);
+                return 1;
+        }
+        if(!(isFull?loaderSendFull(pack,packSize,packCrc,baudRate):loaderSendDelta(pack,packSize,packCrc,baudRate)))
+        {
+                fprintf(stderr,"watch isn't answering\n");
+                return 1;
+        }
+        for(int attempt=0;attempt<LOADER_RETRIES;attempt++)
+        {
+                uint8_t end[8];
+                loaderPut32(&end[0],packSize);
+                loaderPut32(&end[4],packCrc);
+                if(loaderSend(LOADER_FRAME_END,packSize,end,sizeof(end))&&loaderReceive(&reply,LOADER_END_TIMEOUT_MS))
+                {
+                        if(reply.type==LOADER_FRAME_ACK)
+                        {
+                                printf("Pack loaded and checked\n");
+                                return 0;
+                        }
+                        fprintf(stderr,"watch rejected the pack, run again to resend it\n");
+                        return 1;
+                }
+        }
+        fprintf(stderr,"no answer to the end of the pack\n");
+        return 1;
+}
@@ -24,8 +24,419 @@ namespace bitmapToArray
             public const int bmpImgDataOffset = 0x0A;
             public const int bmpImgWidthOffset = 0x12;
             public const int bmpImgHeightOffset = 0x16;
+            public const UInt32 glyphTableMagic = 0x46594C47;//"GLYF"
+            public const Byte glyphTableVersion = 2;
+            public const Byte glyphFlagPacked = 0x01;
+            public const int glyphTableHeaderSize = 16;
+            public const int glyphRecordSize = 16;
+            public const UInt32 handSpriteMagic = 0x52505348;//"HSPR"
+            public const Byte handSpriteVersion = 1;
+            public const int handSpriteHeaderSize = 16;
+            public const int handSpriteHandSize = 4;
+            public const int handSpriteRecordSize = 12;
+            public const Byte imageFormatRle16 = 1;
+            public const Byte imageFormatIndexed = 2;
+            public const int imageRowsPerBlock = 8;
+            public const int imageRleRun = 0x80;
+            public const int imageRleMaxCount = 128;
+            public const UInt32 assetMagic = 0x54455341;//"ASET"
+            public const Byte assetVersion = 1;
+            public const int assetHeaderSize = 16;
+            public const int assetEntrySize = 24;
+            public const Byte assetFormatGlyphs = 0x10;
+            public const Byte assetFormatHands = 0x11;
         }        
 
+        //Each line of a .glyphs file is either "lineHeight N", "defaultAdvance N", "bitsPerPixel N" or
+        //"<character or U+XXXX> atlasX atlasY width height advance bearingX bearingY".
+        //Every glyph is cut out of the atlas and stored as its own image after the table
+        //so the watch can read it in one go. With bitsPerPixel 1, 2 or 4 the glyphs are
+        //stored as coverage masks taken from the brightness of the atlas, and the watch
+        //colors them when they are drawn
+        private byte[] glyphTableFromFile(string glyphFilePath, int tableOffset, byte[] atlasData, int atlasDataStart, int atlasRowSize)
+        {
+            SortedDictionary<UInt16, Int16[]> glyphs = new SortedDictionary<UInt16, Int16[]>();
+            Byte lineHeight = 25;
+            Byte defaultAdvance = 5;
+            Byte bitsPerPixel = 0;
+            foreach (string line in File.ReadAllLines(glyphFilePath))
+            {
+                string[] fields = line.Split((char[])null, StringSplitOptions.RemoveEmptyEntries);
+                if (fields.Length == 2 && fields[0] == "lineHeight")
+                {
+                    lineHeight = Byte.Parse(fields[1]);
+                }
+                else if (fields.Length == 2 && fields[0] == "defaultAdvance")
+                {
+                    defaultAdvance = Byte.Parse(fields[1]);
+                }
+                else if (fields.Length == 2 && fields[0] == "bitsPerPixel")
+                {
+                    bitsPerPixel = Byte.Parse(fields[1]);
+                }
+                else if (fields.Length == 8)
+                {
+                    UInt16 codepoint = fields[0].StartsWith("U+") ? Convert.ToUInt16(fields[0].Substring(2), 16) : (UInt16)fields[0][0];
+                    glyphs[codepoint] = fields.Skip(1).Select(Int16.Parse).ToArray();
+                }
+            }
+            int glyphDataOffset = tableOffset + bitmapToArray.DEFINES.glyphTableHeaderSize + (glyphs.Count * bitmapToArray.DEFINES.glyphRecordSize);
+            using (var glyphDataStream = new MemoryStream())
+            using (var memoryStream = new MemoryStream())
+            using (var writer = new BinaryWriter(memoryStream))
+            {
+                writer.Write(DEFINES.glyphTableMagic);
+                writer.Write(DEFINES.glyphTableVersion);
+                writer.Write(lineHeight);
+                writer.Write(defaultAdvance);
+                writer.Write(DEFINES.glyphFlagPacked);
+                writer.Write((UInt16)glyphs.Count);
+                writer.Write(bitsPerPixel);
+                writer.Write((Byte)0);
+                writer.Write(glyphDataOffset);
+                foreach (var glyph in glyphs)
+                {
+                    int atlasX = glyph.Value[0];
+                    int atlasY = glyph.Value[1];
+                    int width = glyph.Value[2];
+                    int height = glyph.Value[3];
+                    writer.Write(glyph.Key);
+                    writer.Write((UInt16)atlasX);
+                    writer.Write((UInt16)atlasY);
+                    writer.Write((Byte)width);
+                    writer.Write((Byte)height);
+                    writer.Write((Byte)glyph.Value[4]);
+                    writer.Write((SByte)glyph.Value[5]);
+                    writer.Write((SByte)glyph.Value[6]);
+                    writer.Write((Byte)0);
+                    writer.Write((UInt32)glyphDataStream.Length);
+                    glyphDataStream.WriteByte((Byte)width);
+                    glyphDataStream.WriteByte((Byte)height);
+                    for (int row = 0; row < height; row++)
+                    {
+                        int rowStart = atlasDataStart + ((atlasY + row) * atlasRowSize) + (atlasX * 2);
+                        if (bitsPerPixel == 0)
+                        {
+                            glyphDataStream.Write(atlasData, rowStart, width * 2);
+                            continue;
+                        }
+                        byte[] maskRow = new byte[((width * bitsPerPixel) + 7) / 8];
+                        int maximum = (1 << bitsPerPixel) - 1;
+                        for (int column = 0; column < width; column++)
+                        {
+                            //The atlas has already been swapped to big endian for the display
+                            int pixel = (atlasData[rowStart + (column * 2)] << 8) | atlasData[rowStart + (column * 2) + 1];
+                            int brightness = ((((pixel >> 11) & 0x1F) * 299 * 255 / 31) + (((pixel >> 5) & 0x3F) * 587 * 255 / 63) + ((pixel & 0x1F) * 114 * 255 / 31)) / 1000;
+                            int coverage = ((brightness * maximum) + 127) / 255;
+                            int bit = column * bitsPerPixel;
+                            maskRow[bit / 8] |= (Byte)(coverage << (8 - bitsPerPixel - (bit % 8)));
+                        }
+                        glyphDataStream.Write(maskRow, 0, maskRow.Length);
+                    }
+                }
+                glyphDataStream.WriteTo(memoryStream);
+                return memoryStream.ToArray();
+            }
+        }
+
+        //Each line of a .hands file is either "angles N" or "hand <RGB565 hex color> <length>".
+        //Every hand is rendered at N angles, starting at three o'clock and going clockwise,
+        //with the same tapered outline the watch draws, and stored as runs of opaque pixels
+        //sorted by row. Coordinates are relative to the pivot so a set can be drawn anywhere
+        private byte[] handSpritesFromFile(string handFilePath)
+        {
+            List<int[]> hands = new List<int[]>();
+            int angleCount = 60;
+            foreach (string line in File.ReadAllLines(handFilePath))
+            {
+                string[] fields = line.Split((char[])null, StringSplitOptions.RemoveEmptyEntries);
+                if (fields.Length == 2 && fields[0] == "angles")
+                {
+                    angleCount = Int32.Parse(fields[1]);
+                }
+                else if (fields.Length == 3 && fields[0] == "hand")
+                {
+                    hands.Add(new int[] { Convert.ToInt32(fields[1], 16), Int32.Parse(fields[2]) });
+                }
+            }
+            int spanDataOffset = DEFINES.handSpriteHeaderSize + (hands.Count * DEFINES.handSpriteHandSize) + (hands.Count * angleCount * DEFINES.handSpriteRecordSize);
+            using (var spanStream = new MemoryStream())
+            using (var spanWriter = new BinaryWriter(spanStream))
+            using (var memoryStream = new MemoryStream())
+            using (var writer = new BinaryWriter(memoryStream))
+            {
+                writer.Write(DEFINES.handSpriteMagic);
+                writer.Write(DEFINES.handSpriteVersion);
+                writer.Write((Byte)hands.Count);
+                writer.Write((UInt16)angleCount);
+                writer.Write(new byte[8]);
+                foreach (int[] hand in hands)
+                {
+                    writer.Write((UInt16)hand[0]);
+                    writer.Write((Byte)hand[1]);
+                    writer.Write((Byte)0);
+                }
+                foreach (int[] hand in hands)
+                {
+                    for (int angleIndex = 0; angleIndex < angleCount; angleIndex++)
+                    {
+                        List<int[]> spans = handSpans(hand[1], angleIndex * 2 * Math.PI / angleCount);
+                        writer.Write((UInt32)(spanDataOffset + spanStream.Length));
+                        writer.Write((UInt16)spans.Count);
+                        writer.Write((SByte)(spans.Count > 0 ? spans.Min(span => span[1]) : 0));
+                        writer.Write((SByte)(spans.Count > 0 ? spans.Max(span => span[1] + span[2] - 1) : -1));
+                        writer.Write((SByte)(spans.Count > 0 ? spans.First()[0] : 0));
+                        writer.Write((SByte)(spans.Count > 0 ? spans.Last()[0] : -1));
+                        writer.Write((UInt16)0);
+                        foreach (int[] span in spans)
+                        {
+                            spanWriter.Write((SByte)span[0]);
+                            spanWriter.Write((SByte)span[1]);
+                            spanWriter.Write((Byte)span[2]);
+                            spanWriter.Write((Byte)0);
+                        }
+                    }
+                }
+                spanWriter.Flush();
+                spanStream.WriteTo(memoryStream);
+                return memoryStream.ToArray();
+            }
+        }
+
+        //Rows and runs {y, xStart, length} covered by a hand of the given length, sampled at
+        //pixel centers like displayPolygonRasterize on the watch
+        private List<int[]> handSpans(int length, double angle)
+        {
+            double handCos = Math.Cos(angle);
+            double handSin = Math.Sin(angle);
+            double baseHalfWidth = length / 25.0;
+            double tipHalfWidth = Math.Max(length / 40.0, 0.5);
+            double[,] outline = {
+                { -baseHalfWidth * handSin, baseHalfWidth * handCos },
+                { (length * handCos) - (tipHalfWidth * handSin), (length * handSin) + (tipHalfWidth * handCos) },
+                { (length * handCos) + (tipHalfWidth * handSin), (length * handSin) - (tipHalfWidth * handCos) },
+                { baseHalfWidth * handSin, -baseHalfWidth * handCos } };
+            List<int[]> spans = new List<int[]>();
+            for (int y = -length - 1; y <= length + 1; y++)
+            {
+                List<double> crossings = new List<double>();
+                for (int i = 0; i < 4; i++)
+                {
+                    double topX = outline[i, 0], topY = outline[i, 1];
+                    double bottomX = outline[(i + 1) % 4, 0], bottomY = outline[(i + 1) % 4, 1];
+                    if (topY > bottomY)
+                    {
+                        double swapX = topX, swapY = topY;
+                        topX = bottomX; topY = bottomY;
+                        bottomX = swapX; bottomY = swapY;
+                    }
+                    if (y >= topY && y < bottomY)
+                    {
+                        crossings.Add(topX + ((y - topY) * (bottomX - topX) / (bottomY - topY)));
+                    }
+                }
+                crossings.Sort();
+                for (int i = 0; i + 1 < crossings.Count; i += 2)
+                {
+                    int xStart = (int)Math.Ceiling(crossings[i]);
+                    int xEnd = (int)Math.Ceiling(crossings[i + 1]) - 1;
+                    if (xStart <= xEnd)
+                    {
+                        spans.Add(new int[] { y, xStart, xEnd - xStart + 1 });
+                    }
+                }
+            }
+            return spans;
+        }
+
+        //Run length encodes an image whose rows start every rowSize bytes at dataStart, with the
+        //pixels already in panel byte order. A control byte below 0x80 is followed by control+1
+        //literal pixels, from 0x80 on it is followed by one pixel repeated control-0x7F times.
+        //Every block of imageRowsPerBlock rows is encoded on its own so the watch can start
+        //decoding at any block. Returns null when it wouldn't save a quarter of the raw size
+        private byte[] compressedImageFromBitmap(byte[] bitmapData, int dataStart, int rowSize, int width, int height)
+        {
+            int blockCount = (height + DEFINES.imageRowsPerBlock - 1) / DEFINES.imageRowsPerBlock;
+            using (var dataStream = new MemoryStream())
+            using (var memoryStream = new MemoryStream())
+            using (var writer = new BinaryWriter(memoryStream))
+            {
+                UInt32[] blockOffsets = new UInt32[blockCount];
+                for (int block = 0; block < blockCount; block++)
+                {
+                    List<UInt16> pixels = new List<UInt16>();
+                    for (int row = block * DEFINES.imageRowsPerBlock; row < Math.Min(height, (block + 1) * DEFINES.imageRowsPerBlock); row++)
+                    {
+                        for (int column = 0; column < width; column++)
+                        {
+                            int pixelStart = dataStart + (row * rowSize) + (column * 2);
+                            pixels.Add((UInt16)((bitmapData[pixelStart] << 8) | bitmapData[pixelStart + 1]));
+                        }
+                    }
+                    blockOffsets[block] = (UInt32)dataStream.Length;
+                    List<UInt16> literals = new List<UInt16>();
+                    int pixelNumber = 0;
+                    while (pixelNumber <= pixels.Count)
+                    {
+                        int runLength = 1;
+                        while (pixelNumber + runLength < pixels.Count && runLength < DEFINES.imageRleMaxCount && pixels[pixelNumber + runLength] == pixels[pixelNumber])
+                        {
+                            runLength++;
+                        }
+                        if (literals.Count > 0 && (pixelNumber == pixels.Count || runLength > 1 || literals.Count == DEFINES.imageRleMaxCount))
+                        {
+                            dataStream.WriteByte((Byte)(literals.Count - 1));
+                            foreach (UInt16 literal in literals)
+                            {
+                                dataStream.WriteByte((Byte)(literal >> 8));
+                                dataStream.WriteByte((Byte)(literal & 0xFF));
+                            }
+                            literals.Clear();
+                        }
+                        if (pixelNumber == pixels.Count)
+                        {
+                            break;
+                        }
+                        if (runLength > 1)
+                        {
+                            dataStream.WriteByte((Byte)(DEFINES.imageRleRun + runLength - 1));
+                            dataStream.WriteByte((Byte)(pixels[pixelNumber] >> 8));
+                            dataStream.WriteByte((Byte)(pixels[pixelNumber] & 0xFF));
+                            pixelNumber += runLength;
+                        }
+                        else
+                        {
+                            literals.Add(pixels[pixelNumber]);
+                            pixelNumber++;
+                        }
+                    }
+                }
+                writer.Write((Byte)0);
+                writer.Write(DEFINES.imageFormatRle16);
+                writer.Write((Byte)width);
+                writer.Write((Byte)height);
+                writer.Write((UInt16)DEFINES.imageRowsPerBlock);
+                writer.Write((UInt16)blockCount);
+                writer.Write((UInt32)dataStream.Length);
+                writer.Write((Byte)16);
+                writer.Write((Byte)0);
+                writer.Write((UInt16)0);
+                foreach (UInt32 blockOffset in blockOffsets)
+                {
+                    writer.Write(blockOffset);
+                }
+                dataStream.WriteTo(memoryStream);
+                if (memoryStream.Length * 4 > (width * height * 2) * 3)
+                {
+                    return null;
+                }
+                return memoryStream.ToArray();
+            }
+        }
+
+        //Stores an image with up to 256 colors as a palette and 2, 4 or 8 bits per pixel, most
+        //significant first with every row starting on a new byte. Returns null if it has more colors
+        private byte[] indexedImageFromBitmap(byte[] bitmapData, int dataStart, int rowSize, int width, int height)
+        {
+            List<UInt16> palette = new List<UInt16>();
+            Dictionary<UInt16, int> paletteIndex = new Dictionary<UInt16, int>();
+            int[] indices = new int[width * height];
+            for (int row = 0; row < height; row++)
+            {
+                for (int column = 0; column < width; column++)
+                {
+                    int pixelStart = dataStart + (row * rowSize) + (column * 2);
+                    UInt16 color = (UInt16)((bitmapData[pixelStart] << 8) | bitmapData[pixelStart + 1]);
+                    if (!paletteIndex.ContainsKey(color))
+                    {
+                        if (palette.Count == 256)
+                        {
+                            return null;
+                        }
+                        paletteIndex[color] = palette.Count;
+                        palette.Add(color);
+                    }
+                    indices[(row * width) + column] = paletteIndex[color];
+                }
+            }
+            int bitsPerPixel = palette.Count <= 4 ? 2 : (palette.Count <= 16 ? 4 : 8);
+            int indexRowSize = ((width * bitsPerPixel) + 7) / 8;
+            byte[] indexData = new byte[indexRowSize * height];
+            for (int row = 0; row < height; row++)
+            {
+                for (int column = 0; column < width; column++)
+                {
+                    int bit = column * bitsPerPixel;
+                    indexData[(row * indexRowSize) + (bit >> 3)] |= (Byte)(indices[(row * width) + column] << (8 - bitsPerPixel - (bit & 7)));
+                }
+            }
+            using (var memoryStream = new MemoryStream())
+            using (var writer = new BinaryWriter(memoryStream))
+            {
+                writer.Write((Byte)0);
+                writer.Write(DEFINES.imageFormatIndexed);
+                writer.Write((Byte)width);
+                writer.Write((Byte)height);
+                writer.Write((UInt16)0);
+                writer.Write((UInt16)0);
+                writer.Write((UInt32)indexData.Length);
+                writer.Write((Byte)bitsPerPixel);
+                writer.Write((Byte)0);
+                writer.Write((UInt16)palette.Count);
+                foreach (UInt16 color in palette)
+                {
+                    writer.Write(color);
+                }
+                writer.Write(indexData);
+                return memoryStream.ToArray();
+            }
+        }
+
+        //FNV-1a of an asset name, the watch looks assets up by this
+        private UInt32 assetHash(string name)
+        {
+            UInt32 hash = 2166136261;
+            foreach (Byte character in Encoding.ASCII.GetBytes(name))
+            {
+                hash = unchecked((hash ^ character) * 16777619);
+            }
+            return hash;
+        }
+
+        //Reflected CRC32, the same as displayAssetCrc32 on the watch
+        private UInt32 assetCrc32(byte[] data)
+        {
+            UInt32 crc = 0xFFFFFFFF;
+            foreach (Byte dataByte in data)
+            {
+                crc ^= dataByte;
+                for (int bit = 0; bit < 8; bit++)
+                {
+                    crc = (crc >> 1) ^ (0xEDB88320 & (UInt32)(-(int)(crc & 1)));
+                }
+            }
+            return ~crc;
+        }
+
+        //One directory entry {id, offset, length, format, reserved, width, height, stride, checksum}
+        private byte[] assetEntry(string name, int offset, byte[] data, Byte format, int width, int height, int stride)
+        {
+            using (var memoryStream = new System.IO.MemoryStream())
+            using (var writer = new BinaryWriter(memoryStream))
+            {
+                writer.Write(assetHash(name));
+                writer.Write((UInt32)offset);
+                writer.Write((UInt32)data.Length);
+                writer.Write(format);
+                writer.Write((Byte)0);
+                writer.Write((UInt16)width);
+                writer.Write((UInt16)height);
+                writer.Write((UInt16)stride);
+                writer.Write(assetCrc32(data));
+                return memoryStream.ToArray();
+            }
+        }
+
         private void previewPicture_Click(object sender, EventArgs e)
         {
             using (var fbd = new FolderBrowserDialog())
@@ -39,13 +450,22 @@ namespace bitmapToArray
                     string pictureFilesPath = fbd.SelectedPath + "\\pictureFiles.txt";
                     string pictureFilesHeaderPath = fbd.SelectedPath + "\\pictureFilesHeader.h";
 
-                    int totalMemorySizeInBytes = 256*65536;//256 sectors of 64KB
+                    int totalMemorySizeInBytes = 127*65536;//One of the two asset banks, 127 blocks of 64KB
                     int currentOffset = 0;
+                    Dictionary<string, int> imageOffsets = new Dictionary<string, int>();
+                    Dictionary<string, byte[]> imageData = new Dictionary<string, byte[]>();
+                    List<byte[]> assetEntries = new List<byte[]>();
                     Byte tempDataPoint = 0;
+                    //The pack starts with a directory of everything in it, so the watch finds
+                    //assets by name and the firmware doesn't change when they do
+                    int assetCount = namesOfFiles.Count(name => Path.GetExtension(name) == ".bmp" || Path.GetExtension(name) == ".hands" ||
+                        (Path.GetExtension(name) == ".glyphs" && namesOfFiles.Contains(Path.ChangeExtension(name, ".bmp"))));
+                    currentOffset = bitmapToArray.DEFINES.assetHeaderSize + (assetCount * bitmapToArray.DEFINES.assetEntrySize);
                     using (FileStream fsHeader = File.Create(pictureFilesHeaderPath))
                     {
                         using (FileStream fs = File.Create(pictureFilesPath))
                         {
+                            fs.Write(new byte[currentOffset], 0, currentOffset);
                             while (numberOfFilesToConvert >= 0)
                             {
                                 string fileExtension = Path.GetExtension(namesOfFiles[numberOfFilesToConvert]);
@@ -72,24 +492,95 @@ namespace bitmapToArray
                                         dataFromBitmap[elementNumber] = dataFromBitmap[elementNumber + 1];
                                         dataFromBitmap[elementNumber + 1] = tempDataPoint;
                                     }
-                                    fs.Write(dataFromBitmap, bitmapToArray.DEFINES.bmpImgWidthOffset, 1);
-                                    fs.Write(dataFromBitmap, bitmapToArray.DEFINES.bmpImgHeightOffset, 1);
-                                    fs.Write(dataFromBitmap, dataStart, dataFromBitmap.Length - dataStart);
-                                    byte[] headerLineToAppend = Encoding.ASCII.GetBytes("#define " + nameOfFileForHeader +"_OFFSET "+ currentOffset+"\n");
-                                    currentOffset += (dataFromBitmap.Length - dataStart) + 2;
+                                    int imageWidth = BitConverter.ToInt32(dataFromBitmap, bitmapToArray.DEFINES.bmpImgWidthOffset);
+                                    int imageHeight = Math.Abs(BitConverter.ToInt32(dataFromBitmap, bitmapToArray.DEFINES.bmpImgHeightOffset));
+                                    //Images used as glyph atlases stay raw for the glyph table builder and the built in font,
+                                    //as do images too big for the size in a compressed header
+                                    byte[] compressedImage = null;
+                                    if (!namesOfFiles.Contains(Path.ChangeExtension(namesOfFiles[numberOfFilesToConvert], ".glyphs")) && nameOfFileForHeader != "FONT" &&
+                                        imageWidth <= 255 && imageHeight <= 255)
+                                    {
+                                        //Whichever of run length or palette comes out smaller
+                                        byte[] runLengthImage = compressedImageFromBitmap(dataFromBitmap, dataStart, ((imageWidth * 2) + 3) & ~3, imageWidth, imageHeight);
+                                        byte[] indexedImage = indexedImageFromBitmap(dataFromBitmap, dataStart, ((imageWidth * 2) + 3) & ~3, imageWidth, imageHeight);
+                                        compressedImage = runLengthImage;
+                                        if (indexedImage != null && indexedImage.Length * 4 <= (imageWidth * imageHeight * 2) * 3 &&
+                                            (compressedImage == null || indexedImage.Length < compressedImage.Length))
+                                        {
+                                            compressedImage = indexedImage;
+                                        }
+                                    }
+                                    byte[] headerLineToAppend = Encoding.ASCII.GetBytes("#define " + nameOfFileForHeader + "_ASSET 0x" + assetHash(nameOfFileForHeader).ToString("X8") + "\n");
+                                    imageOffsets[nameOfFileForHeader] = currentOffset;
+                                    imageData[nameOfFileForHeader] = dataFromBitmap;
+                                    if (compressedImage != null)
+                                    {
+                                        fs.Write(compressedImage, 0, compressedImage.Length);
+                                        assetEntries.Add(assetEntry(nameOfFileForHeader, currentOffset, compressedImage, compressedImage[1], imageWidth, imageHeight, imageWidth));
+                                        currentOffset += compressedImage.Length;
+                                    }
+                                    else
+                                    {
+                                        //The directory has the real size, a raw header saturates rather than
+                                        //reading as the 0 that marks a compressed image
+                                        byte[] rawImage = new byte[(dataFromBitmap.Length - dataStart) + 2];
+                                        rawImage[0] = (Byte)Math.Min(imageWidth, 255);
+                                        rawImage[1] = (Byte)Math.Min(imageHeight, 255);
+                                        Array.Copy(dataFromBitmap, dataStart, rawImage, 2, dataFromBitmap.Length - dataStart);
+                                        fs.Write(rawImage, 0, rawImage.Length);
+                                        assetEntries.Add(assetEntry(nameOfFileForHeader, currentOffset, rawImage, 0, imageWidth, imageHeight, (((imageWidth * 2) + 3) & ~3) / 2));
+                                        currentOffset += rawImage.Length;
+                                    }
                                     fsHeader.Write(headerLineToAppend, 0, headerLineToAppend.Length);
                                     previewPicture.BackgroundImage.RotateFlip(RotateFlipType.RotateNoneFlipY);
                                     previewPicture.Refresh();
                                 }
                                 numberOfFilesToConvert--;
                             }
+                            //Glyph tables go after the images so the atlas pixels are at hand
+                            foreach (string glyphFilePath in namesOfFiles.Where(name => Path.GetExtension(name) == ".glyphs"))
+                            {
+                                string nameOfFileForHeader = Path.GetFileNameWithoutExtension(glyphFilePath);
+                                if (imageOffsets.ContainsKey(nameOfFileForHeader))
+                                {
+                                    byte[] atlasData = imageData[nameOfFileForHeader];
+                                    int atlasWidth = BitConverter.ToInt32(atlasData, bitmapToArray.DEFINES.bmpImgWidthOffset);
+                                    byte[] glyphTable = glyphTableFromFile(glyphFilePath, currentOffset, atlasData, atlasData[bitmapToArray.DEFINES.bmpImgDataOffset], ((atlasWidth * 2) + 3) & ~3);
+                                    fs.Write(glyphTable, 0, glyphTable.Length);
+                                    assetEntries.Add(assetEntry(nameOfFileForHeader + "_GLYPHS", currentOffset, glyphTable, bitmapToArray.DEFINES.assetFormatGlyphs, 0, 0, 0));
+                                    byte[] headerLineToAppend = Encoding.ASCII.GetBytes("#define " + nameOfFileForHeader + "_GLYPHS_ASSET 0x" + assetHash(nameOfFileForHeader + "_GLYPHS").ToString("X8") + "\n");
+                                    currentOffset += glyphTable.Length;
+                                    fsHeader.Write(headerLineToAppend, 0, headerLineToAppend.Length);
+                                }
+                            }
+                            foreach (string handFilePath in namesOfFiles.Where(name => Path.GetExtension(name) == ".hands"))
+                            {
+                                string nameOfFileForHeader = Path.GetFileNameWithoutExtension(handFilePath);
+                                byte[] handSprites = handSpritesFromFile(handFilePath);
+                                fs.Write(handSprites, 0, handSprites.Length);
+                                assetEntries.Add(assetEntry(nameOfFileForHeader + "_HANDS", currentOffset, handSprites, bitmapToArray.DEFINES.assetFormatHands, 0, 0, 0));
+                                byte[] headerLineToAppend = Encoding.ASCII.GetBytes("#define " + nameOfFileForHeader + "_HANDS_ASSET 0x" + assetHash(nameOfFileForHeader + "_HANDS").ToString("X8") + "\n");
+                                currentOffset += handSprites.Length;
+                                fsHeader.Write(headerLineToAppend, 0, headerLineToAppend.Length);
+                            }
+                            //Now everything is placed the directory goes in front of it
+                            byte[] directory = assetEntries.SelectMany(entry => entry).ToArray();
+                            fs.Seek(0, SeekOrigin.Begin);
+                            fs.Write(BitConverter.GetBytes(bitmapToArray.DEFINES.assetMagic), 0, 4);
+                            fs.WriteByte(bitmapToArray.DEFINES.assetVersion);
+                            fs.WriteByte(0);
+                            fs.Write(BitConverter.GetBytes((UInt16)assetEntries.Count), 0, 2);
+                            fs.Write(BitConverter.GetBytes((UInt32)currentOffset), 0, 4);
+                            fs.Write(BitConverter.GetBytes(assetCrc32(directory)), 0, 4);
+                            fs.Write(directory, 0, directory.Length);
+                            fs.Seek(0, SeekOrigin.End);
                             byte[] byteArrayOfTotalMemoryUsed = Encoding.ASCII.GetBytes("\n#define TOTAL_MEMORY_USED " + currentOffset + "\n");
                             fsHeader.Write(byteArrayOfTotalMemoryUsed, 0, byteArrayOfTotalMemoryUsed.Length);
                             byte[] byteArrayOfTotalMemoryAvailable = Encoding.ASCII.GetBytes("#define TOTAL_MEMORY_AVAILABLE " + (totalMemorySizeInBytes - currentOffset) + "\n");
                             fsHeader.Write(byteArrayOfTotalMemoryAvailable, 0, byteArrayOfTotalMemoryAvailable.Length);
                             byte[] byteArrayOfTotalMemoryUsedPercent = Encoding.ASCII.GetBytes("#define TOTAL_MEMORY_PERCENT USED " + (100*currentOffset / totalMemorySizeInBytes) + "\n");
                             fsHeader.Write(byteArrayOfTotalMemoryUsedPercent, 0, byteArrayOfTotalMemoryUsedPercent.Length);
-                            byte[] byteArrayOfTimeToLoadData = Encoding.ASCII.GetBytes("//Time to load all data at 57600 baud: " + (8 * currentOffset / 57600) + " seconds");
+                            byte[] byteArrayOfTimeToLoadData = Encoding.ASCII.GetBytes("//Time to load all data with assetLoader at 921600 baud: " + (10 * currentOffset / 921600) + " seconds");
                             fsHeader.Write(byteArrayOfTimeToLoadData, 0, byteArrayOfTimeToLoadData.Length);
                         }
                     }
@@ -0,0 +1,142 @@
+/*
+ * bankTest.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * The A/B asset banks: a thousand commits around the record sectors, a
+ * record torn part way and one that programmed wrong, and loading the
+ * directory from whichever bank is active.
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "sdkHost.h"
+#include "hostMocks.h"
+#include "hostPack.h"
+#include "displayAssets.h"
+#include "imageOffsets.h"
+
+#define BANK_TEST_COMMITS 1000
+#define BANK_TEST_SLOTS ((DISPLAY_ASSET_RECORD_SECTORS*DISPLAY_ASSET_RECORD_SECTOR_SIZE)/DISPLAY_ASSET_RECORD_SLOT_SIZE)
+
+static int bankTestFailures = 0;
+
+static void bankTestCheck(bool IS_OK, const char *WHAT)
+{
+        if(!IS_OK)
+        {
+                printf("FAIL %s\n",WHAT);
+                bankTestFailures++;
+        }
+}
+//The slot after the newest good record, where the next one goes
+static int bankTestNextSlot(void)
+{
+        const uint8_t *records = &hostFlashMemory()[DISPLAY_ASSET_RECORD_ADDRESS];
+        uint32_t newestSequence = 0;
+        int newestSlot = -1;
+        for(int slot=0;slot<BANK_TEST_SLOTS;slot++)
+        {
+                displayAssetRecord_t record;
+                memcpy(&record,&records[slot*DISPLAY_ASSET_RECORD_SLOT_SIZE],sizeof(record));
+                if((record.magic==DISPLAY_ASSET_RECORD_MAGIC)&&
+                   (record.checksum==displayAssetCrc32(0,(const uint8_t *)&record,offsetof(displayAssetRecord_t,checksum)))&&
+                   ((newestSlot<0)||((int32_t)(record.sequence-newestSequence)>0)))
+                {
+                        newestSequence = record.sequence;
+                        newestSlot = slot;
+                }
+        }
+        return (newestSlot+1)%BANK_TEST_SLOTS;
+}
+
+static void bankTestCommits(void)
+{
+        hostFlashStats_t stats;
+        int wrongBank = 0;
+
+        hostFlashFill(0xFF);
+        bankTestCheck(displayAssetActiveBank()==DISPLAY_ASSET_NO_BANK,"blank flash has an active bank");
+        bankTestCheck(!displayAssetsLoad(),"blank flash loads");
+        hostFlashResetStats();
+        for(int commit=0;commit<BANK_TEST_COMMITS;commit++)
+        {
+                int bank = (commit*7/3)%DISPLAY_ASSET_BANKS;
+                if(!displayAssetsCommit(bank,commit,commit*0x9E3779B9)||(displayAssetActiveBank()!=bank))
+                {
+                        wrongBank++;
+                }
+        }
+        hostFlashGetStats(&stats);
+        printf("commits:      %d, %u record sector erases, %u writes across a page\n",BANK_TEST_COMMITS,stats.erases,stats.pageCrossings);
+        bankTestCheck(wrongBank==0,"a commit didn't make its bank active");
+        bankTestCheck(stats.pageCrossings==0,"a record write crossed a page");
+        bankTestCheck(stats.unalignedErases==0,"a record erase wasn't on a sector");
+        //Each sector is erased as the records move into it, the first one too
+        bankTestCheck(stats.erases==(BANK_TEST_COMMITS+(BANK_TEST_SLOTS/DISPLAY_ASSET_RECORD_SECTORS)-1)/(BANK_TEST_SLOTS/DISPLAY_ASSET_RECORD_SECTORS),
+                      "record sectors weren't erased once per fill");
+        bankTestCheck(!displayAssetsCommit(2,0,0),"a third bank was committed");
+        bankTestCheck(!displayAssetsCommit(0,DISPLAY_ASSET_BANK_SIZE+1,0),"a pack bigger than a bank was committed");
+}
+//A reset part way through a record write, and a write that didn't
+//program right, leave the bank before active and are stepped over
+static void bankTestTorn(void)
+{
+        int bank = displayAssetActiveBank();
+        int slot = bankTestNextSlot();
+        uint8_t *slotBytes = &hostFlashMemory()[DISPLAY_ASSET_RECORD_ADDRESS+(slot*DISPLAY_ASSET_RECORD_SLOT_SIZE)];
+        displayAssetRecord_t record;
+
+        memcpy(&record,&hostFlashMemory()[DISPLAY_ASSET_RECORD_ADDRESS+(((slot+BANK_TEST_SLOTS-1)%BANK_TEST_SLOTS)*DISPLAY_ASSET_RECORD_SLOT_SIZE)],sizeof(record));
+        record.sequence++;
+        record.bank = 1-bank;
+        record.checksum = displayAssetCrc32(0,(const uint8_t *)&record,offsetof(displayAssetRecord_t,checksum));
+        //Everything but the checksum made it
+        memcpy(slotBytes,&record,offsetof(displayAssetRecord_t,checksum));
+        bankTestCheck(displayAssetActiveBank()==bank,"a torn record switched banks");
+        bankTestCheck(displayAssetsCommit(1-bank,1234,0),"no commit after a torn record");
+        bankTestCheck(displayAssetActiveBank()==1-bank,"the commit after a torn record didn't switch banks");
+        bankTestCheck(bankTestNextSlot()==(slot+2)%BANK_TEST_SLOTS,"the torn slot wasn't stepped over");
+
+        hostFlashFailWrite(1);
+        bankTestCheck(!displayAssetsCommit(bank,1234,0),"a record that programmed wrong was reported as committed");
+        hostFlashFailWrite(0);
+        bankTestCheck(displayAssetActiveBank()==1-bank,"a record that programmed wrong switched banks");
+        bankTestCheck(displayAssetsCommit(bank,1234,0)&&(displayAssetActiveBank()==bank),"no commit after a bad record");
+        printf("torn record:  ignored and stepped over, a bad write isn't committed\n");
+}
+//Packs in either bank load from that bank, a record for a bank that
+//doesn't hold that pack loads nothing
+static void bankTestLoad(void)
+{
+        hostFlashFill(0xFF);
+        for(int bank=0;bank<DISPLAY_ASSET_BANKS;bank++)
+        {
+                const displayAsset_t *face;
+                bankTestCheck(hostPackInstallFace(bank,bank),"a face pack didn't install");
+                face = displayAssetFind(WATCH_FACE_ASSET);
+                bankTestCheck(displayAssetsLoaded()&&(displayAssetBase()==displayAssetBankAddress(bank)),"the pack didn't load from its bank");
+                bankTestCheck((face!=NULL)&&(displayAssetFlashAddress(face)==displayAssetBankAddress(bank)+(int)face->offset),
+                              "the face isn't read from its bank");
+                bankTestCheck(displayAssetVerify(WATCH_FACE_ASSET),"the face doesn't verify");
+        }
+        //Bank 0 still holds the first pack, but not one this size
+        bankTestCheck(displayAssetsCommit(0,12345,0),"no commit");
+        bankTestCheck(!displayAssetsLoad()&&!displayAssetsLoaded(),"a pack of the wrong size loaded");
+        printf("loads:        a pack in each bank loads from it\n");
+}
+
+int main(int ARGC, char *ARGV[])
+{
+        bankTestCommits();
+        bankTestTorn();
+        bankTestLoad();
+        if(bankTestFailures>0)
+        {
+                printf("%d checks failed\n",bankTestFailures);
+                return 1;
+        }
+        return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * busBench.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * SPI traffic of each drawing call, counted by the ad_spi mock. Only
+ * calls every version of the driver has are used, so the same program
+ * builds against an older commit with make before.
+ */
+
+#include <stdio.h>
+#include "sdkHost.h"
+#include "hostMocks.h"
+#include "displayDriver.h"
+#include "watchAnimations.h"
+
+typedef struct
+{
+        const char *name;
+        void (*draw)(void);
+} busBenchShape_t;
+
+static int busBenchFailures = 0;
+
+static void busBenchExpect(const char *NAME, int X, int Y, uint16_t COLOR)
+{
+        if(hostPanelPixel(X,Y)!=COLOR)
+        {
+                printf("FAIL %s: pixel %d,%d is %04X, not %04X\n",NAME,X,Y,hostPanelPixel(X,Y),COLOR);
+                busBenchFailures++;
+        }
+}
+
+static void busBenchPixel(void)
+{
+        displayDrawPixel(10,20,DISPLAY_RED);
+}
+static void busBenchWindow(void)
+{
+        //The same window twice, the second one is free if it is cached
+        displaySetWindow(0,ST7789_WIDTH-1,0,ST7789_HEIGHT-1);
+        displaySetWindow(0,ST7789_WIDTH-1,0,ST7789_HEIGHT-1);
+}
+static void busBenchHorizontalLine(void)
+{
+        displayDrawLine(20,219,30,30,DISPLAY_GREEN);
+}
+static void busBenchDiagonalLine(void)
+{
+        displayDrawLine(20,219,40,139,DISPLAY_BLUE);
+}
+static void busBenchThickLine(void)
+{
+        displayDrawLineThickness(30,200,200,60,DISPLAY_YELLOW,5);
+}
+static void busBenchRectangle(void)
+{
+        displayDrawRectangle(60,179,150,189,DISPLAY_CYAN);
+}
+static void busBenchCircle(void)
+{
+        displayDrawCircle(120,120,50,DISPLAY_MAGENTA);
+}
+static void busBenchWatchHand(void)
+{
+        displayDrawWatchHand(90,45,DISPLAY_WHITE);
+}
+static void busBenchSecondHand(void)
+{
+        displayDrawSecondWatchHand(100,200,DISPLAY_RED,WATCH_CENTER,WATCH_CENTER);
+}
+static void busBenchFillScreen(void)
+{
+        displayFillScreen(DISPLAY_BLACK);
+}
+
+static const busBenchShape_t busBenchShapes[] =
+{
+        {"fill screen",busBenchFillScreen},
+        {"pixel",busBenchPixel},
+        {"window x2",busBenchWindow},
+        {"horizontal line",busBenchHorizontalLine},
+        {"diagonal line",busBenchDiagonalLine},
+        {"thick line",busBenchThickLine},
+        {"rectangle",busBenchRectangle},
+        {"circle",busBenchCircle},
+        {"watch hand",busBenchWatchHand},
+        {"second hand",busBenchSecondHand},
+};
+
+int main(int ARGC, char *ARGV[])
+{
+        hostSpiStats_t total = {0};
+
+        hostPanelClear(DISPLAY_BLACK);
+        displayInit();
+        printf("%-16s %6s %7s %8s %8s %8s %8s\n","shape","opens","writes","bytes","commands","switches","pixels");
+        for(unsigned int shape=0;shape<sizeof(busBenchShapes)/sizeof(busBenchShapes[0]);shape++)
+        {
+                hostSpiStats_t stats;
+                hostSpiResetStats();
+                busBenchShapes[shape].draw();
+                hostSpiGetStats(&stats);
+                printf("%-16s %6u %7u %8u %8u %8u %8u\n",busBenchShapes[shape].name,stats.opens,stats.writes+stats.asyncWrites,
+                       stats.bytes,stats.commandBytes,stats.modeSwitches,stats.pixelsWritten);
+                if(stats.opens!=stats.closes)
+                {
+                        printf("FAIL %s: %u opens but %u closes\n",busBenchShapes[shape].name,stats.opens,stats.closes);
+                        busBenchFailures++;
+                }
+                total.opens += stats.opens;
+                total.writes += stats.writes+stats.asyncWrites;
+                total.bytes += stats.bytes;
+                total.commandBytes += stats.commandBytes;
+                total.modeSwitches += stats.modeSwitches;
+                total.pixelsWritten += stats.pixelsWritten;
+        }
+        printf("%-16s %6u %7u %8u %8u %8u %8u\n","total",total.opens,total.writes,total.bytes,total.commandBytes,total.modeSwitches,total.pixelsWritten);
+
+        //Points every version draws the same, on each shape
+        busBenchExpect("pixel",10,20,DISPLAY_RED);
+        busBenchExpect("horizontal line",20,30,DISPLAY_GREEN);
+        busBenchExpect("horizontal line",120,30,DISPLAY_GREEN);
+        busBenchExpect("horizontal line",219,30,DISPLAY_GREEN);
+        busBenchExpect("rectangle",61,151,DISPLAY_CYAN);
+        busBenchExpect("rectangle",178,188,DISPLAY_CYAN);
+        busBenchExpect("fill screen",0,239,DISPLAY_BLACK);
+        busBenchExpect("fill screen",239,0,DISPLAY_BLACK);
+        busBenchExpect("circle",169,120,DISPLAY_MAGENTA);
+        busBenchExpect("circle",71,120,DISPLAY_MAGENTA);
+        hostPanelSavePpm("busBench.ppm");
+        if(busBenchFailures>0)
+        {
+                printf("%d checks failed\n",busBenchFailures);
+                return 1;
+        }
+        printf("screen in busBench.ppm\n");
+        return 0;
+}
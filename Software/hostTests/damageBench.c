@@ -0,0 +1,148 @@
+/*
+ * damageBench.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * The clock over a face image: what a full redraw costs against a
+ * minute of incremental ticks, and whether every incremental frame is
+ * the same, pixel for pixel, as drawing that time from scratch. Also
+ * restores of separate damaged rects and of damage the driver tracked.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "sdkHost.h"
+#include "hostMocks.h"
+#include "hostPack.h"
+#include "displayDriver.h"
+#include "displayDamage.h"
+#include "displayBezel.h"
+#include "watchAnimations.h"
+#include "imageOffsets.h"
+
+#define DAMAGE_BENCH_HOURS 10
+#define DAMAGE_BENCH_MINUTES 9
+#define DAMAGE_BENCH_TICKS 61
+
+static uint16_t damageBenchFrames[DAMAGE_BENCH_TICKS][HOST_SCREEN_WIDTH*HOST_SCREEN_HEIGHT];
+static int damageBenchFailures = 0;
+
+static void damageBenchCheck(bool IS_OK, const char *WHAT)
+{
+        if(!IS_OK)
+        {
+                printf("FAIL %s\n",WHAT);
+                damageBenchFailures++;
+        }
+}
+static int damageBenchMinutes(int TICK)
+{
+        return DAMAGE_BENCH_MINUTES+(TICK/60);
+}
+//Draws the time from scratch, leaving the panel as the reference
+static uint32_t damageBenchFullDraw(int TICK)
+{
+        hostSpiStats_t stats;
+        hostSpiResetStats();
+        displayWatchBegin(WATCH_FACE_ASSET,DISPLAY_BLUE,DISPLAY_GREEN,DISPLAY_RED);
+        displayWatchUpdate(DAMAGE_BENCH_HOURS,damageBenchMinutes(TICK),TICK%60);
+        hostSpiGetStats(&stats);
+        return stats.bytes;
+}
+
+int main(int ARGC, char *ARGV[])
+{
+        hostSpiStats_t stats;
+        displayDamageStats_t damageStats;
+        displayWindowStats_t windowStats;
+        uint32_t fullBytes = 0;
+        uint32_t tickBytes = 0;
+        uint32_t maxTickBytes = 0;
+        int differences = 0;
+        int bytes = 0;
+
+        hostFlashFill(0xFF);
+        if(!hostPackInstallFace(0,0))
+        {
+                printf("FAIL can't install the face\n");
+                return 1;
+        }
+        displayInit();
+
+        fullBytes = damageBenchFullDraw(0);
+        hostPanelCopy(damageBenchFrames[0]);
+        printf("full redraw:        %6u bytes\n",fullBytes);
+
+        //A minute of ticks, the last one moves the minute hand too
+        for(int tick=1;tick<DAMAGE_BENCH_TICKS;tick++)
+        {
+                hostSpiResetStats();
+                displayWatchUpdate(DAMAGE_BENCH_HOURS,damageBenchMinutes(tick),tick%60);
+                hostSpiGetStats(&stats);
+                hostPanelCopy(damageBenchFrames[tick]);
+                tickBytes += stats.bytes;
+                if(stats.bytes>maxTickBytes)
+                {
+                        maxTickBytes = stats.bytes;
+                }
+        }
+        printf("incremental tick:   %6u bytes on average, %u at most\n",tickBytes/(DAMAGE_BENCH_TICKS-1),maxTickBytes);
+        printf("minute of ticks:    %6u bytes, %u with full redraws\n",tickBytes,fullBytes*(DAMAGE_BENCH_TICKS-1));
+        hostScreenSavePpm("damageTick.ppm",damageBenchFrames[DAMAGE_BENCH_TICKS-1]);
+
+        for(int tick=1;tick<DAMAGE_BENCH_TICKS;tick++)
+        {
+                damageBenchFullDraw(tick);
+                differences = hostPanelCompare(damageBenchFrames[tick]);
+                if(differences>0)
+                {
+                        printf("FAIL tick %d: %d pixels differ from a full draw\n",tick,differences);
+                        damageBenchFailures++;
+                }
+        }
+
+        //Two rects far apart go out on their own
+        displayDrawRectangle(10,30,10,30,DISPLAY_YELLOW);
+        displayDrawRectangle(200,220,200,220,DISPLAY_YELLOW);
+        displayDamageResetStats();
+        displayDamageAdd(10,30,10,30);
+        displayDamageAdd(200,220,200,220);
+        bytes = displayWatchUpdate(DAMAGE_BENCH_HOURS,damageBenchMinutes(DAMAGE_BENCH_TICKS-1),(DAMAGE_BENCH_TICKS-1)%60);
+        displayDamageGetStats(&damageStats);
+        printf("two separate rects: %6d bytes in %u rects\n",bytes,damageStats.rectsFlushed);
+        damageBenchCheck(damageStats.rectsFlushed==2,"two rects far apart were merged");
+        damageBenchCheck(bytes==2*21*21*BYTES_PER_PIXEL,"two 21x21 rects didn't cost 1764 bytes");
+        damageBenchCheck(hostPanelCompare(damageBenchFrames[DAMAGE_BENCH_TICKS-1])==0,"two rects weren't restored");
+
+        //Drawing with tracking on, like a notification, records its own damage
+        displayDamageTrack(true);
+        displayDrawRectangle(20,219,100,139,DISPLAY_BLACK);
+        displayDamageTrack(false);
+        bytes = displayWatchUpdate(DAMAGE_BENCH_HOURS,damageBenchMinutes(DAMAGE_BENCH_TICKS-1),(DAMAGE_BENCH_TICKS-1)%60);
+        printf("tracked damage:     %6d bytes restored\n",bytes);
+        damageBenchCheck(bytes==200*40*BYTES_PER_PIXEL,"tracked damage wasn't the 200x40 that was drawn");
+        damageBenchCheck(hostPanelCompare(damageBenchFrames[DAMAGE_BENCH_TICKS-1])==0,"tracked damage wasn't restored");
+
+        //The face blit on its own, square and with the round mask
+        for(int isRound=0;isRound<2;isRound++)
+        {
+                displaySetRoundMask(isRound);
+                displayResetWindowStats();
+                hostSpiResetStats();
+                displayImageFromAsset(0,0,WATCH_FACE_ASSET);
+                hostSpiGetStats(&stats);
+                displayGetWindowStats(&windowStats);
+                //Every window of the blit is on new rows, so RASETs count them
+                printf("face blit%s %6u bytes, %u windows\n",isRound?", round:":":        ",stats.bytes,windowStats.rasetSent);
+        }
+        displaySetRoundMask(false);
+
+        if(damageBenchFailures>0)
+        {
+                printf("%d checks failed\n",damageBenchFailures);
+                return 1;
+        }
+        printf("last tick in damageTick.ppm\n");
+        return 0;
+}
@@ -0,0 +1,277 @@
+/*
+ * geometryTest.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * The polygon fill against a brute-force point-in-polygon test of
+ * every pixel center: thick line quads, rects and concave shapes by
+ * area, and watch hands as they come out on the panel. Then the bezel
+ * table against counting the pixels outside the glass.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "sdkHost.h"
+#include "hostMocks.h"
+#include "displayDriver.h"
+#include "displayPolygon.h"
+#include "displayBezel.h"
+#include "fixedMath.h"
+#include "watchAnimations.h"
+
+//Pixels whose center is closer than this to an edge can go either way
+//with the rounding of the edge steps, in pixels
+#define GEOMETRY_EDGE_TOLERANCE (1.0/DISPLAY_SUBPIXEL)
+//Pixels behind the glass, counted once by hand
+#define GEOMETRY_BEZEL_PIXELS 12356
+
+static uint8_t geometryCover[HOST_SCREEN_HEIGHT][HOST_SCREEN_WIDTH];
+static int geometryOverlaps = 0;
+static int geometryFailures = 0;
+
+static void geometryMark(int Y, int XSTART, int XEND, int COLOR, void *USER_DATA)
+{
+        for(int x=XSTART;x<=XEND;x++)
+        {
+                if((x>=0)&&(x<HOST_SCREEN_WIDTH)&&(Y>=0)&&(Y<HOST_SCREEN_HEIGHT))
+                {
+                        geometryOverlaps += geometryCover[Y][x];
+                        geometryCover[Y][x] = 1;
+                }
+        }
+}
+//Even-odd test of a pixel center, and how far it is from the outline
+static bool geometryInside(const displayPoint_t POINTS[], int POINT_COUNT, int X, int Y, double *EDGE_DISTANCE)
+{
+        double pointX = X+0.5;
+        double pointY = Y+0.5;
+        bool isInside = false;
+
+        *EDGE_DISTANCE = 1e9;
+        for(int i=0;i<POINT_COUNT;i++)
+        {
+                const displayPoint_t *a = &POINTS[i];
+                const displayPoint_t *b = &POINTS[(i+1)%POINT_COUNT];
+                double ax = a->x/(double)DISPLAY_SUBPIXEL;
+                double ay = a->y/(double)DISPLAY_SUBPIXEL;
+                double bx = b->x/(double)DISPLAY_SUBPIXEL;
+                double by = b->y/(double)DISPLAY_SUBPIXEL;
+                double length = hypot(bx-ax,by-ay);
+                double along = (length>0)?(((pointX-ax)*(bx-ax))+((pointY-ay)*(by-ay)))/(length*length):0;
+                double distance = 0;
+
+                along = (along<0)?0:((along>1)?1:along);
+                distance = hypot(pointX-(ax+(along*(bx-ax))),pointY-(ay+(along*(by-ay))));
+                *EDGE_DISTANCE = (distance<*EDGE_DISTANCE)?distance:*EDGE_DISTANCE;
+                if(((ay>pointY)!=(by>pointY))&&(pointX<ax+((pointY-ay)*(bx-ax)/(by-ay))))
+                {
+                        isInside = !isInside;
+                }
+        }
+        return isInside;
+}
+//Compares COVER with the brute-force test, returns the pixels covered
+static int geometryCompare(const char *NAME, const displayPoint_t POINTS[], int POINT_COUNT, uint8_t COVER[HOST_SCREEN_HEIGHT][HOST_SCREEN_WIDTH])
+{
+        int covered = 0;
+        int wrong = 0;
+        for(int y=0;y<HOST_SCREEN_HEIGHT;y++)
+        {
+                for(int x=0;x<HOST_SCREEN_WIDTH;x++)
+                {
+                        double edgeDistance = 0;
+                        bool isInside = geometryInside(POINTS,POINT_COUNT,x,y,&edgeDistance);
+                        covered += COVER[y][x];
+                        if((isInside!=(COVER[y][x]!=0))&&(edgeDistance>=GEOMETRY_EDGE_TOLERANCE))
+                        {
+                                wrong++;
+                        }
+                }
+        }
+        if(wrong>0)
+        {
+                printf("FAIL %s: %d pixels wrong\n",NAME,wrong);
+                geometryFailures++;
+        }
+        return covered;
+}
+static int geometryRasterize(const char *NAME, const displayPoint_t POINTS[], int POINT_COUNT)
+{
+        memset(geometryCover,0,sizeof(geometryCover));
+        geometryOverlaps = 0;
+        displayPolygonRasterize(POINTS,POINT_COUNT,0,HOST_SCREEN_HEIGHT-1,DISPLAY_WHITE,geometryMark,NULL);
+        if(geometryOverlaps>0)
+        {
+                printf("FAIL %s: %d pixels filled twice\n",NAME,geometryOverlaps);
+                geometryFailures++;
+        }
+        return geometryCompare(NAME,POINTS,POINT_COUNT,geometryCover);
+}
+static void geometryExpectArea(const char *NAME, int AREA, int EXPECTED)
+{
+        if(AREA!=EXPECTED)
+        {
+                printf("FAIL %s: %d pixels, not %d\n",NAME,AREA,EXPECTED);
+                geometryFailures++;
+        }
+}
+
+static void geometryThickLines(void)
+{
+        static const int lines[][4] =
+        {
+                {20,220,30,200},{20,220,200,30},{120,125,10,230},{10,230,120,122},
+                {50,190,120,120},{120,120,40,200},{100,100,100,100},{30,40,200,20},
+        };
+        int checked = 0;
+        for(unsigned int line=0;line<sizeof(lines)/sizeof(lines[0]);line++)
+        {
+                for(int thickness=1;thickness<=9;thickness++)
+                {
+                        displayPoint_t quad[4];
+                        char name[48];
+                        int pointCount = displayThickLineQuad(lines[line][0],lines[line][1],lines[line][2],lines[line][3],thickness,quad);
+                        double length = hypot(lines[line][1]-lines[line][0],lines[line][3]-lines[line][2]);
+                        int area = 0;
+                        //Square ends half a width past each end, so about
+                        //(length+T)*T, give or take the pixels on the outline
+                        double expected = (length+thickness)*thickness;
+                        double slack = (2*(length+thickness))+(2*thickness)+4;
+
+                        snprintf(name,sizeof(name),"line %u thickness %d",line,thickness);
+                        area = geometryRasterize(name,quad,pointCount);
+                        if(fabs(area-expected)>slack)
+                        {
+                                printf("FAIL %s: %d pixels, expected about %.0f\n",name,area,expected);
+                                geometryFailures++;
+                        }
+                        checked++;
+                }
+        }
+        printf("thick lines:  %d quads checked\n",checked);
+}
+static void geometryShapes(void)
+{
+        //Corners on pixel edges, so the area is exact
+        static const displayPoint_t rect[] =
+        {
+                {10*DISPLAY_SUBPIXEL,10*DISPLAY_SUBPIXEL},{50*DISPLAY_SUBPIXEL,10*DISPLAY_SUBPIXEL},
+                {50*DISPLAY_SUBPIXEL,30*DISPLAY_SUBPIXEL},{10*DISPLAY_SUBPIXEL,30*DISPLAY_SUBPIXEL},
+        };
+        static const displayPoint_t concave[] =
+        {
+                {100*DISPLAY_SUBPIXEL,100*DISPLAY_SUBPIXEL},{160*DISPLAY_SUBPIXEL,100*DISPLAY_SUBPIXEL},
+                {160*DISPLAY_SUBPIXEL,120*DISPLAY_SUBPIXEL},{120*DISPLAY_SUBPIXEL,120*DISPLAY_SUBPIXEL},
+                {120*DISPLAY_SUBPIXEL,180*DISPLAY_SUBPIXEL},{100*DISPLAY_SUBPIXEL,180*DISPLAY_SUBPIXEL},
+        };
+        static const displayPoint_t notch[] =
+        {
+                {20*DISPLAY_SUBPIXEL,150*DISPLAY_SUBPIXEL},{80*DISPLAY_SUBPIXEL,150*DISPLAY_SUBPIXEL},
+                {80*DISPLAY_SUBPIXEL,210*DISPLAY_SUBPIXEL},{50*DISPLAY_SUBPIXEL,170*DISPLAY_SUBPIXEL},
+                {20*DISPLAY_SUBPIXEL,210*DISPLAY_SUBPIXEL},
+        };
+        static const displayPoint_t bowTie[] =
+        {
+                {DISPLAY_PIXEL_CENTER(150),DISPLAY_PIXEL_CENTER(20)},{DISPLAY_PIXEL_CENTER(230),DISPLAY_PIXEL_CENTER(80)},
+                {DISPLAY_PIXEL_CENTER(230),DISPLAY_PIXEL_CENTER(20)},{DISPLAY_PIXEL_CENTER(150),DISPLAY_PIXEL_CENTER(80)},
+        };
+
+        geometryExpectArea("rect",geometryRasterize("rect",rect,4),40*20);
+        geometryExpectArea("concave",geometryRasterize("concave",concave,6),(60*20)+(20*60));
+        geometryExpectArea("notch",geometryRasterize("notch",notch,5),(60*60)-(60*40/2));
+        geometryRasterize("bow tie",bowTie,4);
+        printf("shapes:       rect, concave, notch and bow tie checked\n");
+}
+//The outline displayDrawWatchHand fills, worked out the same way
+static void geometryHandShape(int RADIUS, int ANGLE, displayPoint_t HAND[4])
+{
+        int32_t handCos = fixedCos(FIXED_DEGREES(ANGLE));
+        int32_t handSin = fixedSin(FIXED_DEGREES(ANGLE));
+        int baseHalfWidth = (RADIUS*DISPLAY_SUBPIXEL)/25;
+        int tipHalfWidth = (RADIUS*DISPLAY_SUBPIXEL)/40;
+        int center = DISPLAY_PIXEL_CENTER(WATCH_CENTER);
+        int tipX = center+fixedMultiply(RADIUS*DISPLAY_SUBPIXEL,handCos);
+        int tipY = center+fixedMultiply(RADIUS*DISPLAY_SUBPIXEL,handSin);
+
+        tipHalfWidth = (tipHalfWidth<DISPLAY_SUBPIXEL/2)?DISPLAY_SUBPIXEL/2:tipHalfWidth;
+        HAND[0].x = center-fixedMultiply(baseHalfWidth,handSin);
+        HAND[0].y = center+fixedMultiply(baseHalfWidth,handCos);
+        HAND[1].x = tipX-fixedMultiply(tipHalfWidth,handSin);
+        HAND[1].y = tipY+fixedMultiply(tipHalfWidth,handCos);
+        HAND[2].x = tipX+fixedMultiply(tipHalfWidth,handSin);
+        HAND[2].y = tipY-fixedMultiply(tipHalfWidth,handCos);
+        HAND[3].x = center+fixedMultiply(baseHalfWidth,handSin);
+        HAND[3].y = center-fixedMultiply(baseHalfWidth,handCos);
+}
+//Hands go through the spans and the bus, so check what the panel got
+static void geometryHands(void)
+{
+        static const int radii[] = {WATCH_HOUR_RADIUS,WATCH_MINUTE_RADIUS,WATCH_SECOND_RADIUS};
+        int checked = 0;
+        for(unsigned int hand=0;hand<sizeof(radii)/sizeof(radii[0]);hand++)
+        {
+                for(int angle=0;angle<360;angle+=7)
+                {
+                        displayPoint_t shape[4];
+                        char name[48];
+
+                        hostPanelClear(DISPLAY_BLACK);
+                        displayDrawWatchHand(radii[hand],angle,DISPLAY_WHITE);
+                        for(int y=0;y<HOST_SCREEN_HEIGHT;y++)
+                        {
+                                for(int x=0;x<HOST_SCREEN_WIDTH;x++)
+                                {
+                                        geometryCover[y][x] = hostPanelPixel(x,y)==DISPLAY_WHITE;
+                                }
+                        }
+                        geometryHandShape(radii[hand],angle,shape);
+                        snprintf(name,sizeof(name),"radius %d hand at %d",radii[hand],angle);
+                        geometryCompare(name,shape,4,geometryCover);
+                        checked++;
+                }
+        }
+        printf("watch hands:  %d checked on the panel\n",checked);
+}
+static void geometryBezel(void)
+{
+        int tableOutside = 0;
+        int macroOutside = 0;
+        int circleOutside = 0;
+        for(int y=0;y<ST7789_HEIGHT;y++)
+        {
+                tableOutside += 2*displayBezelInsets[y];
+                for(int x=0;x<ST7789_WIDTH;x++)
+                {
+                        bool isOutside = hypot(x+0.5-(ST7789_WIDTH/2.0),y+0.5-(ST7789_HEIGHT/2.0))>DISPLAY_BEZEL_DIAMETER/2.0;
+                        bool isInset = (x<DISPLAY_BEZEL_XSTART(y))||(x>DISPLAY_BEZEL_XEND(y));
+                        circleOutside += isOutside;
+                        macroOutside += DISPLAY_BEZEL_OUTSIDE(x,y);
+                        if(isOutside!=isInset)
+                        {
+                                printf("FAIL bezel: pixel %d,%d is %s the glass but the table says otherwise\n",x,y,isOutside?"outside":"inside");
+                                geometryFailures++;
+                                return;
+                        }
+                }
+        }
+        printf("bezel:        %d pixels behind the glass, %d by the table, %d by the macro\n",circleOutside,tableOutside,macroOutside);
+        geometryExpectArea("bezel table",tableOutside,GEOMETRY_BEZEL_PIXELS);
+        geometryExpectArea("bezel macro",macroOutside,GEOMETRY_BEZEL_PIXELS);
+}
+
+int main(int ARGC, char *ARGV[])
+{
+        displayInit();
+        geometryThickLines();
+        geometryShapes();
+        geometryHands();
+        geometryBezel();
+        if(geometryFailures>0)
+        {
+                printf("%d checks failed\n",geometryFailures);
+                return 1;
+        }
+        return 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * hostFlash.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * ad_nvms mock over 16 MB of RAM that behaves like NOR flash: a write
+ * can only clear bits and an erase sets a whole 4 KB sector back to
+ * 0xFF. Writes that cross a 256 byte page and erases that don't start
+ * on a sector are counted, and one write can be made to come out wrong.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include "sdkHost.h"
+#include "hostMocks.h"
+
+static uint8_t hostFlash[HOST_FLASH_SIZE];
+static hostFlashStats_t hostFlashStats = {0};
+static uint32_t hostFlashWriteUs = 0;
+static uint32_t hostFlashEraseUs = 0;
+static uint32_t hostFlashWritesSeen = 0;
+static uint32_t hostFlashBadWrite = 0;
+
+void ad_nvms_init(void)
+{
+}
+nvms_t ad_nvms_open(int PARTITION)
+{
+        return (nvms_t)1;
+}
+int ad_nvms_read(nvms_t HANDLE, uint32_t ADDRESS, uint8_t *BUF, uint32_t LEN)
+{
+        if((ADDRESS>=HOST_FLASH_SIZE)||(LEN>HOST_FLASH_SIZE-ADDRESS))
+        {
+                return -1;
+        }
+        hostFlashStats.reads++;
+        hostFlashStats.bytesRead += LEN;
+        memcpy(BUF,&hostFlash[ADDRESS],LEN);
+        return LEN;
+}
+int ad_nvms_write(nvms_t HANDLE, uint32_t ADDRESS, const uint8_t *BUF, uint32_t SIZE)
+{
+        if((ADDRESS>=HOST_FLASH_SIZE)||(SIZE>HOST_FLASH_SIZE-ADDRESS))
+        {
+                return -1;
+        }
+        if((SIZE>0)&&((ADDRESS/HOST_FLASH_PAGE_SIZE)!=((ADDRESS+SIZE-1)/HOST_FLASH_PAGE_SIZE)))
+        {
+                hostFlashStats.pageCrossings++;
+        }
+        hostFlashStats.writes++;
+        hostFlashStats.bytesWritten += SIZE;
+        for(uint32_t i=0;i<SIZE;i++)
+        {
+                hostFlash[ADDRESS+i] &= BUF[i];
+        }
+        //A program that didn't take, only a read back can tell
+        if((++hostFlashWritesSeen==hostFlashBadWrite)&&(SIZE>0))
+        {
+                hostFlash[ADDRESS] ^= 0x01;
+        }
+        if(hostFlashWriteUs>0)
+        {
+                usleep(hostFlashWriteUs*((SIZE+HOST_FLASH_PAGE_SIZE-1)/HOST_FLASH_PAGE_SIZE));
+        }
+        return SIZE;
+}
+bool ad_nvms_erase_region(nvms_t HANDLE, uint32_t ADDRESS, size_t SIZE)
+{
+        uint32_t start = ADDRESS&~(HOST_FLASH_SECTOR_SIZE-1);
+        uint32_t end = (ADDRESS+SIZE+HOST_FLASH_SECTOR_SIZE-1)&~(HOST_FLASH_SECTOR_SIZE-1);
+
+        if((ADDRESS>=HOST_FLASH_SIZE)||(end>HOST_FLASH_SIZE))
+        {
+                return false;
+        }
+        if(ADDRESS!=start)
+        {
+                hostFlashStats.unalignedErases++;
+        }
+        for(uint32_t sector=start;sector<end;sector+=HOST_FLASH_SECTOR_SIZE)
+        {
+                memset(&hostFlash[sector],0xFF,HOST_FLASH_SECTOR_SIZE);
+                hostFlashStats.erases++;
+                if(hostFlashEraseUs>0)
+                {
+                        usleep(hostFlashEraseUs);
+                }
+        }
+        return true;
+}
+size_t ad_nvms_get_size(nvms_t HANDLE)
+{
+        return HOST_FLASH_SIZE;
+}
+
+uint8_t *hostFlashMemory(void)
+{
+        return hostFlash;
+}
+void hostFlashFill(uint8_t VALUE)
+{
+        memset(hostFlash,VALUE,sizeof(hostFlash));
+}
+bool hostFlashLoad(const char *PATH)
+{
+        FILE *image = fopen(PATH,"rb");
+        if(image==NULL)
+        {
+                return false;
+        }
+        fread(hostFlash,1,sizeof(hostFlash),image);
+        fclose(image);
+        return true;
+}
+bool hostFlashSave(const char *PATH, uint32_t SIZE)
+{
+        FILE *image = fopen(PATH,"wb");
+        if(image==NULL)
+        {
+                return false;
+        }
+        fwrite(hostFlash,1,(SIZE>HOST_FLASH_SIZE)?HOST_FLASH_SIZE:SIZE,image);
+        return fclose(image)==0;
+}
+//How long each page write and sector erase takes, so a loader on the
+//other end of a pty sees something like the real thing
+void hostFlashSetTiming(uint32_t WRITE_US, uint32_t ERASE_US)
+{
+        hostFlashWriteUs = WRITE_US;
+        hostFlashEraseUs = ERASE_US;
+}
+//Write number WRITE_NUMBER from now on flips a bit, 0 for none
+void hostFlashFailWrite(uint32_t WRITE_NUMBER)
+{
+        hostFlashWritesSeen = 0;
+        hostFlashBadWrite = WRITE_NUMBER;
+}
+void hostFlashGetStats(hostFlashStats_t *STATS)
+{
+        *STATS = hostFlashStats;
+}
+void hostFlashResetStats(void)
+{
+        memset(&hostFlashStats,0,sizeof(hostFlashStats));
+}
@@ -0,0 +1,255 @@
+/*
+ * hostImage.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * The image encoders of bitmapToArray's Form1.cs in C, plus some made
+ * up pictures to encode.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkHost.h"
+#include "hostMocks.h"
+#include "hostImage.h"
+#include "displayImage.h"
+
+//Raw rows are padded to 4 bytes like the BMP they come from
+int hostImageRawStride(int WIDTH)
+{
+        return (((WIDTH*2)+3)&~3)/2;
+}
+//A 2 byte size, saturated, then big endian RGB565 rows
+int hostImageEncodeRaw(const uint16_t PIXELS[], int WIDTH, int HEIGHT, uint8_t OUT[], int MAX_SIZE)
+{
+        int stride = hostImageRawStride(WIDTH);
+        int size = 2+(stride*HEIGHT*2);
+        if(size>MAX_SIZE)
+        {
+                return -1;
+        }
+        memset(OUT,0,size);
+        OUT[0] = (WIDTH>255)?255:WIDTH;
+        OUT[1] = (HEIGHT>255)?255:HEIGHT;
+        for(int y=0;y<HEIGHT;y++)
+        {
+                for(int x=0;x<WIDTH;x++)
+                {
+                        uint16_t color = PIXELS[(y*WIDTH)+x];
+                        OUT[2+(((y*stride)+x)*2)] = color>>8;
+                        OUT[3+(((y*stride)+x)*2)] = color&0xFF;
+                }
+        }
+        return size;
+}
+static void hostPut16(uint8_t OUT[], uint16_t VALUE)
+{
+        OUT[0] = VALUE&0xFF;
+        OUT[1] = VALUE>>8;
+}
+static void hostPut32(uint8_t OUT[], uint32_t VALUE)
+{
+        hostPut16(OUT,VALUE&0xFFFF);
+        hostPut16(&OUT[2],VALUE>>16);
+}
+//Blocks of HOST_IMAGE_ROWS_PER_BLOCK rows, each a run of literals and
+//repeats. Returns -1 if it doesn't fit, unlike bitmapToArray it doesn't
+//give up when the result is bigger than raw
+int hostImageEncodeRle(const uint16_t PIXELS[], int WIDTH, int HEIGHT, uint8_t OUT[], int MAX_SIZE)
+{
+        int blockCount = (HEIGHT+HOST_IMAGE_ROWS_PER_BLOCK-1)/HOST_IMAGE_ROWS_PER_BLOCK;
+        int headerSize = sizeof(displayImageHeader_t)+(blockCount*4);
+        int size = headerSize;
+
+        if((WIDTH<1)||(WIDTH>255)||(HEIGHT<1)||(HEIGHT>255)||(headerSize>MAX_SIZE))
+        {
+                return -1;
+        }
+        for(int block=0;block<blockCount;block++)
+        {
+                const uint16_t *pixels = &PIXELS[block*HOST_IMAGE_ROWS_PER_BLOCK*WIDTH];
+                int rows = ((HEIGHT-(block*HOST_IMAGE_ROWS_PER_BLOCK))<HOST_IMAGE_ROWS_PER_BLOCK)?(HEIGHT-(block*HOST_IMAGE_ROWS_PER_BLOCK)):HOST_IMAGE_ROWS_PER_BLOCK;
+                int pixelCount = rows*WIDTH;
+                int literalStart = 0;
+                int literalCount = 0;
+                int pixel = 0;
+
+                hostPut32(&OUT[sizeof(displayImageHeader_t)+(block*4)],size-headerSize);
+                while(pixel<=pixelCount)
+                {
+                        int runLength = 1;
+                        while((pixel+runLength<pixelCount)&&(runLength<HOST_IMAGE_RLE_MAX_COUNT)&&(pixels[pixel+runLength]==pixels[pixel]))
+                        {
+                                runLength++;
+                        }
+                        if((literalCount>0)&&((pixel==pixelCount)||(runLength>1)||(literalCount==HOST_IMAGE_RLE_MAX_COUNT)))
+                        {
+                                if(size+1+(literalCount*2)>MAX_SIZE)
+                                {
+                                        return -1;
+                                }
+                                OUT[size++] = literalCount-1;
+                                for(int i=0;i<literalCount;i++)
+                                {
+                                        OUT[size++] = pixels[literalStart+i]>>8;
+                                        OUT[size++] = pixels[literalStart+i]&0xFF;
+                                }
+                                literalCount = 0;
+                        }
+                        if(pixel==pixelCount)
+                        {
+                                break;
+                        }
+                        if(runLength>1)
+                        {
+                                if(size+3>MAX_SIZE)
+                                {
+                                        return -1;
+                                }
+                                OUT[size++] = DISPLAY_IMAGE_RLE_RUN+runLength-1;
+                                OUT[size++] = pixels[pixel]>>8;
+                                OUT[size++] = pixels[pixel]&0xFF;
+                                pixel += runLength;
+                        }
+                        else
+                        {
+                                if(literalCount==0)
+                                {
+                                        literalStart = pixel;
+                                }
+                                literalCount++;
+                                pixel++;
+                        }
+                }
+        }
+        OUT[0] = 0;
+        OUT[1] = DISPLAY_IMAGE_FORMAT_RLE16;
+        OUT[2] = WIDTH;
+        OUT[3] = HEIGHT;
+        hostPut16(&OUT[4],HOST_IMAGE_ROWS_PER_BLOCK);
+        hostPut16(&OUT[6],blockCount);
+        hostPut32(&OUT[8],size-headerSize);
+        OUT[12] = 16;
+        OUT[13] = 0;
+        hostPut16(&OUT[14],0);
+        return size;
+}
+//Palette of little endian colors and rows of indices, most significant
+//first. BITS_PER_PIXEL 0 picks the smallest that holds every color.
+//Returns -1 if there are too many colors for it
+int hostImageEncodeIndexed(const uint16_t PIXELS[], int WIDTH, int HEIGHT, int BITS_PER_PIXEL, uint8_t OUT[], int MAX_SIZE)
+{
+        static uint16_t palette[DISPLAY_IMAGE_MAX_COLORS];
+        int paletteCount = 0;
+        int rowSize = 0;
+        int size = 0;
+
+        if((WIDTH<1)||(WIDTH>255)||(HEIGHT<1)||(HEIGHT>255))
+        {
+                return -1;
+        }
+        for(int i=0;i<WIDTH*HEIGHT;i++)
+        {
+                int index = 0;
+                while((index<paletteCount)&&(palette[index]!=PIXELS[i]))
+                {
+                        index++;
+                }
+                if(index==paletteCount)
+                {
+                        if(paletteCount==DISPLAY_IMAGE_MAX_COLORS)
+                        {
+                                return -1;
+                        }
+                        palette[paletteCount++] = PIXELS[i];
+                }
+        }
+        if(BITS_PER_PIXEL==0)
+        {
+                BITS_PER_PIXEL = (paletteCount<=4)?2:((paletteCount<=16)?4:8);
+        }
+        if(paletteCount>(1<<BITS_PER_PIXEL))
+        {
+                return -1;
+        }
+        rowSize = ((WIDTH*BITS_PER_PIXEL)+7)/8;
+        size = sizeof(displayImageHeader_t)+(paletteCount*2)+(rowSize*HEIGHT);
+        if(size>MAX_SIZE)
+        {
+                return -1;
+        }
+        memset(OUT,0,size);
+        OUT[1] = DISPLAY_IMAGE_FORMAT_INDEXED;
+        OUT[2] = WIDTH;
+        OUT[3] = HEIGHT;
+        hostPut32(&OUT[8],rowSize*HEIGHT);
+        OUT[12] = BITS_PER_PIXEL;
+        hostPut16(&OUT[14],paletteCount);
+        for(int i=0;i<paletteCount;i++)
+        {
+                hostPut16(&OUT[sizeof(displayImageHeader_t)+(i*2)],palette[i]);
+        }
+        for(int y=0;y<HEIGHT;y++)
+        {
+                uint8_t *row = &OUT[sizeof(displayImageHeader_t)+(paletteCount*2)+(y*rowSize)];
+                for(int x=0;x<WIDTH;x++)
+                {
+                        int index = 0;
+                        int bit = x*BITS_PER_PIXEL;
+                        while(palette[index]!=PIXELS[(y*WIDTH)+x])
+                        {
+                                index++;
+                        }
+                        row[bit>>3] |= index<<(8-BITS_PER_PIXEL-(bit&7));
+                }
+        }
+        return size;
+}
+//A 240x240 face: a stepped gradient with a ring and twelve markers, in
+//flat patches so it packs the way a drawn face would. VARIANT moves
+//the colors of one marker so packs can differ in a few sectors
+void hostTestFace(uint16_t PIXELS[], int VARIANT)
+{
+        for(int y=0;y<240;y++)
+        {
+                for(int x=0;x<240;x++)
+                {
+                        int dx = x-120;
+                        int dy = y-120;
+                        int distance = (dx*dx)+(dy*dy);
+                        uint16_t color = (((x/24)*3)<<11)|(((y/24)*6)<<5)|(((x+y)/48)*3);
+                        if((distance>=102*102)&&(distance<106*106))
+                        {
+                                color = 0xC618;
+                        }
+                        //Markers at the hours on a 96 pixel circle
+                        for(int hour=0;hour<12;hour++)
+                        {
+                                static const int8_t markerX[12] = {0,48,83,96,83,48,0,-48,-83,-96,-83,-48};
+                                static const int8_t markerY[12] = {-96,-83,-48,0,48,83,96,83,48,0,-48,-83};
+                                int mx = dx-markerX[hour];
+                                int my = dy-markerY[hour];
+                                if((mx*mx)+(my*my)<=16)
+                                {
+                                        color = (hour==(VARIANT%12)&&(VARIANT>0))?0xF800:0xFFFF;
+                                }
+                        }
+                        PIXELS[(y*240)+x] = color;
+                }
+        }
+}
+//A small picture with few colors, different for each SEED
+void hostTestIcon(uint16_t PIXELS[], int WIDTH, int HEIGHT, int SEED)
+{
+        static const uint16_t colors[] = {0x0000,0xFFFF,0xF800,0x07E0,0x001F,0xFFE0,0x07FF,0xF81F};
+        for(int y=0;y<HEIGHT;y++)
+        {
+                for(int x=0;x<WIDTH;x++)
+                {
+                        int band = ((x*3)/WIDTH)+(((y+SEED)*3)/HEIGHT);
+                        PIXELS[(y*WIDTH)+x] = colors[(band+SEED)%8];
+                }
+        }
+}
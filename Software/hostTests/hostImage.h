@@ -0,0 +1,29 @@
+/*
+ * hostImage.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Images encoded the way bitmapToArray encodes them, and made up
+ * pictures to encode.
+ */
+
+#ifndef HOSTIMAGE_H_
+#define HOSTIMAGE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Same block height and longest run as bitmapToArray
+#define HOST_IMAGE_ROWS_PER_BLOCK 8
+#define HOST_IMAGE_RLE_MAX_COUNT 128
+
+int  hostImageRawStride(int WIDTH);
+int  hostImageEncodeRaw(const uint16_t PIXELS[], int WIDTH, int HEIGHT, uint8_t OUT[], int MAX_SIZE);
+int  hostImageEncodeRle(const uint16_t PIXELS[], int WIDTH, int HEIGHT, uint8_t OUT[], int MAX_SIZE);
+int  hostImageEncodeIndexed(const uint16_t PIXELS[], int WIDTH, int HEIGHT, int BITS_PER_PIXEL, uint8_t OUT[], int MAX_SIZE);
+
+void hostTestFace(uint16_t PIXELS[], int VARIANT);
+void hostTestIcon(uint16_t PIXELS[], int WIDTH, int HEIGHT, int SEED);
+
+#endif /* HOSTIMAGE_H_ */
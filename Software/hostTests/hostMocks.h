@@ -0,0 +1,73 @@
+/*
+ * hostMocks.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * What the tests can see of the SDK mocks: the traffic on the display
+ * SPI bus, the ST7789 the bus drives and the NVMS flash.
+ */
+
+#ifndef HOSTMOCKS_H_
+#define HOSTMOCKS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Visible part of the panel, the controller's RAM is 240x320 and the
+//firmware draws from row ST7789_HEIGHT_OFFSET on
+#define HOST_SCREEN_WIDTH 240
+#define HOST_SCREEN_HEIGHT 240
+#define HOST_PANEL_ROWS 320
+#define HOST_PANEL_ROW_OFFSET 40
+
+#define HOST_FLASH_SIZE (16*1024*1024)
+#define HOST_FLASH_PAGE_SIZE 256
+#define HOST_FLASH_SECTOR_SIZE 4096
+
+//Traffic seen by the ad_spi mock
+typedef struct
+{
+        uint32_t opens;
+        uint32_t closes;
+        uint32_t writes;
+        uint32_t asyncWrites;
+        uint32_t bytes;
+        uint32_t commandBytes;
+        uint32_t modeSwitches;
+        uint32_t pixelsWritten;
+} hostSpiStats_t;
+
+//Traffic seen by the ad_nvms mock
+typedef struct
+{
+        uint32_t reads;
+        uint32_t bytesRead;
+        uint32_t writes;
+        uint32_t bytesWritten;
+        uint32_t erases;
+        uint32_t pageCrossings;
+        uint32_t unalignedErases;
+} hostFlashStats_t;
+
+void hostSpiGetStats(hostSpiStats_t *STATS);
+void hostSpiResetStats(void);
+bool hostSpiIsOpen(void);
+
+void hostPanelClear(uint16_t COLOR);
+uint16_t hostPanelPixel(int X, int Y);
+void hostPanelCopy(uint16_t SCREEN[HOST_SCREEN_WIDTH*HOST_SCREEN_HEIGHT]);
+int  hostPanelCompare(const uint16_t SCREEN[HOST_SCREEN_WIDTH*HOST_SCREEN_HEIGHT]);
+bool hostPanelSavePpm(const char *PATH);
+bool hostScreenSavePpm(const char *PATH, const uint16_t SCREEN[HOST_SCREEN_WIDTH*HOST_SCREEN_HEIGHT]);
+
+uint8_t *hostFlashMemory(void);
+void hostFlashFill(uint8_t VALUE);
+bool hostFlashLoad(const char *PATH);
+bool hostFlashSave(const char *PATH, uint32_t SIZE);
+void hostFlashSetTiming(uint32_t WRITE_US, uint32_t ERASE_US);
+void hostFlashFailWrite(uint32_t WRITE_NUMBER);
+void hostFlashGetStats(hostFlashStats_t *STATS);
+void hostFlashResetStats(void);
+
+#endif /* HOSTMOCKS_H_ */
@@ -0,0 +1,34 @@
+/*
+ * hostOsal.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * The OS and GPIO pieces of the SDK the firmware uses. Time is a
+ * counter that delays move on, so a 1 s delay in displayInit costs
+ * nothing on the host.
+ */
+
+#include "sdkHost.h"
+
+static uint32_t hostMilliseconds = 0;
+
+void hw_gpio_set_active(int PORT, int PIN)
+{
+}
+void hw_gpio_set_inactive(int PORT, int PIN)
+{
+}
+void hostDelayMs(uint32_t MS)
+{
+        hostMilliseconds += MS;
+}
+uint32_t hostTickCount(void)
+{
+        return hostMilliseconds;
+}
+//Nobody is listening unless a test stands in for the other task
+__attribute__((weak)) int hostTaskNotify(TaskHandle_t TASK, uint32_t VALUE)
+{
+        return OS_OK;
+}
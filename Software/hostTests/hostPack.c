@@ -0,0 +1,161 @@
+/*
+ * hostPack.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * The pack layout of bitmapToArray's Form1.cs in C, so tests can put
+ * assets in the mock flash the way the loader would.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkHost.h"
+#include "hostMocks.h"
+#include "hostPack.h"
+#include "displayImage.h"
+
+//The directory goes in front, so the asset count has to be known first
+bool hostPackBegin(hostPack_t *PACK, int ASSET_COUNT)
+{
+        memset(PACK,0,sizeof(*PACK));
+        if((ASSET_COUNT<1)||(ASSET_COUNT>DISPLAY_ASSET_MAX_ASSETS))
+        {
+                return false;
+        }
+        PACK->data = calloc(1,HOST_PACK_MAX_SIZE);
+        PACK->assetsReserved = ASSET_COUNT;
+        PACK->size = sizeof(displayAssetHeader_t)+(ASSET_COUNT*sizeof(displayAsset_t));
+        return PACK->data!=NULL;
+}
+bool hostPackAdd(hostPack_t *PACK, const char *NAME, const uint8_t DATA[], uint32_t LENGTH, uint8_t FORMAT, int WIDTH, int HEIGHT, int STRIDE)
+{
+        displayAsset_t *entry = &PACK->entries[PACK->assetCount];
+        if((PACK->assetCount>=PACK->assetsReserved)||(LENGTH>HOST_PACK_MAX_SIZE-PACK->size))
+        {
+                return false;
+        }
+        memset(entry,0,sizeof(*entry));
+        entry->id = displayAssetHash(NAME);
+        entry->offset = PACK->size;
+        entry->length = LENGTH;
+        entry->format = FORMAT;
+        entry->width = WIDTH;
+        entry->height = HEIGHT;
+        entry->stride = STRIDE;
+        entry->checksum = displayAssetCrc32(0,DATA,LENGTH);
+        memcpy(&PACK->data[PACK->size],DATA,LENGTH);
+        PACK->size += LENGTH;
+        PACK->assetCount++;
+        return true;
+}
+//Stored like bitmapToArray would: run length or indexed, whichever is
+//smaller, unless neither beats raw by a quarter
+bool hostPackAddImage(hostPack_t *PACK, const char *NAME, const uint16_t PIXELS[], int WIDTH, int HEIGHT)
+{
+        static uint8_t runLength[HOST_PACK_MAX_SIZE];
+        static uint8_t indexed[HOST_PACK_MAX_SIZE];
+        static uint8_t raw[HOST_PACK_MAX_SIZE];
+        int rawSize = WIDTH*HEIGHT*2;
+        int runLengthSize = hostImageEncodeRle(PIXELS,WIDTH,HEIGHT,runLength,sizeof(runLength));
+        int indexedSize = hostImageEncodeIndexed(PIXELS,WIDTH,HEIGHT,0,indexed,sizeof(indexed));
+        int size = 0;
+
+        if((runLengthSize>0)&&(runLengthSize*4>rawSize*3))
+        {
+                runLengthSize = -1;
+        }
+        if((indexedSize>0)&&(indexedSize*4<=rawSize*3)&&((runLengthSize<0)||(indexedSize<runLengthSize)))
+        {
+                return hostPackAdd(PACK,NAME,indexed,indexedSize,DISPLAY_IMAGE_FORMAT_INDEXED,WIDTH,HEIGHT,WIDTH);
+        }
+        if(runLengthSize>0)
+        {
+                return hostPackAdd(PACK,NAME,runLength,runLengthSize,DISPLAY_IMAGE_FORMAT_RLE16,WIDTH,HEIGHT,WIDTH);
+        }
+        size = hostImageEncodeRaw(PIXELS,WIDTH,HEIGHT,raw,sizeof(raw));
+        return (size>0)&&hostPackAdd(PACK,NAME,raw,size,DISPLAY_IMAGE_FORMAT_RAW,WIDTH,HEIGHT,hostImageRawStride(WIDTH));
+}
+//Fills in the header and directory, returns the pack size
+uint32_t hostPackEnd(hostPack_t *PACK)
+{
+        displayAssetHeader_t header;
+        uint32_t directorySize = PACK->assetCount*sizeof(displayAsset_t);
+
+        //Assets that weren't added leave a gap, close it up
+        if(PACK->assetCount<PACK->assetsReserved)
+        {
+                uint32_t gap = (PACK->assetsReserved-PACK->assetCount)*sizeof(displayAsset_t);
+                uint32_t start = sizeof(header)+(PACK->assetsReserved*sizeof(displayAsset_t));
+                memmove(&PACK->data[start-gap],&PACK->data[start],PACK->size-start);
+                PACK->size -= gap;
+                for(int i=0;i<PACK->assetCount;i++)
+                {
+                        PACK->entries[i].offset -= gap;
+                }
+                PACK->assetsReserved = PACK->assetCount;
+        }
+        header.magic = DISPLAY_ASSET_MAGIC;
+        header.version = DISPLAY_ASSET_VERSION;
+        header.reserved = 0;
+        header.assetCount = PACK->assetCount;
+        header.packSize = PACK->size;
+        header.checksum = displayAssetCrc32(0,(const uint8_t *)PACK->entries,directorySize);
+        memcpy(PACK->data,&header,sizeof(header));
+        memcpy(&PACK->data[sizeof(header)],PACK->entries,directorySize);
+        return PACK->size;
+}
+uint32_t hostPackCrc(const hostPack_t *PACK)
+{
+        return displayAssetCrc32(0,PACK->data,PACK->size);
+}
+//Programs the pack into BANK, commits it and loads its directory
+bool hostPackInstall(const hostPack_t *PACK, int BANK)
+{
+        nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        int base = displayAssetBankAddress(BANK);
+        if((base<0)||(PACK->size>DISPLAY_ASSET_BANK_SIZE))
+        {
+                return false;
+        }
+        ad_nvms_erase_region(flashMemory,base,PACK->size);
+        for(uint32_t offset=0;offset<PACK->size;offset+=HOST_FLASH_PAGE_SIZE)
+        {
+                uint32_t length = ((PACK->size-offset)>HOST_FLASH_PAGE_SIZE)?HOST_FLASH_PAGE_SIZE:(PACK->size-offset);
+                ad_nvms_write(flashMemory,base+offset,&PACK->data[offset],length);
+        }
+        return displayAssetsCommit(BANK,PACK->size,hostPackCrc(PACK))&&displayAssetsLoad();
+}
+bool hostPackSave(const hostPack_t *PACK, const char *PATH)
+{
+        FILE *packFile = fopen(PATH,"wb");
+        if(packFile==NULL)
+        {
+                return false;
+        }
+        fwrite(PACK->data,1,PACK->size,packFile);
+        return fclose(packFile)==0;
+}
+void hostPackFree(hostPack_t *PACK)
+{
+        free(PACK->data);
+        PACK->data = NULL;
+}
+
+//A pack of just WATCH_FACE, installed and loaded
+bool hostPackInstallFace(int BANK, int VARIANT)
+{
+        static uint16_t face[240*240];
+        hostPack_t pack;
+        bool isInstalled = false;
+
+        hostTestFace(face,VARIANT);
+        if(hostPackBegin(&pack,1)&&hostPackAddImage(&pack,"WATCH_FACE",face,240,240))
+        {
+                hostPackEnd(&pack);
+                isInstalled = hostPackInstall(&pack,BANK);
+        }
+        hostPackFree(&pack);
+        return isInstalled;
+}
@@ -0,0 +1,41 @@
+/*
+ * hostPack.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Builds asset packs the way bitmapToArray does, so tests can put
+ * images in the mock flash and make pack files for the loader.
+ */
+
+#ifndef HOSTPACK_H_
+#define HOSTPACK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "displayAssets.h"
+#include "hostImage.h"
+
+#define HOST_PACK_MAX_SIZE (2*1024*1024)
+
+typedef struct
+{
+        uint8_t *data;
+        uint32_t size;
+        int assetCount;
+        int assetsReserved;
+        displayAsset_t entries[DISPLAY_ASSET_MAX_ASSETS];
+} hostPack_t;
+
+bool hostPackBegin(hostPack_t *PACK, int ASSET_COUNT);
+bool hostPackAdd(hostPack_t *PACK, const char *NAME, const uint8_t DATA[], uint32_t LENGTH, uint8_t FORMAT, int WIDTH, int HEIGHT, int STRIDE);
+bool hostPackAddImage(hostPack_t *PACK, const char *NAME, const uint16_t PIXELS[], int WIDTH, int HEIGHT);
+uint32_t hostPackEnd(hostPack_t *PACK);
+uint32_t hostPackCrc(const hostPack_t *PACK);
+bool hostPackInstall(const hostPack_t *PACK, int BANK);
+bool hostPackSave(const hostPack_t *PACK, const char *PATH);
+void hostPackFree(hostPack_t *PACK);
+
+bool hostPackInstallFace(int BANK, int VARIANT);
+
+#endif /* HOSTPACK_H_ */
@@ -0,0 +1,234 @@
+/*
+ * hostSpi.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * ad_spi mock with an ST7789 behind it. Every call is counted, and the
+ * bytes are decoded the way the controller would: the 9th bit selects
+ * command or data, CASET and RASET set the window and RAMWR/RAMWRC
+ * fill it, so the tests can look at what ended up on screen.
+ */
+
+#include <stdio.h>
+#include "sdkHost.h"
+#include "hostMocks.h"
+
+#define HOST_ST7789_CASET 0x2A
+#define HOST_ST7789_RASET 0x2B
+#define HOST_ST7789_RAMWR 0x2C
+#define HOST_ST7789_RAMWRC 0x3C
+
+static hostSpiStats_t hostSpiStats = {0};
+static int hostSpiOpenDepth = 0;
+static int hostSpiDataMode = 0;
+static bool hostSpiHasComplained = false;
+
+//Controller state
+static uint16_t hostPanelRam[HOST_PANEL_ROWS][HOST_SCREEN_WIDTH];
+static uint8_t hostPanelCommand = 0;
+static uint8_t hostPanelParameters[4];
+static int hostPanelParameterCount = 0;
+static int hostPanelColumnStart = 0;
+static int hostPanelColumnEnd = HOST_SCREEN_WIDTH-1;
+static int hostPanelRowStart = 0;
+static int hostPanelRowEnd = HOST_PANEL_ROWS-1;
+static int hostPanelX = 0;
+static int hostPanelY = 0;
+static int hostPanelHighByte = -1;
+
+static void hostPanelCommandByte(uint8_t COMMAND)
+{
+        hostPanelCommand = COMMAND;
+        hostPanelParameterCount = 0;
+        hostPanelHighByte = -1;
+        if(COMMAND==HOST_ST7789_RAMWR)
+        {
+                hostPanelX = hostPanelColumnStart;
+                hostPanelY = hostPanelRowStart;
+        }
+}
+static void hostPanelDataByte(uint8_t DATA)
+{
+        if((hostPanelCommand==HOST_ST7789_CASET)||(hostPanelCommand==HOST_ST7789_RASET))
+        {
+                if(hostPanelParameterCount<4)
+                {
+                        hostPanelParameters[hostPanelParameterCount++] = DATA;
+                }
+                if(hostPanelParameterCount==4)
+                {
+                        int start = (hostPanelParameters[0]<<8)|hostPanelParameters[1];
+                        int end = (hostPanelParameters[2]<<8)|hostPanelParameters[3];
+                        if(hostPanelCommand==HOST_ST7789_CASET)
+                        {
+                                hostPanelColumnStart = start;
+                                hostPanelColumnEnd = end;
+                        }
+                        else
+                        {
+                                hostPanelRowStart = start;
+                                hostPanelRowEnd = end;
+                        }
+                }
+                return;
+        }
+        if((hostPanelCommand!=HOST_ST7789_RAMWR)&&(hostPanelCommand!=HOST_ST7789_RAMWRC))
+        {
+                return;
+        }
+        if(hostPanelHighByte<0)
+        {
+                hostPanelHighByte = DATA;
+                return;
+        }
+        if((hostPanelX>=0)&&(hostPanelX<HOST_SCREEN_WIDTH)&&(hostPanelY>=0)&&(hostPanelY<HOST_PANEL_ROWS))
+        {
+                hostPanelRam[hostPanelY][hostPanelX] = (hostPanelHighByte<<8)|DATA;
+        }
+        hostPanelHighByte = -1;
+        hostSpiStats.pixelsWritten++;
+        //The address counter wraps inside the window like the real one
+        if(++hostPanelX>hostPanelColumnEnd)
+        {
+                hostPanelX = hostPanelColumnStart;
+                if(++hostPanelY>hostPanelRowEnd)
+                {
+                        hostPanelY = hostPanelRowStart;
+                }
+        }
+}
+static void hostSpiBytes(const uint8_t *DATA, size_t LENGTH)
+{
+        if((hostSpiOpenDepth==0)&&!hostSpiHasComplained)
+        {
+                fprintf(stderr,"hostSpi: write with the bus closed\n");
+                hostSpiHasComplained = true;
+        }
+        hostSpiStats.bytes += LENGTH;
+        for(size_t i=0;i<LENGTH;i++)
+        {
+                if(hostSpiDataMode)
+                {
+                        hostPanelDataByte(DATA[i]);
+                }
+                else
+                {
+                        hostSpiStats.commandBytes++;
+                        hostPanelCommandByte(DATA[i]);
+                }
+        }
+}
+
+void ad_spi_init(void)
+{
+}
+spi_device ad_spi_open(int DEVICE)
+{
+        hostSpiOpenDepth++;
+        hostSpiStats.opens++;
+        return (spi_device)1;
+}
+void ad_spi_close(spi_device DEVICE)
+{
+        hostSpiOpenDepth--;
+        hostSpiStats.closes++;
+}
+void ad_spi_write(spi_device DEVICE, const uint8_t *WBUF, size_t WLEN)
+{
+        hostSpiStats.writes++;
+        hostSpiBytes(WBUF,WLEN);
+}
+//Done by the time it returns, so the callback comes straight away
+void ad_spi_write_async(spi_device DEVICE, const uint8_t *WBUF, size_t WLEN, ad_spi_user_cb CB, void *USER_DATA)
+{
+        hostSpiStats.asyncWrites++;
+        hostSpiBytes(WBUF,WLEN);
+        if(CB!=NULL)
+        {
+                CB(USER_DATA,WLEN);
+        }
+}
+HW_SPI_ID ad_spi_get_hw_spi_id(spi_device DEVICE)
+{
+        return 0;
+}
+void hw_spi_set_9th_bit(HW_SPI_ID ID, int VALUE)
+{
+        hostSpiStats.modeSwitches++;
+        hostSpiDataMode = VALUE;
+}
+
+void hostSpiGetStats(hostSpiStats_t *STATS)
+{
+        *STATS = hostSpiStats;
+}
+void hostSpiResetStats(void)
+{
+        memset(&hostSpiStats,0,sizeof(hostSpiStats));
+}
+bool hostSpiIsOpen(void)
+{
+        return hostSpiOpenDepth>0;
+}
+
+void hostPanelClear(uint16_t COLOR)
+{
+        for(int y=0;y<HOST_PANEL_ROWS;y++)
+        {
+                for(int x=0;x<HOST_SCREEN_WIDTH;x++)
+                {
+                        hostPanelRam[y][x] = COLOR;
+                }
+        }
+}
+//Pixel at screen coordinates
+uint16_t hostPanelPixel(int X, int Y)
+{
+        return hostPanelRam[Y+HOST_PANEL_ROW_OFFSET][X];
+}
+void hostPanelCopy(uint16_t SCREEN[HOST_SCREEN_WIDTH*HOST_SCREEN_HEIGHT])
+{
+        for(int y=0;y<HOST_SCREEN_HEIGHT;y++)
+        {
+                memcpy(&SCREEN[y*HOST_SCREEN_WIDTH],hostPanelRam[y+HOST_PANEL_ROW_OFFSET],HOST_SCREEN_WIDTH*sizeof(uint16_t));
+        }
+}
+//Returns how many pixels of the screen differ from SCREEN
+int hostPanelCompare(const uint16_t SCREEN[HOST_SCREEN_WIDTH*HOST_SCREEN_HEIGHT])
+{
+        int differences = 0;
+        for(int y=0;y<HOST_SCREEN_HEIGHT;y++)
+        {
+                for(int x=0;x<HOST_SCREEN_WIDTH;x++)
+                {
+                        differences += hostPanelPixel(x,y)!=SCREEN[(y*HOST_SCREEN_WIDTH)+x];
+                }
+        }
+        return differences;
+}
+bool hostScreenSavePpm(const char *PATH, const uint16_t SCREEN[HOST_SCREEN_WIDTH*HOST_SCREEN_HEIGHT])
+{
+        FILE *ppm = fopen(PATH,"wb");
+        if(ppm==NULL)
+        {
+                return false;
+        }
+        fprintf(ppm,"P6\n%d %d\n255\n",HOST_SCREEN_WIDTH,HOST_SCREEN_HEIGHT);
+        for(int i=0;i<HOST_SCREEN_WIDTH*HOST_SCREEN_HEIGHT;i++)
+        {
+                uint16_t color = SCREEN[i];
+                uint8_t rgb[3];
+                rgb[0] = ((color>>11)&0x1F)*255/31;
+                rgb[1] = ((color>>5)&0x3F)*255/63;
+                rgb[2] = (color&0x1F)*255/31;
+                fwrite(rgb,1,sizeof(rgb),ppm);
+        }
+        return fclose(ppm)==0;
+}
+bool hostPanelSavePpm(const char *PATH)
+{
+        static uint16_t screen[HOST_SCREEN_WIDTH*HOST_SCREEN_HEIGHT];
+        hostPanelCopy(screen);
+        return hostScreenSavePpm(PATH,screen);
+}
@@ -0,0 +1,267 @@
+/*
+ * imageTest.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Run length and 2/4/8 bpp indexed images encoded like bitmapToArray
+ * does, put in the mock flash and decoded back: whole, in random
+ * segments and into buffers at every alignment. Also the palette calls.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkHost.h"
+#include "hostMocks.h"
+#include "hostImage.h"
+#include "displayImage.h"
+
+#define IMAGE_TEST_ADDRESS 0x100000
+#define IMAGE_TEST_SEGMENTS 2000
+#define IMAGE_TEST_MAX_PIXELS (255*255)
+//Literals cost a control byte every 128 pixels on top of the pixels
+#define IMAGE_TEST_MAX_ENCODED (IMAGE_TEST_MAX_PIXELS*3)
+
+typedef struct
+{
+        int width;
+        int height;
+        int colors;
+} imageTestSize_t;
+
+static const imageTestSize_t imageTestSizes[] =
+{
+        {1,1,1},{7,5,3},{33,17,4},{31,9,16},{64,40,11},{255,3,200},{13,255,256},{240,240,90},{97,61,2},
+};
+
+static uint16_t imageTestPixels[IMAGE_TEST_MAX_PIXELS];
+static uint8_t imageTestEncoded[IMAGE_TEST_MAX_ENCODED];
+//Room for every alignment of the longest decode
+static uint8_t imageTestOut[(IMAGE_TEST_MAX_PIXELS*2)+8];
+static int imageTestFailures = 0;
+
+//Runs of a few colors broken up with noise, so both kinds of RLE token
+//turn up and an indexed image gets exactly COLORS colors
+static void imageTestPicture(int WIDTH, int HEIGHT, int COLORS, unsigned int SEED)
+{
+        uint16_t palette[DISPLAY_IMAGE_MAX_COLORS];
+        int color = 0;
+
+        srand(SEED);
+        for(int i=0;i<COLORS;i++)
+        {
+                palette[i] = (i*0x9E37)^0x5A5A;
+        }
+        for(int i=0;i<WIDTH*HEIGHT;i++)
+        {
+                if((rand()%7)==0)
+                {
+                        color = rand()%COLORS;
+                }
+                imageTestPixels[i] = palette[((i%3)==0)?(rand()%COLORS):color];
+        }
+        //Every color at least once
+        for(int i=0;(i<COLORS)&&(i<WIDTH*HEIGHT);i++)
+        {
+                imageTestPixels[(i*7919)%(WIDTH*HEIGHT)] = palette[i];
+        }
+}
+static int imageTestColorCount(int PIXEL_COUNT)
+{
+        static uint16_t seen[DISPLAY_IMAGE_MAX_COLORS+1];
+        int count = 0;
+        for(int i=0;i<PIXEL_COUNT;i++)
+        {
+                int j = 0;
+                while((j<count)&&(seen[j]!=imageTestPixels[i]))
+                {
+                        j++;
+                }
+                if((j==count)&&(count<=DISPLAY_IMAGE_MAX_COLORS))
+                {
+                        seen[count++] = imageTestPixels[i];
+                }
+        }
+        return count;
+}
+static bool imageTestMatches(const uint8_t OUT[], int PIXEL, int PIXEL_COUNT)
+{
+        for(int i=0;i<PIXEL_COUNT;i++)
+        {
+                uint16_t expected = imageTestPixels[PIXEL+i];
+                if((OUT[i*2]!=(expected>>8))||(OUT[(i*2)+1]!=(expected&0xFF)))
+                {
+                        return false;
+                }
+        }
+        return true;
+}
+static void imageTestFail(const char *NAME, const char *WHAT, int PIXEL, int PIXEL_COUNT, int ALIGNMENT)
+{
+        printf("FAIL %s: %s, pixels %d to %d at alignment %d\n",NAME,WHAT,PIXEL,PIXEL+PIXEL_COUNT-1,ALIGNMENT);
+        imageTestFailures++;
+}
+//Decodes the image at ADDRESS whole, in random segments and at every
+//output alignment
+static void imageTestDecode(const char *NAME, int ADDRESS, int WIDTH, int HEIGHT)
+{
+        displayImageDecoder_t *decoder = displayImageOpen(ADDRESS);
+        int pixelCount = WIDTH*HEIGHT;
+
+        if(decoder==NULL)
+        {
+                imageTestFail(NAME,"won't open",0,0,0);
+                return;
+        }
+        for(int alignment=0;alignment<4;alignment++)
+        {
+                memset(imageTestOut,0xEE,sizeof(imageTestOut));
+                displayImageDecode(decoder,0,&imageTestOut[alignment],pixelCount);
+                if(!imageTestMatches(&imageTestOut[alignment],0,pixelCount))
+                {
+                        imageTestFail(NAME,"whole image",0,pixelCount,alignment);
+                        return;
+                }
+                if(imageTestOut[alignment+(pixelCount*2)]!=0xEE)
+                {
+                        imageTestFail(NAME,"wrote past the end",0,pixelCount,alignment);
+                        return;
+                }
+        }
+        for(int segment=0;segment<IMAGE_TEST_SEGMENTS;segment++)
+        {
+                int pixel = rand()%pixelCount;
+                int count = 1+(rand()%(((pixelCount-pixel)<(3*WIDTH))?(pixelCount-pixel):(3*WIDTH)));
+                int alignment = rand()%4;
+
+                decoder = displayImageOpen(ADDRESS);
+                displayImageDecode(decoder,pixel,&imageTestOut[alignment],count);
+                if(!imageTestMatches(&imageTestOut[alignment],pixel,count))
+                {
+                        imageTestFail(NAME,"segment",pixel,count,alignment);
+                        return;
+                }
+                //Sometimes straight on from the last one, like a band
+                if(((segment%3)==0)&&(pixel+count<pixelCount))
+                {
+                        int nextCount = ((pixelCount-pixel-count)<WIDTH)?(pixelCount-pixel-count):WIDTH;
+                        displayImageDecode(decoder,pixel+count,&imageTestOut[alignment],nextCount);
+                        if(!imageTestMatches(&imageTestOut[alignment],pixel+count,nextCount))
+                        {
+                                imageTestFail(NAME,"next segment",pixel+count,nextCount,alignment);
+                                return;
+                        }
+                }
+        }
+}
+static void imageTestStore(const uint8_t DATA[], int SIZE, int ADDRESS)
+{
+        memset(&hostFlashMemory()[ADDRESS],0xFF,SIZE+4);
+        memcpy(&hostFlashMemory()[ADDRESS],DATA,SIZE);
+        //The flash changed under any decoder still open
+        displayImageInvalidate();
+}
+
+int main(int ARGC, char *ARGV[])
+{
+        int checked = 0;
+
+        hostFlashFill(0xFF);
+        for(unsigned int size=0;size<sizeof(imageTestSizes)/sizeof(imageTestSizes[0]);size++)
+        {
+                const imageTestSize_t *image = &imageTestSizes[size];
+                int pixelCount = image->width*image->height;
+                char name[64];
+                int encodedSize = 0;
+                //Odd addresses too, images follow each other in a pack
+                int address = IMAGE_TEST_ADDRESS+(size*3);
+
+                imageTestPicture(image->width,image->height,image->colors,size+1);
+
+                encodedSize = hostImageEncodeRle(imageTestPixels,image->width,image->height,imageTestEncoded,sizeof(imageTestEncoded));
+                snprintf(name,sizeof(name),"%dx%d run length",image->width,image->height);
+                imageTestStore(imageTestEncoded,encodedSize,address);
+                if(!displayImageIsCompressed(address))
+                {
+                        imageTestFail(name,"isn't seen as compressed",0,0,0);
+                }
+                if(displayImageGetPalette(address,(uint16_t *)imageTestOut,DISPLAY_IMAGE_MAX_COLORS)!=0)
+                {
+                        imageTestFail(name,"has a palette",0,0,0);
+                }
+                imageTestDecode(name,address,image->width,image->height);
+                checked++;
+
+                for(int bitsPerPixel=2;bitsPerPixel<=8;bitsPerPixel*=2)
+                {
+                        uint16_t palette[DISPLAY_IMAGE_MAX_COLORS];
+                        int colorCount = imageTestColorCount(pixelCount);
+                        int paletteCount = 0;
+
+                        encodedSize = hostImageEncodeIndexed(imageTestPixels,image->width,image->height,bitsPerPixel,imageTestEncoded,sizeof(imageTestEncoded));
+                        if(encodedSize<0)
+                        {
+                                continue;
+                        }
+                        snprintf(name,sizeof(name),"%dx%d %d bpp",image->width,image->height,bitsPerPixel);
+                        imageTestStore(imageTestEncoded,encodedSize,address);
+                        paletteCount = displayImageGetPalette(address,palette,DISPLAY_IMAGE_MAX_COLORS);
+                        if(paletteCount!=colorCount)
+                        {
+                                printf("FAIL %s: palette of %d colors, the image has %d\n",name,paletteCount,colorCount);
+                                imageTestFailures++;
+                        }
+                        if((colorCount>1)&&(displayImageGetPalette(address,palette,1)!=1))
+                        {
+                                imageTestFail(name,"palette isn't capped",0,0,0);
+                        }
+                        imageTestDecode(name,address,image->width,image->height);
+                        checked++;
+                }
+        }
+
+        //A theme palette recolors indexed images, NULL puts them back
+        {
+                static const uint16_t theme[4] = {0x1111,0x2222,0x3333,0x4444};
+                uint16_t palette[4];
+                displayImageDecoder_t *decoder;
+                int encodedSize = 0;
+
+                imageTestPicture(20,10,4,99);
+                encodedSize = hostImageEncodeIndexed(imageTestPixels,20,10,2,imageTestEncoded,sizeof(imageTestEncoded));
+                imageTestStore(imageTestEncoded,encodedSize,IMAGE_TEST_ADDRESS);
+                displayImageGetPalette(IMAGE_TEST_ADDRESS,palette,4);
+                displayImageSetPalette(theme,4);
+                decoder = displayImageOpen(IMAGE_TEST_ADDRESS);
+                displayImageDecode(decoder,0,imageTestOut,200);
+                for(int i=0;i<200;i++)
+                {
+                        int index = 0;
+                        while(palette[index]!=imageTestPixels[i])
+                        {
+                                index++;
+                        }
+                        imageTestPixels[i] = theme[index];
+                }
+                if(!imageTestMatches(imageTestOut,0,200))
+                {
+                        imageTestFail("theme","colors aren't the theme's",0,200,0);
+                }
+                displayImageSetPalette(NULL,0);
+                imageTestPicture(20,10,4,99);
+                displayImageDecode(decoder,0,imageTestOut,200);
+                if(!imageTestMatches(imageTestOut,0,200))
+                {
+                        imageTestFail("theme","own colors don't come back",0,200,0);
+                }
+        }
+
+        printf("images:       %d decoded whole, in %d segments each and at 4 alignments\n",checked,IMAGE_TEST_SEGMENTS);
+        if(imageTestFailures>0)
+        {
+                printf("%d checks failed\n",imageTestFailures);
+                return 1;
+        }
+        return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * listFrame.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * A scene drawn over the face straight to the panel and again through
+ * the display list. Both have to come out the same, as does the frame
+ * displayListRenderTo composites in RAM, and a list that overflows.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "sdkHost.h"
+#include "hostMocks.h"
+#include "hostPack.h"
+#include "displayDriver.h"
+#include "displayList.h"
+#include "displayPolygon.h"
+#include "watchAnimations.h"
+#include "imageOffsets.h"
+
+//Enough small rects to fill the list more than once
+#define LIST_FRAME_OVERFLOW_RECTS 150
+
+static uint16_t listFrameDirect[HOST_SCREEN_WIDTH*HOST_SCREEN_HEIGHT];
+static uint16_t listFrameRam[HOST_SCREEN_WIDTH*HOST_SCREEN_HEIGHT];
+static int listFrameFailures = 0;
+
+static void listFrameScene(void)
+{
+        //An arrow, concave at the back
+        static const displayPoint_t arrow[] =
+        {
+                {DISPLAY_PIXEL_CENTER(150),DISPLAY_PIXEL_CENTER(170)},
+                {DISPLAY_PIXEL_CENTER(220),DISPLAY_PIXEL_CENTER(200)},
+                {DISPLAY_PIXEL_CENTER(150),DISPLAY_PIXEL_CENTER(230)},
+                {DISPLAY_PIXEL_CENTER(170),DISPLAY_PIXEL_CENTER(200)},
+        };
+        displayDrawRectangle(40,199,60,99,DISPLAY_BLUE);
+        displayDrawLine(0,239,239,0,DISPLAY_WHITE);
+        displayDrawLineThickness(30,210,200,40,DISPLAY_YELLOW,7);
+        displayDrawCircle(120,120,80,DISPLAY_MAGENTA);
+        displayFillPolygon(arrow,sizeof(arrow)/sizeof(arrow[0]),DISPLAY_GREEN);
+        displayDrawWatchHand(90,300,DISPLAY_RED);
+        displayDrawPixel(5,120,DISPLAY_WHITE);
+        displayPartialImageFromAsset(20,150,100,20,40,40,WATCH_FACE_ASSET);
+}
+static void listFrameOverflowScene(void)
+{
+        for(int i=0;i<LIST_FRAME_OVERFLOW_RECTS;i++)
+        {
+                int x = (i*37)%220;
+                int y = (i*53)%220;
+                displayDrawRectangle(x,x+19,y,y+19,(i*0x1111)&0xFFFF);
+        }
+}
+static void listFrameToRam(const displayRect_t *BAND, const uint8_t *PIXELS, int SIZE, void *USER_DATA)
+{
+        uint16_t *frame = USER_DATA;
+        int width = BAND->xEnd-BAND->xStart+1;
+        for(int i=0;i<SIZE/BYTES_PER_PIXEL;i++)
+        {
+                int x = BAND->xStart+(i%width);
+                int y = BAND->yStart+(i/width);
+                frame[(y*HOST_SCREEN_WIDTH)+x] = (PIXELS[i*2]<<8)|PIXELS[(i*2)+1];
+        }
+}
+static void listFrameCompare(const char *NAME, const uint16_t EXPECTED[])
+{
+        int differences = hostPanelCompare(EXPECTED);
+        if(differences>0)
+        {
+                printf("FAIL %s: %d pixels differ\n",NAME,differences);
+                listFrameFailures++;
+        }
+}
+static void listFrameTraffic(const char *NAME)
+{
+        hostSpiStats_t stats;
+        hostSpiGetStats(&stats);
+        printf("%-18s %7u bytes in %5u writes, %5u commands\n",NAME,stats.bytes,stats.writes+stats.asyncWrites,stats.commandBytes);
+}
+//Draws SCENE straight to the panel and then through the list, both
+//over the face, and checks they match
+static void listFrameRun(const char *NAME, void (*SCENE)(void))
+{
+        displayListStats_t stats;
+        char label[32];
+
+        displayImageFromAsset(0,0,WATCH_FACE_ASSET);
+        hostSpiResetStats();
+        SCENE();
+        snprintf(label,sizeof(label),"%s, direct",NAME);
+        listFrameTraffic(label);
+        hostPanelCopy(listFrameDirect);
+
+        hostPanelClear(DISPLAY_BLACK);
+        displayImageFromAsset(0,0,WATCH_FACE_ASSET);
+        hostPanelCopy(listFrameRam);
+        displayListResetStats();
+        hostSpiResetStats();
+        displayListBeginOverImage(WATCH_FACE_ASSET);
+        SCENE();
+        displayListRenderTo(listFrameToRam,listFrameRam);
+        displayListEnd();
+        snprintf(label,sizeof(label),"%s, list",NAME);
+        listFrameTraffic(label);
+        displayListGetStats(&stats);
+        printf("%-18s %7u items, %u overflows, %u bands\n","",stats.itemsRecorded,stats.overflows,stats.bandsRendered);
+        listFrameCompare(label,listFrameDirect);
+        if(stats.overflows==0)
+        {
+                snprintf(label,sizeof(label),"%s, RAM frame",NAME);
+                if(memcmp(listFrameRam,listFrameDirect,sizeof(listFrameRam))!=0)
+                {
+                        printf("FAIL %s doesn't match\n",label);
+                        listFrameFailures++;
+                }
+        }
+}
+
+int main(int ARGC, char *ARGV[])
+{
+        displayListStats_t stats;
+
+        hostFlashFill(0xFF);
+        if(!hostPackInstallFace(0,0))
+        {
+                printf("FAIL can't install the face\n");
+                return 1;
+        }
+        displayInit();
+
+        listFrameRun("scene",listFrameScene);
+        hostScreenSavePpm("listFrame.ppm",listFrameRam);
+        listFrameRun("overflow",listFrameOverflowScene);
+        displayListGetStats(&stats);
+        if(stats.overflows==0)
+        {
+                printf("FAIL %d rects didn't overflow the list\n",LIST_FRAME_OVERFLOW_RECTS);
+                listFrameFailures++;
+        }
+        if(listFrameFailures>0)
+        {
+                printf("%d checks failed\n",listFrameFailures);
+                return 1;
+        }
+        printf("RAM frame in listFrame.ppm\n");
+        return 0;
+}
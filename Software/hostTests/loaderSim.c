@@ -0,0 +1,227 @@
+/*
+ * loaderSim.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * storeInFlash_task on the host with its UART on a pty, so assetLoader
+ * can talk to it like it would to the watch. The flash is the NVMS mock
+ * with page and sector times, and a stand in display task picks up each
+ * new pack. Every pack that loads is reported on stdout and the flash
+ * is saved to $OUT.
+ *
+ *   loaderSim <file to write the pty name to>
+ *
+ * FLASHIN=<image> starts from a saved flash, FAILWRITE=<n> makes write
+ * n program wrong, CORRUPT=<n> flips received byte n and RELOAD_MS=<ms>
+ * is how long the display takes to move to a new pack.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "sdkHost.h"
+#include "hostMocks.h"
+#include "displayAssets.h"
+#include "miniDB.h"
+#include "imageOffsets.h"
+
+#define LOADER_SIM_SOF 0xA5
+#define LOADER_SIM_NAK 0x81
+//Times of the NOR part on the watch, near enough
+#define LOADER_SIM_WRITE_US 300
+#define LOADER_SIM_ERASE_US 3000
+//How often a read that is waiting looks in on the display task
+#define LOADER_SIM_POLL_MS 10
+
+const uart_device_config dev_SERIAL2 = {0,{HW_UART_BAUDRATE_115200}};
+
+static int loaderSimPort = -1;
+static long loaderSimReceived = 0;
+static long loaderSimCorruptAt = -1;
+static int loaderSimReloadMs = 0;
+static bool loaderSimIsReloading = false;
+static double loaderSimReloadAt = 0;
+static int loaderSimLoads = 0;
+static uint32_t loaderSimNaks = 0;
+
+static double loaderSimSeconds(void)
+{
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC,&now);
+        return now.tv_sec+(now.tv_nsec/1e9);
+}
+static void loaderSimReport(void)
+{
+        hostFlashStats_t stats;
+        const char *out = getenv("OUT");
+
+        hostFlashGetStats(&stats);
+        printf("load %d: bank %d at 0x%X, directory %s, face %s, %u writes, %u erases, %u across a page, %u NAKs\n",
+               ++loaderSimLoads,displayAssetActiveBank(),displayAssetBankAddress(displayAssetActiveBank()),
+               displayAssetsLoaded()?"loaded":"not loaded",displayAssetVerify(WATCH_FACE_ASSET)?"verifies":"doesn't verify",
+               stats.writes,stats.erases,stats.pageCrossings,loaderSimNaks);
+        fflush(stdout);
+        if((out!=NULL)&&!hostFlashSave(out,HOST_FLASH_SIZE))
+        {
+                perror(out);
+        }
+        hostFlashResetStats();
+        loaderSimNaks = 0;
+}
+//The display task, moving to the new bank between frames
+static void loaderSimDisplayTask(void)
+{
+        if(loaderSimIsReloading&&(loaderSimSeconds()>=loaderSimReloadAt))
+        {
+                loaderSimIsReloading = false;
+                displayAssetsLoad();
+                setAssetsReloadPending(false);
+                loaderSimReport();
+        }
+}
+int hostTaskNotify(TaskHandle_t TASK, uint32_t VALUE)
+{
+        if((VALUE&DISPLAY_ASSETS_CHANGED_MASK)!=0)
+        {
+                loaderSimIsReloading = true;
+                loaderSimReloadAt = loaderSimSeconds()+(loaderSimReloadMs/1000.0);
+        }
+        return OS_OK;
+}
+//Nothing is open on the loader's side of the link
+void displayImageInvalidate(void)
+{
+}
+
+void ad_uart_init(void)
+{
+}
+uart_device ad_uart_open(const void *DEVICE)
+{
+        return (uart_device)1;
+}
+void ad_uart_close(uart_device DEVICE)
+{
+}
+int ad_uart_read(uart_device DEVICE, char *BUF, size_t LEN, OS_TICK_TIME TIMEOUT)
+{
+        struct pollfd port = {loaderSimPort,POLLIN,0};
+        double deadline = loaderSimSeconds()+(TIMEOUT/1000.0);
+        size_t received = 0;
+
+        while(received<LEN)
+        {
+                ssize_t count = 0;
+                loaderSimDisplayTask();
+                if(poll(&port,1,LOADER_SIM_POLL_MS)<=0)
+                {
+                        if(loaderSimSeconds()>=deadline)
+                        {
+                                break;
+                        }
+                        continue;
+                }
+                count = read(loaderSimPort,&BUF[received],LEN-received);
+                if(count<=0)
+                {
+                        //No sender has the other end open, it times out the same
+                        if(loaderSimSeconds()>=deadline)
+                        {
+                                break;
+                        }
+                        usleep(LOADER_SIM_POLL_MS*1000);
+                        continue;
+                }
+                for(ssize_t i=0;i<count;i++,loaderSimReceived++)
+                {
+                        if(loaderSimReceived==loaderSimCorruptAt)
+                        {
+                                BUF[received+i] ^= 0x55;
+                        }
+                }
+                received += count;
+                deadline = loaderSimSeconds()+(TIMEOUT/1000.0);
+        }
+        return received;
+}
+void ad_uart_write(uart_device DEVICE, const char *BUF, size_t LEN)
+{
+        //Replies go out whole, so the type is always the second byte
+        if((LEN>=2)&&((uint8_t)BUF[0]==LOADER_SIM_SOF)&&((uint8_t)BUF[1]==LOADER_SIM_NAK))
+        {
+                loaderSimNaks++;
+                if(getAssetsReloadPending())
+                {
+                        printf("NAK while the display moves to the new pack\n");
+                        fflush(stdout);
+                }
+        }
+        if(write(loaderSimPort,BUF,LEN)!=(ssize_t)LEN)
+        {
+                perror("pty");
+        }
+}
+
+void storeInFlash_task(void *params);
+
+int main(int ARGC, char *ARGV[])
+{
+        struct termios settings;
+        FILE *name = NULL;
+
+        if(ARGC!=2)
+        {
+                fprintf(stderr,"usage: %s <pty name file>\n",ARGV[0]);
+                return 2;
+        }
+        hostFlashFill(0xFF);
+        if((getenv("FLASHIN")!=NULL)&&!hostFlashLoad(getenv("FLASHIN")))
+        {
+                perror(getenv("FLASHIN"));
+                return 1;
+        }
+        hostFlashSetTiming(LOADER_SIM_WRITE_US,LOADER_SIM_ERASE_US);
+        if(getenv("FAILWRITE")!=NULL)
+        {
+                hostFlashFailWrite(atoi(getenv("FAILWRITE")));
+        }
+        if(getenv("CORRUPT")!=NULL)
+        {
+                loaderSimCorruptAt = atol(getenv("CORRUPT"));
+        }
+        if(getenv("RELOAD_MS")!=NULL)
+        {
+                loaderSimReloadMs = atoi(getenv("RELOAD_MS"));
+        }
+        //Whatever was active before is what the display starts on
+        displayAssetsLoad();
+        setDisplayTaskHandle((TaskHandle_t)1);
+
+        loaderSimPort = posix_openpt(O_RDWR|O_NOCTTY);
+        if((loaderSimPort<0)||(grantpt(loaderSimPort)!=0)||(unlockpt(loaderSimPort)!=0))
+        {
+                perror("pty");
+                return 1;
+        }
+        tcgetattr(loaderSimPort,&settings);
+        cfmakeraw(&settings);
+        tcsetattr(loaderSimPort,TCSANOW,&settings);
+        //Written last, the test starts the sender as soon as it appears
+        name = fopen(ARGV[1],"w");
+        if(name==NULL)
+        {
+                perror(ARGV[1]);
+                return 1;
+        }
+        fprintf(name,"%s\n",ptsname(loaderSimPort));
+        fclose(name);
+
+        storeInFlash_task(NULL);
+        return 0;
+}
@@ -0,0 +1,109 @@
+#!/bin/bash
+#Runs assetLoader against loaderSim over a pty: a full load, a frame
+#corrupted on the way, a page that programs wrong, a delta load into
+#the other bank, a sender killed part way that resumes and a load that
+#has to wait for the display to let go of the old bank.
+#  loaderTest.sh <build directory>
+
+BUILD=${1:-build}
+cd "$BUILD" || exit 1
+failures=0
+simulator=
+
+fail()
+{
+	echo "FAIL $*"
+	failures=$((failures+1))
+}
+#Starts the simulator with the environment given and waits for its pty
+startSim()
+{
+	rm -f pty sim.log
+	env "$@" ./loaderSim pty > sim.log 2>&1 &
+	simulator=$!
+	for wait in $(seq 50); do
+		grep -q . pty 2>/dev/null && return 0
+		sleep 0.1
+	done
+	fail "the simulator didn't start"
+	return 1
+}
+stopSim()
+{
+	kill $simulator 2>/dev/null
+	wait $simulator 2>/dev/null
+}
+send()
+{
+	timeout 120 ./assetLoader "$(cat pty)" "$@" > sender.log 2>&1
+}
+#Waits for the simulator to report load number $1
+waitLoad()
+{
+	for wait in $(seq 100); do
+		grep -q "^load $1:" sim.log && return 0
+		sleep 0.1
+	done
+	fail "load $1 wasn't reported"
+	return 1
+}
+#Checks load $1 went into bank $2 and that the bank in $4 holds pack $3
+checkLoad()
+{
+	line=$(grep "^load $1:" sim.log)
+	address=$(echo "$line" | sed -n 's/.* at 0x\([0-9A-F]*\),.*/\1/p')
+	echo "   $line"
+	echo "$line" | grep -q "bank $2 at" || fail "load $1 isn't in bank $2"
+	echo "$line" | grep -q "directory loaded, face verifies" || fail "load $1 didn't load"
+	echo "$line" | grep -q " 0 across a page" || fail "load $1 wrote across a page"
+	cmp -s -n "$(stat -c %s "$3")" "$3" "$4" 0 $((16#${address:-0})) || fail "bank $2 doesn't hold $3"
+}
+
+./makeTestPack packA.bin packB.bin > /dev/null || exit 1
+sectors=$((($(stat -c %s packA.bin)+4095)/4096))
+
+echo "full load of $sectors sectors"
+startSim OUT=flashA.bin && send packA.bin --full && waitLoad 1 && checkLoad 1 0 packA.bin flashA.bin
+bank0=$address
+#And the first record sector, blank flash has never had one
+grep -q "^load 1:.* $((sectors+1)) erases" sim.log || fail "a full load didn't erase each sector once"
+stopSim
+
+echo "a corrupted frame"
+startSim OUT=flash.bin CORRUPT=20000 && send packA.bin --full && waitLoad 1 && checkLoad 1 0 packA.bin flash.bin
+grep -q "^load 1:.* 0 NAKs" sim.log && fail "the corrupted frame wasn't NAKed"
+stopSim
+
+echo "a page that programs wrong"
+startSim OUT=flash.bin FAILWRITE=500 && send packA.bin --full && waitLoad 1 && checkLoad 1 0 packA.bin flash.bin
+grep -q "^load 1:.* $((sectors+2)) erases" sim.log || fail "the bad sector wasn't erased and written again"
+stopSim
+
+echo "delta load of B over A, and back to A"
+startSim OUT=flash.bin FLASHIN=flashA.bin && send packB.bin && waitLoad 1 && checkLoad 1 1 packB.bin flash.bin
+echo "   $(grep "sectors changed" sender.log)"
+grep -q "^3 of $sectors sectors changed" sender.log || fail "the delta load didn't send just the 3 changed sectors"
+cmp -s -n "$(stat -c %s packA.bin)" packA.bin flash.bin 0 $((16#$bank0)) || fail "the delta load touched the active bank"
+#Bank 0 still holds A apart from what B changed, only that is rewritten
+send packA.bin && waitLoad 2 && checkLoad 2 0 packA.bin flash.bin
+grep -q "^load 2:.* 3 erases" sim.log || fail "going back to A rewrote more than the 3 changed sectors"
+stopSim
+
+echo "a sender killed part way, then run again"
+startSim OUT=flash.bin
+timeout 0.5 ./assetLoader "$(cat pty)" packA.bin --full > /dev/null
+send packA.bin --full && waitLoad 1 && checkLoad 1 0 packA.bin flash.bin
+resumed=$(sed -n 's/.*Watch has \([0-9]*\) of.*/\1/p' sender.log | head -1)
+echo "   resumed at ${resumed:-nothing}"
+[ "${resumed:-0}" -gt 0 ] || fail "the second run didn't resume"
+stopSim
+
+echo "a load while the display is still moving to the last one"
+startSim OUT=flash.bin RELOAD_MS=2500 && send packA.bin --full && send packB.bin && waitLoad 2 && checkLoad 2 1 packB.bin flash.bin
+busy=$(grep -c "NAK while the display" sim.log)
+echo "   $busy HELLOs refused until the display moved"
+[ "$busy" -gt 0 ] || fail "a HELLO was taken while the display was on the bank"
+stopSim
+
+rm -f pty sim.log sender.log flash.bin
+[ $failures -eq 0 ] || { echo "$failures checks failed"; exit 1; }
@@ -0,0 +1,93 @@
+/*
+ * makeTestPack.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Writes two asset packs for the loader tests. The first is the face,
+ * three icons and five photos that don't compress, about 600 KB so a
+ * load takes well over a hundred sectors. The second is the same pack
+ * with one marker of the face and a few pixels of one photo changed,
+ * so a delta load has only a handful of sectors to send.
+ *
+ *   makeTestPack packA.bin packB.bin
+ */
+
+#include <stdio.h>
+#include "sdkHost.h"
+#include "hostMocks.h"
+#include "hostPack.h"
+
+#define TEST_PACK_PHOTOS 5
+#define TEST_PACK_ICONS 3
+#define TEST_PACK_ICON_SIZE 48
+
+static const char *testPackPhotos[TEST_PACK_PHOTOS] = {"MARISSA","TZIPI","PHOTO_1","PHOTO_2","PHOTO_3"};
+static const char *testPackIcons[TEST_PACK_ICONS] = {"NEW_MESSAGE","NEW_MAIL","HOME"};
+
+static uint16_t testPackPixels[240*240];
+
+//Noise, so the photo is stored raw like a real one would be
+static void testPackPhoto(int SEED)
+{
+        uint32_t state = 0x12345678+(SEED*0x9E3779B9);
+        for(int i=0;i<240*240;i++)
+        {
+                state = (state*1103515245)+12345;
+                testPackPixels[i] = state>>16;
+        }
+}
+static bool testPackWrite(const char *PATH, int VARIANT)
+{
+        hostPack_t pack;
+        bool isWritten = false;
+
+        if(!hostPackBegin(&pack,1+TEST_PACK_ICONS+TEST_PACK_PHOTOS))
+        {
+                return false;
+        }
+        hostTestFace(testPackPixels,VARIANT);
+        isWritten = hostPackAddImage(&pack,"WATCH_FACE",testPackPixels,240,240);
+        for(int i=0;i<TEST_PACK_ICONS;i++)
+        {
+                hostTestIcon(testPackPixels,TEST_PACK_ICON_SIZE,TEST_PACK_ICON_SIZE,i);
+                isWritten = isWritten&&hostPackAddImage(&pack,testPackIcons[i],testPackPixels,TEST_PACK_ICON_SIZE,TEST_PACK_ICON_SIZE);
+        }
+        for(int i=0;i<TEST_PACK_PHOTOS;i++)
+        {
+                testPackPhoto(i);
+                //A few pixels near the end of the third photo
+                if((VARIANT>0)&&(i==2))
+                {
+                        for(int pixel=0;pixel<8;pixel++)
+                        {
+                                testPackPixels[(200*240)+(pixel*7)] ^= 0xFFFF;
+                        }
+                }
+                isWritten = isWritten&&hostPackAddImage(&pack,testPackPhotos[i],testPackPixels,240,240);
+        }
+        if(isWritten)
+        {
+                hostPackEnd(&pack);
+                isWritten = hostPackSave(&pack,PATH);
+                printf("%s: %u bytes, %u sectors, CRC %08X\n",PATH,pack.size,(pack.size+HOST_FLASH_SECTOR_SIZE-1)/HOST_FLASH_SECTOR_SIZE,
+                       hostPackCrc(&pack));
+        }
+        hostPackFree(&pack);
+        return isWritten;
+}
+
+int main(int ARGC, char *ARGV[])
+{
+        if(ARGC!=3)
+        {
+                fprintf(stderr,"usage: %s <pack A> <pack B>\n",ARGV[0]);
+                return 2;
+        }
+        if(!testPackWrite(ARGV[1],0)||!testPackWrite(ARGV[2],3))
+        {
+                fprintf(stderr,"can't write the packs\n");
+                return 1;
+        }
+        return 0;
+}
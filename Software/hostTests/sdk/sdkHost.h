@@ -0,0 +1,116 @@
+/*
+ * sdkHost.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * Just enough of the DA1468x SDK for the display and loader sources to
+ * build on a PC. Every SDK header the firmware includes is a stub in
+ * this folder that pulls this one in, the adapters behind it are the
+ * mocks in hostSpi.c, hostFlash.c and hostOsal.c.
+ */
+
+#ifndef SDKHOST_H_
+#define SDKHOST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+
+//Devices, the mocks only have one of each
+typedef void *spi_device;
+typedef void *nvms_t;
+typedef void *uart_device;
+typedef int HW_SPI_ID;
+#define DISPLAY_SPI 0
+#define NVMS_FLASH_STORAGE 1
+
+//GPIO
+#define HW_GPIO_PORT_4 4
+#define HW_GPIO_PIN_7 7
+void hw_gpio_set_active(int PORT, int PIN);
+void hw_gpio_set_inactive(int PORT, int PIN);
+
+//OS. Time is virtual, a delay moves the clock on without waiting.
+//Writes finish before they return, so events never have to be waited for
+typedef void *OS_TASK;
+typedef void *TaskHandle_t;
+typedef void *OS_EVENT;
+typedef void *OS_MUTEX;
+typedef uint32_t OS_TICK_TIME;
+typedef int OS_BASE_TYPE;
+#define OS_OK 0
+#define OS_MS_2_TICKS(MS) (MS)
+#define OS_TICKS_2_MS(TICKS) (TICKS)
+#define OS_DELAY_MS(MS) hostDelayMs(MS)
+#define OS_GET_TICK_COUNT() hostTickCount()
+#define OS_GET_CURRENT_TASK() ((OS_TASK)0)
+#define OS_EVENT_CREATE(EVENT) ((EVENT) = (OS_EVENT)1)
+#define OS_EVENT_WAIT(EVENT,TIMEOUT) ((void)0)
+#define OS_EVENT_SIGNAL(EVENT) ((void)0)
+#define OS_EVENT_SIGNAL_FROM_ISR(EVENT) ((void)0)
+#define OS_EVENT_FOREVER 0
+#define OS_TASK_NOTIFY(TASK,VALUE,ACTION) hostTaskNotify((TASK),(VALUE))
+#define OS_TASK_NOTIFY_WAIT(CLEAR_ENTRY,CLEAR_EXIT,VALUE,TIMEOUT) OS_OK
+#define OS_TASK_NOTIFY_ALL_BITS 0xFFFFFFFF
+#define OS_TASK_NOTIFY_FOREVER 0
+#define OS_TASK_NOTIFY_NO_WAIT 0
+#define OS_NOTIFY_SET_BITS 0
+#define OS_ASSERT(CONDITION)
+#define OS_MALLOC malloc
+#define OS_FREE free
+void hostDelayMs(uint32_t MS);
+uint32_t hostTickCount(void);
+int hostTaskNotify(TaskHandle_t TASK, uint32_t VALUE);
+
+//SPI adapter, the D/C line of the panel is the 9th bit
+typedef void (*ad_spi_user_cb)(void *user_data, uint16_t transferred);
+void ad_spi_init(void);
+spi_device ad_spi_open(int DEVICE);
+void ad_spi_close(spi_device DEVICE);
+void ad_spi_write(spi_device DEVICE, const uint8_t *WBUF, size_t WLEN);
+void ad_spi_write_async(spi_device DEVICE, const uint8_t *WBUF, size_t WLEN, ad_spi_user_cb CB, void *USER_DATA);
+HW_SPI_ID ad_spi_get_hw_spi_id(spi_device DEVICE);
+void hw_spi_set_9th_bit(HW_SPI_ID ID, int VALUE);
+
+//NVMS adapter
+void ad_nvms_init(void);
+nvms_t ad_nvms_open(int PARTITION);
+int ad_nvms_read(nvms_t HANDLE, uint32_t ADDRESS, uint8_t *BUF, uint32_t LEN);
+int ad_nvms_write(nvms_t HANDLE, uint32_t ADDRESS, const uint8_t *BUF, uint32_t SIZE);
+bool ad_nvms_erase_region(nvms_t HANDLE, uint32_t ADDRESS, size_t SIZE);
+size_t ad_nvms_get_size(nvms_t HANDLE);
+
+//UART adapter
+typedef enum
+{
+        HW_UART_BAUDRATE_1000000,
+        HW_UART_BAUDRATE_921600,
+        HW_UART_BAUDRATE_500000,
+        HW_UART_BAUDRATE_230400,
+        HW_UART_BAUDRATE_115200
+} HW_UART_BAUDRATE;
+typedef struct
+{
+        HW_UART_BAUDRATE baud_rate;
+} uart_config_ex;
+typedef struct
+{
+        int bus_id;
+        uart_config_ex hw_init;
+} uart_device_config;
+extern const uart_device_config dev_SERIAL2;
+#define SERIAL2 ((const void *)&dev_SERIAL2)
+void ad_uart_init(void);
+uart_device ad_uart_open(const void *DEVICE);
+void ad_uart_close(uart_device DEVICE);
+int ad_uart_read(uart_device DEVICE, char *BUF, size_t LEN, OS_TICK_TIME TIMEOUT);
+void ad_uart_write(uart_device DEVICE, const char *BUF, size_t LEN);
+
+#endif /* SDKHOST_H_ */
@@ -0,0 +1,2 @@
+//Stands in for the SDK header on the host, see sdkHost.h
+#include "../sdkHost.h"
@@ -0,0 +1,130 @@
+/*
+ * trigBench.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ *
+ * fixedMath against libm: the largest error of the sine table, how far
+ * polar end points move from the old float code, and the time per call
+ * of each. The host has an FPU, so the float times here are far better
+ * than soft float on the M0 and the gap on the watch is much wider.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "sdkHost.h"
+#include "fixedMath.h"
+
+#define TRIG_BENCH_CALLS 10000000
+//What the table is allowed to be off by, a little over half a Q15 step
+#define TRIG_BENCH_MAX_ERROR 2.0e-5
+
+static volatile int32_t trigBenchSink;
+
+static double trigBenchSeconds(void)
+{
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC,&now);
+        return now.tv_sec+(now.tv_nsec/1e9);
+}
+//The end point math the drawing code had before fixedMath
+static void trigBenchFloatPolar(int CENTER_X, int CENTER_Y, int RADIUS, int ANGLE, int *X, int *Y)
+{
+        float newAngle = 3.1416*ANGLE/180;
+        *X = CENTER_X+RADIUS*cos(newAngle);
+        *Y = CENTER_Y+RADIUS*sin(newAngle);
+}
+
+int main(int ARGC, char *ARGV[])
+{
+        double maxError = 0;
+        int worstAngle = 0;
+        int movedPoints = 0;
+        int maxMove = 0;
+        double start = 0;
+        double fixedNs = 0;
+        double floatNs = 0;
+        double polarFixedNs = 0;
+        double polarFloatNs = 0;
+
+        //Every tenth of a degree from -360 to 720
+        for(int angle=FIXED_DEGREES(-360);angle<=FIXED_DEGREES(720);angle++)
+        {
+                double radians = angle*M_PI/1800.0;
+                double sinError = fabs((fixedSin(angle)/(double)FIXED_Q15_ONE)-sin(radians));
+                double cosError = fabs((fixedCos(angle)/(double)FIXED_Q15_ONE)-cos(radians));
+                if((sinError>maxError)||(cosError>maxError))
+                {
+                        maxError = (sinError>cosError)?sinError:cosError;
+                        worstAngle = angle;
+                }
+        }
+        printf("largest error:    %.2e at %d.%d degrees\n",maxError,worstAngle/10,abs(worstAngle%10));
+
+        //End points of a radius 100 hand, whole degrees like the callers
+        for(int angle=0;angle<360;angle++)
+        {
+                int fixedX = 0;
+                int fixedY = 0;
+                int floatX = 0;
+                int floatY = 0;
+                fixedPolarToCartesian(120,120,100,FIXED_DEGREES(angle),&fixedX,&fixedY);
+                trigBenchFloatPolar(120,120,100,angle,&floatX,&floatY);
+                if((fixedX!=floatX)||(fixedY!=floatY))
+                {
+                        int move = abs(fixedX-floatX)>abs(fixedY-floatY)?abs(fixedX-floatX):abs(fixedY-floatY);
+                        movedPoints++;
+                        maxMove = (move>maxMove)?move:maxMove;
+                }
+        }
+        printf("end points moved: %d of 360, by %d pixel at most\n",movedPoints,maxMove);
+
+        start = trigBenchSeconds();
+        for(int i=0;i<TRIG_BENCH_CALLS;i++)
+        {
+                trigBenchSink = fixedCos(i%FIXED_FULL_TURN);
+        }
+        fixedNs = (trigBenchSeconds()-start)*1e9/TRIG_BENCH_CALLS;
+        start = trigBenchSeconds();
+        for(int i=0;i<TRIG_BENCH_CALLS;i++)
+        {
+                float newAngle = 3.1416*(i%360)/180;
+                trigBenchSink = cos(newAngle)*FIXED_Q15_ONE;
+        }
+        floatNs = (trigBenchSeconds()-start)*1e9/TRIG_BENCH_CALLS;
+        printf("cos:              %.1f ns fixed, %.1f ns float\n",fixedNs,floatNs);
+
+        start = trigBenchSeconds();
+        for(int i=0;i<TRIG_BENCH_CALLS;i++)
+        {
+                int x = 0;
+                int y = 0;
+                fixedPolarToCartesian(120,120,100,FIXED_DEGREES(i%360),&x,&y);
+                trigBenchSink = x+y;
+        }
+        polarFixedNs = (trigBenchSeconds()-start)*1e9/TRIG_BENCH_CALLS;
+        start = trigBenchSeconds();
+        for(int i=0;i<TRIG_BENCH_CALLS;i++)
+        {
+                int x = 0;
+                int y = 0;
+                trigBenchFloatPolar(120,120,100,i%360,&x,&y);
+                trigBenchSink = x+y;
+        }
+        polarFloatNs = (trigBenchSeconds()-start)*1e9/TRIG_BENCH_CALLS;
+        printf("polar end point:  %.1f ns fixed, %.1f ns float\n",polarFixedNs,polarFloatNs);
+
+        if(maxError>TRIG_BENCH_MAX_ERROR)
+        {
+                printf("FAIL the table is off by more than %.1e\n",TRIG_BENCH_MAX_ERROR);
+                return 1;
+        }
+        if(maxMove>1)
+        {
+                printf("FAIL end points moved by more than a pixel\n");
+                return 1;
+        }
+        return 0;
+}
@@ -130,6 +130,16 @@
 #define dg_configUART_ADAPTER                   0
 #endif
 
+/**************************************************************************************************\
+* Display blits are sent by DMA straight from the memory mapped flash,
+* except while the loader may be erasing and programming it under them
+*/
+#if LOAD_NEW_IMAGES
+#define DISPLAY_XIP_BLITS                       0
+#else
+#define DISPLAY_XIP_BLITS                       1
+#endif
+
 
 /* Include bsp default values */
 #include "bsp_defaults.h"
@@ -0,0 +1,324 @@
+/*
+ * displayAssets.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stddef.h>
+#include "ad_nvms.h"
+#include "displayAssets.h"
+
+//The directory is read once, after that an asset is found by hashing
+//its ID into the index, which holds its position in the directory plus
+//one so 0 is an empty slot
+static displayAssetHeader_t displayAssetHeader;
+static displayAsset_t displayAssetDirectory[DISPLAY_ASSET_MAX_ASSETS];
+static uint8_t displayAssetIndex[DISPLAY_ASSET_INDEX_SLOTS];
+static bool displayAssetIsLoaded = false;
+//Start of the bank the directory was read from, entries are relative to it
+static int displayAssetBankBase = DISPLAY_ASSET_BANK_ADDRESS;
+static displayAssetStats_t displayAssetStats = {0};
+
+//FNV-1a, the packer hashes the asset names the same way
+uint32_t displayAssetHash(const char *NAME)
+{
+        uint32_t hash = 2166136261u;
+        while(*NAME)
+        {
+                hash = (hash^(uint8_t)*NAME++)*16777619u;
+        }
+        return hash;
+}
+//Reflected CRC32 of every byte value, const so it stays in flash
+static const uint32_t displayAssetCrcTable[256] =
+{
+        0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F,
+        0xE963A535, 0x9E6495A3, 0x0EDB8832, 0x79DCB8A4, 0xE0D5E91E, 0x97D2D988,
+        0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91, 0x1DB71064, 0x6AB020F2,
+        0xF3B97148, 0x84BE41DE, 0x1ADAD47D, 0x6DDDE4EB, 0xF4D4B551, 0x83D385C7,
+        0x136C9856, 0x646BA8C0, 0xFD62F97A, 0x8A65C9EC, 0x14015C4F, 0x63066CD9,
+        0xFA0F3D63, 0x8D080DF5, 0x3B6E20C8, 0x4C69105E, 0xD56041E4, 0xA2677172,
+        0x3C03E4D1, 0x4B04D447, 0xD20D85FD, 0xA50AB56B, 0x35B5A8FA, 0x42B2986C,
+        0xDBBBC9D6, 0xACBCF940, 0x32D86CE3, 0x45DF5C75, 0xDCD60DCF, 0xABD13D59,
+        0x26D930AC, 0x51DE003A, 0xC8D75180, 0xBFD06116, 0x21B4F4B5, 0x56B3C423,
+        0xCFBA9599, 0xB8BDA50F, 0x2802B89E, 0x5F058808, 0xC60CD9B2, 0xB10BE924,
+        0x2F6F7C87, 0x58684C11, 0xC1611DAB, 0xB6662D3D, 0x76DC4190, 0x01DB7106,
+        0x98D220BC, 0xEFD5102A, 0x71B18589, 0x06B6B51F, 0x9FBFE4A5, 0xE8B8D433,
+        0x7807C9A2, 0x0F00F934, 0x9609A88E, 0xE10E9818, 0x7F6A0DBB, 0x086D3D2D,
+        0x91646C97, 0xE6635C01, 0x6B6B51F4, 0x1C6C6162, 0x856530D8, 0xF262004E,
+        0x6C0695ED, 0x1B01A57B, 0x8208F4C1, 0xF50FC457, 0x65B0D9C6, 0x12B7E950,
+        0x8BBEB8EA, 0xFCB9887C, 0x62DD1DDF, 0x15DA2D49, 0x8CD37CF3, 0xFBD44C65,
+        0x4DB26158, 0x3AB551CE, 0xA3BC0074, 0xD4BB30E2, 0x4ADFA541, 0x3DD895D7,
+        0xA4D1C46D, 0xD3D6F4FB, 0x4369E96A, 0x346ED9FC, 0xAD678846, 0xDA60B8D0,
+        0x44042D73, 0x33031DE5, 0xAA0A4C5F, 0xDD0D7CC9, 0x5005713C, 0x270241AA,
+        0xBE0B1010, 0xC90C2086, 0x5768B525, 0x206F85B3, 0xB966D409, 0xCE61E49F,
+        0x5EDEF90E, 0x29D9C998, 0xB0D09822, 0xC7D7A8B4, 0x59B33D17, 0x2EB40D81,
+        0xB7BD5C3B, 0xC0BA6CAD, 0xEDB88320, 0x9ABFB3B6, 0x03B6E20C, 0x74B1D29A,
+        0xEAD54739, 0x9DD277AF, 0x04DB2615, 0x73DC1683, 0xE3630B12, 0x94643B84,
+        0x0D6D6A3E, 0x7A6A5AA8, 0xE40ECF0B, 0x9309FF9D, 0x0A00AE27, 0x7D079EB1,
+        0xF00F9344, 0x8708A3D2, 0x1E01F268, 0x6906C2FE, 0xF762575D, 0x806567CB,
+        0x196C3671, 0x6E6B06E7, 0xFED41B76, 0x89D32BE0, 0x10DA7A5A, 0x67DD4ACC,
+        0xF9B9DF6F, 0x8EBEEFF9, 0x17B7BE43, 0x60B08ED5, 0xD6D6A3E8, 0xA1D1937E,
+        0x38D8C2C4, 0x4FDFF252, 0xD1BB67F1, 0xA6BC5767, 0x3FB506DD, 0x48B2364B,
+        0xD80D2BDA, 0xAF0A1B4C, 0x36034AF6, 0x41047A60, 0xDF60EFC3, 0xA867DF55,
+        0x316E8EEF, 0x4669BE79, 0xCB61B38C, 0xBC66831A, 0x256FD2A0, 0x5268E236,
+        0xCC0C7795, 0xBB0B4703, 0x220216B9, 0x5505262F, 0xC5BA3BBE, 0xB2BD0B28,
+        0x2BB45A92, 0x5CB36A04, 0xC2D7FFA7, 0xB5D0CF31, 0x2CD99E8B, 0x5BDEAE1D,
+        0x9B64C2B0, 0xEC63F226, 0x756AA39C, 0x026D930A, 0x9C0906A9, 0xEB0E363F,
+        0x72076785, 0x05005713, 0x95BF4A82, 0xE2B87A14, 0x7BB12BAE, 0x0CB61B38,
+        0x92D28E9B, 0xE5D5BE0D, 0x7CDCEFB7, 0x0BDBDF21, 0x86D3D2D4, 0xF1D4E242,
+        0x68DDB3F8, 0x1FDA836E, 0x81BE16CD, 0xF6B9265B, 0x6FB077E1, 0x18B74777,
+        0x88085AE6, 0xFF0F6A70, 0x66063BCA, 0x11010B5C, 0x8F659EFF, 0xF862AE69,
+        0x616BFFD3, 0x166CCF45, 0xA00AE278, 0xD70DD2EE, 0x4E048354, 0x3903B3C2,
+        0xA7672661, 0xD06016F7, 0x4969474D, 0x3E6E77DB, 0xAED16A4A, 0xD9D65ADC,
+        0x40DF0B66, 0x37D83BF0, 0xA9BCAE53, 0xDEBB9EC5, 0x47B2CF7F, 0x30B5FFE9,
+        0xBDBDF21C, 0xCABAC28A, 0x53B39330, 0x24B4A3A6, 0xBAD03605, 0xCDD70693,
+        0x54DE5729, 0x23D967BF, 0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94,
+        0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D
+};
+
+//Reflected CRC32, 0xEDB88320, start with 0 and pass the last result in
+//to carry on over more data. A byte at a time through the table, so
+//hashing a whole partition isn't held up by the bit loop
+uint32_t displayAssetCrc32(uint32_t CRC, const uint8_t DATA[], int SIZE)
+{
+        CRC = ~CRC;
+        for(int i=0;i<SIZE;i++)
+        {
+                CRC = (CRC>>8)^displayAssetCrcTable[(CRC^DATA[i])&0xFF];
+        }
+        return ~CRC;
+}
+int displayAssetBankAddress(int BANK)
+{
+        return DISPLAY_ASSET_BANK_ADDRESS+(BANK*DISPLAY_ASSET_BANK_SIZE);
+}
+static uint32_t displayAssetRecordChecksum(const displayAssetRecord_t *RECORD)
+{
+        return displayAssetCrc32(0,(const uint8_t *)RECORD,offsetof(displayAssetRecord_t,checksum));
+}
+static int displayAssetRecordAddress(int SLOT)
+{
+        return DISPLAY_ASSET_RECORD_ADDRESS+(SLOT*DISPLAY_ASSET_RECORD_SLOT_SIZE);
+}
+//Looks through every slot for the newest good record. Returns its slot,
+//or -1 if no bank has ever been committed
+static int displayAssetRecordFind(nvms_t FLASH_MEMORY, displayAssetRecord_t *NEWEST)
+{
+        const int slotCount = (DISPLAY_ASSET_RECORD_SECTORS*DISPLAY_ASSET_RECORD_SECTOR_SIZE)/DISPLAY_ASSET_RECORD_SLOT_SIZE;
+        displayAssetRecord_t record;
+        int newestSlot = -1;
+
+        for(int slot=0;slot<slotCount;slot++)
+        {
+                ad_nvms_read(FLASH_MEMORY, displayAssetRecordAddress(slot), (uint8 *) &record, sizeof(record));
+                if((record.magic!=DISPLAY_ASSET_RECORD_MAGIC)||(record.bank>=DISPLAY_ASSET_BANKS)||
+                   (record.packSize>DISPLAY_ASSET_BANK_SIZE)||(displayAssetRecordChecksum(&record)!=record.checksum))
+                {
+                        continue;
+                }
+                //Compared as a difference so the sequence can wrap
+                if((newestSlot<0)||((int32_t)(record.sequence-NEWEST->sequence)>0))
+                {
+                        *NEWEST = record;
+                        newestSlot = slot;
+                }
+        }
+        return newestSlot;
+}
+static bool displayAssetRecordBlank(const displayAssetRecord_t *RECORD)
+{
+        const uint8_t *bytes = (const uint8_t *)RECORD;
+        for(int i=0;i<(int)sizeof(*RECORD);i++)
+        {
+                if(bytes[i]!=0xFF)
+                {
+                        return false;
+                }
+        }
+        return true;
+}
+//The bank the newest record names, straight from flash so it can be
+//asked from another task than the one drawing
+int displayAssetActiveBank(void)
+{
+        nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        displayAssetRecord_t record;
+
+        return (displayAssetRecordFind(flashMemory,&record)<0)?DISPLAY_ASSET_NO_BANK:(int)record.bank;
+}
+//Makes BANK the active one by appending a record after the newest.
+//Older records are never touched, so until this one is fully programmed
+//the previous bank is still what a reset comes back to. When a sector
+//fills up the other one is erased, it only holds older records
+bool displayAssetsCommit(int BANK, uint32_t PACK_SIZE, uint32_t PACK_CRC)
+{
+        const int slotsPerSector = DISPLAY_ASSET_RECORD_SECTOR_SIZE/DISPLAY_ASSET_RECORD_SLOT_SIZE;
+        const int slotCount = DISPLAY_ASSET_RECORD_SECTORS*slotsPerSector;
+        nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        displayAssetRecord_t newest;
+        displayAssetRecord_t record;
+        displayAssetRecord_t slotContents;
+        int slot = displayAssetRecordFind(flashMemory,&newest);
+        int slotsTried = 0;
+
+        if((BANK<0)||(BANK>=DISPLAY_ASSET_BANKS)||(PACK_SIZE>DISPLAY_ASSET_BANK_SIZE))
+        {
+                return false;
+        }
+        record.magic = DISPLAY_ASSET_RECORD_MAGIC;
+        record.sequence = (slot<0)?1:(newest.sequence+1);
+        record.bank = BANK;
+        record.packSize = PACK_SIZE;
+        record.packCrc = PACK_CRC;
+        record.checksum = displayAssetRecordChecksum(&record);
+        //Whatever a torn write left behind the newest record is stepped over
+        do
+        {
+                slot = (slot+1)%slotCount;
+                if((slot%slotsPerSector)==0)
+                {
+                        ad_nvms_erase_region(flashMemory, displayAssetRecordAddress(slot), DISPLAY_ASSET_RECORD_SECTOR_SIZE);
+                }
+                ad_nvms_read(flashMemory, displayAssetRecordAddress(slot), (uint8 *) &slotContents, sizeof(slotContents));
+        } while(!displayAssetRecordBlank(&slotContents)&&(++slotsTried<slotCount));
+        if(!displayAssetRecordBlank(&slotContents))
+        {
+                return false;
+        }
+        ad_nvms_write(flashMemory, displayAssetRecordAddress(slot), (const uint8 *) &record, sizeof(record));
+        ad_nvms_read(flashMemory, displayAssetRecordAddress(slot), (uint8 *) &slotContents, sizeof(slotContents));
+        return memcmp(&slotContents,&record,sizeof(record))==0;
+}
+//Reads the directory of the active bank into RAM. No committed bank,
+//or a pack that is from another version, too big, not the one its
+//record names or whose directory doesn't match its checksum, leaves no
+//assets loaded
+bool displayAssetsLoad(void)
+{
+        nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        displayAssetRecord_t record;
+        displayAssetHeader_t header;
+        int base = 0;
+
+        displayAssetIsLoaded = false;
+        memset(displayAssetIndex,0,sizeof(displayAssetIndex));
+        if(displayAssetRecordFind(flashMemory,&record)<0)
+        {
+                return false;
+        }
+        base = displayAssetBankAddress(record.bank);
+        ad_nvms_read(flashMemory, base, (uint8 *) &header, sizeof(header));
+        if((header.magic!=DISPLAY_ASSET_MAGIC)||(header.version!=DISPLAY_ASSET_VERSION)||
+           (header.assetCount==0)||(header.assetCount>DISPLAY_ASSET_MAX_ASSETS)||(header.packSize!=record.packSize))
+        {
+                return false;
+        }
+        ad_nvms_read(flashMemory, base+sizeof(header), (uint8 *) displayAssetDirectory,
+                     header.assetCount*sizeof(displayAsset_t));
+        if(displayAssetCrc32(0,(const uint8_t *)displayAssetDirectory,header.assetCount*sizeof(displayAsset_t))!=header.checksum)
+        {
+                return false;
+        }
+        for(int i=0;i<header.assetCount;i++)
+        {
+                uint32_t slot = displayAssetDirectory[i].id&(DISPLAY_ASSET_INDEX_SLOTS-1);
+                while(displayAssetIndex[slot]!=0)
+                {
+                        //Two names hashing the same would make one unreachable
+                        if(displayAssetDirectory[displayAssetIndex[slot]-1].id==displayAssetDirectory[i].id)
+                        {
+                                memset(displayAssetIndex,0,sizeof(displayAssetIndex));
+                                return false;
+                        }
+                        slot = (slot+1)&(DISPLAY_ASSET_INDEX_SLOTS-1);
+                }
+                displayAssetIndex[slot] = i+1;
+        }
+        displayAssetHeader = header;
+        displayAssetBankBase = base;
+        displayAssetIsLoaded = true;
+        return true;
+}
+bool displayAssetsLoaded(void)
+{
+        return displayAssetIsLoaded;
+}
+//Where the loaded pack starts in flash. Addresses the packer put inside
+//assets are from the start of the pack, so are moved by this
+int displayAssetBase(void)
+{
+        return displayAssetBankBase;
+}
+int displayAssetCount(void)
+{
+        return displayAssetIsLoaded?displayAssetHeader.assetCount:0;
+}
+const displayAsset_t *displayAssetFind(uint32_t ID)
+{
+        uint32_t slot = ID&(DISPLAY_ASSET_INDEX_SLOTS-1);
+
+        displayAssetStats.lookups++;
+        if(displayAssetIsLoaded)
+        {
+                while(displayAssetIndex[slot]!=0)
+                {
+                        const displayAsset_t *asset = &displayAssetDirectory[displayAssetIndex[slot]-1];
+                        displayAssetStats.probes++;
+                        if(asset->id==ID)
+                        {
+                                return asset;
+                        }
+                        slot = (slot+1)&(DISPLAY_ASSET_INDEX_SLOTS-1);
+                }
+        }
+        displayAssetStats.misses++;
+        return NULL;
+}
+//Where a directory entry's asset starts in flash, its offset is from
+//the start of the bank the pack is in
+int displayAssetFlashAddress(const displayAsset_t *ASSET)
+{
+        return displayAssetBankBase+(int)ASSET->offset;
+}
+//Where the asset starts in flash, or -1 if the pack doesn't have it
+int displayAssetAddress(uint32_t ID)
+{
+        const displayAsset_t *asset = displayAssetFind(ID);
+        return (asset==NULL)?-1:displayAssetFlashAddress(asset);
+}
+//Checks an asset against its checksum. Reads all of it, so it is for
+//after a pack is loaded rather than every draw
+bool displayAssetVerify(uint32_t ID)
+{
+        const displayAsset_t *asset = displayAssetFind(ID);
+        nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        uint8_t chunk[DISPLAY_ASSET_VERIFY_CHUNK];
+        uint32_t crc = 0;
+        uint32_t position = 0;
+
+        if(asset==NULL)
+        {
+                return false;
+        }
+        while(position<asset->length)
+        {
+                int chunkSize = ((asset->length-position)>sizeof(chunk))?sizeof(chunk):(asset->length-position);
+                ad_nvms_read(flashMemory, displayAssetFlashAddress(asset)+position, (uint8 *) chunk, chunkSize);
+                crc = displayAssetCrc32(crc,chunk,chunkSize);
+                position += chunkSize;
+        }
+        return crc==asset->checksum;
+}
+void displayGetAssetStats(displayAssetStats_t *STATS)
+{
+        *STATS = displayAssetStats;
+}
+void displayResetAssetStats(void)
+{
+        memset(&displayAssetStats,0,sizeof(displayAssetStats));
+}
@@ -0,0 +1,108 @@
+/*
+ * displayAssets.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef DISPLAYASSETS_H_
+#define DISPLAYASSETS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Asset packs start with this, "ASET" little endian
+#define DISPLAY_ASSET_MAGIC 0x54455341
+#define DISPLAY_ASSET_VERSION 1
+//The storage partition starts with two sectors of commit records and
+//then holds two banks, each big enough for a whole pack. The newest
+//valid record names the bank the display reads, a new pack is loaded
+//into the other one and only becomes active when its record is written
+#define DISPLAY_ASSET_RECORD_MAGIC 0x4B4E4142 //"BANK" little endian
+#define DISPLAY_ASSET_RECORD_ADDRESS 0
+#define DISPLAY_ASSET_RECORD_SECTOR_SIZE 4096
+#define DISPLAY_ASSET_RECORD_SECTORS 2
+//Records are appended into slots that never straddle a flash page, so
+//each one goes in with a single program
+#define DISPLAY_ASSET_RECORD_SLOT_SIZE 32
+#define DISPLAY_ASSET_BANKS 2
+#define DISPLAY_ASSET_BANK_ADDRESS 0x10000
+#define DISPLAY_ASSET_BANK_SIZE 0x7F0000
+#define DISPLAY_ASSET_NO_BANK -1
+#define DISPLAY_ASSET_MAX_ASSETS 32
+//Slots in the RAM index, a power of two at least twice the assets so
+//lookups rarely probe past the first one
+#define DISPLAY_ASSET_INDEX_SLOTS 64
+//Asset bytes read at a time while checking a checksum
+#define DISPLAY_ASSET_VERIFY_CHUNK 64
+
+//Images use their DISPLAY_IMAGE_FORMAT, the rest are one of these
+#define DISPLAY_ASSET_FORMAT_GLYPHS 0x10
+#define DISPLAY_ASSET_FORMAT_HANDS 0x11
+
+//Pack header, followed by assetCount directory entries and then the
+//assets. checksum is the CRC32 of the entries
+typedef struct
+{
+        uint32_t magic;
+        uint8_t version;
+        uint8_t reserved;
+        uint16_t assetCount;
+        uint32_t packSize;
+        uint32_t checksum;
+} displayAssetHeader_t;
+
+//One asset. id is displayAssetHash of its name, offset is from the
+//start of the pack and checksum is the CRC32 of its length bytes.
+//width, height and stride in pixels are only set for images, whose
+//headers can't hold more than 255
+typedef struct
+{
+        uint32_t id;
+        uint32_t offset;
+        uint32_t length;
+        uint8_t format;
+        uint8_t reserved;
+        uint16_t width;
+        uint16_t height;
+        uint16_t stride;
+        uint32_t checksum;
+} displayAsset_t;
+
+//Commit record. The one with the highest sequence and a good checksum,
+//the CRC32 of the fields before it, wins, so a record torn by a reset
+//is ignored and the bank before it stays active
+typedef struct
+{
+        uint32_t magic;
+        uint32_t sequence;
+        uint32_t bank;
+        uint32_t packSize;
+        uint32_t packCrc;
+        uint32_t checksum;
+} displayAssetRecord_t;
+
+typedef struct
+{
+        uint32_t lookups;
+        uint32_t probes;
+        uint32_t misses;
+} displayAssetStats_t;
+
+bool displayAssetsLoad(void);
+bool displayAssetsLoaded(void);
+int  displayAssetCount(void);
+uint32_t displayAssetHash(const char *NAME);
+uint32_t displayAssetCrc32(uint32_t CRC, const uint8_t DATA[], int SIZE);
+const displayAsset_t *displayAssetFind(uint32_t ID);
+int  displayAssetFlashAddress(const displayAsset_t *ASSET);
+int  displayAssetAddress(uint32_t ID);
+bool displayAssetVerify(uint32_t ID);
+int  displayAssetBankAddress(int BANK);
+int  displayAssetBase(void);
+int  displayAssetActiveBank(void);
+bool displayAssetsCommit(int BANK, uint32_t PACK_SIZE, uint32_t PACK_CRC);
+void displayGetAssetStats(displayAssetStats_t *STATS);
+void displayResetAssetStats(void);
+
+#endif /* DISPLAYASSETS_H_ */
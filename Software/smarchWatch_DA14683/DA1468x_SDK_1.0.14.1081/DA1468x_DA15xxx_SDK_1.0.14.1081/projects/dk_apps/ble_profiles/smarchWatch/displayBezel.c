@@ -0,0 +1,90 @@
+/*
+ * displayBezel.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "displayBezel.h"
+
+//The insets are worked out by the compiler. A row's inset is the
+//number of pixels left of the middle that are outside the glass, and
+//since the circle is convex those are always the leftmost ones
+#define DISPLAY_BEZEL_SUM4(X,Y) (DISPLAY_BEZEL_OUTSIDE((X),Y)+DISPLAY_BEZEL_OUTSIDE((X)+1,Y)+\
+                                 DISPLAY_BEZEL_OUTSIDE((X)+2,Y)+DISPLAY_BEZEL_OUTSIDE((X)+3,Y))
+#define DISPLAY_BEZEL_SUM20(X,Y) (DISPLAY_BEZEL_SUM4((X),Y)+DISPLAY_BEZEL_SUM4((X)+4,Y)+DISPLAY_BEZEL_SUM4((X)+8,Y)+\
+                                  DISPLAY_BEZEL_SUM4((X)+12,Y)+DISPLAY_BEZEL_SUM4((X)+16,Y))
+#define DISPLAY_BEZEL_INSET(Y) (DISPLAY_BEZEL_SUM20(0,Y)+DISPLAY_BEZEL_SUM20(20,Y)+DISPLAY_BEZEL_SUM20(40,Y)+\
+                                DISPLAY_BEZEL_SUM20(60,Y)+DISPLAY_BEZEL_SUM20(80,Y)+DISPLAY_BEZEL_SUM20(100,Y))
+#define DISPLAY_BEZEL_ROWS4(Y) DISPLAY_BEZEL_INSET(Y),DISPLAY_BEZEL_INSET((Y)+1),DISPLAY_BEZEL_INSET((Y)+2),DISPLAY_BEZEL_INSET((Y)+3)
+#define DISPLAY_BEZEL_ROWS20(Y) DISPLAY_BEZEL_ROWS4(Y),DISPLAY_BEZEL_ROWS4((Y)+4),DISPLAY_BEZEL_ROWS4((Y)+8),\
+                                DISPLAY_BEZEL_ROWS4((Y)+12),DISPLAY_BEZEL_ROWS4((Y)+16)
+
+#if (ST7789_WIDTH!=240)||(ST7789_HEIGHT!=240)
+#error "The bezel table is laid out for a 240x240 panel"
+#endif
+
+const uint8_t displayBezelInsets[ST7789_HEIGHT] =
+{
+        DISPLAY_BEZEL_ROWS20(0),DISPLAY_BEZEL_ROWS20(20),DISPLAY_BEZEL_ROWS20(40),
+        DISPLAY_BEZEL_ROWS20(60),DISPLAY_BEZEL_ROWS20(80),DISPLAY_BEZEL_ROWS20(100),
+        DISPLAY_BEZEL_ROWS20(120),DISPLAY_BEZEL_ROWS20(140),DISPLAY_BEZEL_ROWS20(160),
+        DISPLAY_BEZEL_ROWS20(180),DISPLAY_BEZEL_ROWS20(200),DISPLAY_BEZEL_ROWS20(220)
+};
+
+static bool displayRoundMask = false;
+
+//Inset that keeps a box spanning rows YSTART to YEND inside the glass.
+//The widest inset of a run of rows is always at one of its ends
+int displayBezelInsetForRows(int YSTART, int YEND)
+{
+        int topInset = ST7789_WIDTH/2;
+        int bottomInset = ST7789_WIDTH/2;
+
+        if((YSTART>=ST7789_YSTART)&&(YSTART<ST7789_HEIGHT))
+        {
+                topInset = displayBezelInsets[YSTART];
+        }
+        if((YEND>=ST7789_YSTART)&&(YEND<ST7789_HEIGHT))
+        {
+                bottomInset = displayBezelInsets[YEND];
+        }
+        return (topInset>bottomInset)?topInset:bottomInset;
+}
+//Clips XSTART to XEND to the glass on row YSTART and returns the last
+//row up to YEND that clips to the same columns, so a rectangle can go
+//out as a few windows. The clipped range is empty when XSTART>XEND
+int displayBezelClipRows(int YSTART, int YEND, int XSTART, int XEND, int *CLIPPED_XSTART, int *CLIPPED_XEND)
+{
+        int inset = displayBezelInsets[YSTART];
+        int clippedStart = (XSTART<inset)?inset:XSTART;
+        int clippedEnd = (XEND>ST7789_WIDTH-1-inset)?ST7789_WIDTH-1-inset:XEND;
+        int y = YSTART;
+
+        while(y<YEND)
+        {
+                int nextInset = displayBezelInsets[y+1];
+                int nextStart = (XSTART<nextInset)?nextInset:XSTART;
+                int nextEnd = (XEND>ST7789_WIDTH-1-nextInset)?ST7789_WIDTH-1-nextInset:XEND;
+                if((nextStart!=clippedStart)||(nextEnd!=clippedEnd))
+                {
+                        break;
+                }
+                y++;
+        }
+        *CLIPPED_XSTART = clippedStart;
+        *CLIPPED_XEND = clippedEnd;
+        return y;
+}
+//With the round mask on, fills and image blits leave out the pixels
+//behind the bezel so they never go over SPI
+void displaySetRoundMask(bool IS_ENABLED)
+{
+        displayRoundMask = IS_ENABLED;
+}
+bool displayIsRoundMask(void)
+{
+        return displayRoundMask;
+}
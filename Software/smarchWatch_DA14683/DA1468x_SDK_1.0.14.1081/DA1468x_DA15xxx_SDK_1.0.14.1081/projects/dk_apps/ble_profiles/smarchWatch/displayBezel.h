@@ -0,0 +1,35 @@
+/*
+ * displayBezel.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef DISPLAYBEZEL_H_
+#define DISPLAYBEZEL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "displayDriver.h"
+
+//The glass is a circle as wide as the panel. A pixel is outside it when
+//its center is more than a radius from the middle of the panel, worked
+//out in half pixels so everything stays an integer
+#define DISPLAY_BEZEL_DIAMETER ST7789_WIDTH
+#define DISPLAY_BEZEL_OUTSIDE(X,Y) (((((2*(X))-(ST7789_WIDTH-1))*((2*(X))-(ST7789_WIDTH-1)))+\
+                                     (((2*(Y))-(ST7789_HEIGHT-1))*((2*(Y))-(ST7789_HEIGHT-1))))>\
+                                    (DISPLAY_BEZEL_DIAMETER*DISPLAY_BEZEL_DIAMETER))
+
+//First visible pixel of row Y, the last one is the same distance from
+//the right edge
+#define DISPLAY_BEZEL_XSTART(Y) (displayBezelInsets[(Y)])
+#define DISPLAY_BEZEL_XEND(Y) (ST7789_WIDTH-1-displayBezelInsets[(Y)])
+
+extern const uint8_t displayBezelInsets[ST7789_HEIGHT];
+
+int  displayBezelInsetForRows(int YSTART, int YEND);
+int  displayBezelClipRows(int YSTART, int YEND, int XSTART, int XEND, int *CLIPPED_XSTART, int *CLIPPED_XEND);
+void displaySetRoundMask(bool IS_ENABLED);
+bool displayIsRoundMask(void);
+
+#endif /* DISPLAYBEZEL_H_ */
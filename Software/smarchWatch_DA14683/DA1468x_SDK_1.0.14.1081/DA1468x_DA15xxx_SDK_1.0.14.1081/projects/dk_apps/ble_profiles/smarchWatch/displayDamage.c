@@ -0,0 +1,174 @@
+/*
+ * displayDamage.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "displayDamage.h"
+#include "displayDriver.h"
+
+static displayRect_t damageRects[DISPLAY_DAMAGE_MAX_RECTS];
+static int damageRectCount = 0;
+static bool damageTracking = false;
+static displayDamageStats_t damageStats = {0};
+
+static int displayRectArea(const displayRect_t *RECT)
+{
+        return (RECT->xEnd-RECT->xStart+1)*(RECT->yEnd-RECT->yStart+1);
+}
+//Bus cost of pushing a rectangle, window setup plus pixel data
+static int displayRectCost(const displayRect_t *RECT)
+{
+        return DISPLAY_DAMAGE_WINDOW_COST+(displayRectArea(RECT)*BYTES_PER_PIXEL);
+}
+static void displayRectUnion(const displayRect_t *A, const displayRect_t *B, displayRect_t *RESULT)
+{
+        RESULT->xStart = (A->xStart<B->xStart)?A->xStart:B->xStart;
+        RESULT->xEnd = (A->xEnd>B->xEnd)?A->xEnd:B->xEnd;
+        RESULT->yStart = (A->yStart<B->yStart)?A->yStart:B->yStart;
+        RESULT->yEnd = (A->yEnd>B->yEnd)?A->yEnd:B->yEnd;
+}
+//How much more it costs to push A and B as one rectangle than as two.
+//Negative or zero means merging saves bus time
+static int displayRectMergePenalty(const displayRect_t *A, const displayRect_t *B)
+{
+        displayRect_t mergedRect;
+        displayRectUnion(A,B,&mergedRect);
+        return displayRectCost(&mergedRect)-displayRectCost(A)-displayRectCost(B);
+}
+static void displayDamageRemove(int INDEX)
+{
+        damageRectCount--;
+        damageRects[INDEX] = damageRects[damageRectCount];
+}
+//Merges rectangles for as long as doing so is no more expensive than
+//pushing them separately
+static void displayDamageCoalesce(void)
+{
+        bool mergedSomething = true;
+        while(mergedSomething)
+        {
+                mergedSomething = false;
+                for(int i=0;i<damageRectCount&&!mergedSomething;i++)
+                {
+                        for(int j=i+1;j<damageRectCount;j++)
+                        {
+                                if(displayRectMergePenalty(&damageRects[i],&damageRects[j])<=0)
+                                {
+                                        displayRectUnion(&damageRects[i],&damageRects[j],&damageRects[i]);
+                                        displayDamageRemove(j);
+                                        damageStats.rectsMerged++;
+                                        mergedSomething = true;
+                                        break;
+                                }
+                        }
+                }
+        }
+}
+//Out of slots, merge the pair that costs the least extra
+static void displayDamageMergeCheapest(void)
+{
+        int bestPenalty = 0x7FFFFFFF;
+        int bestI = 0;
+        int bestJ = 1;
+        int penalty = 0;
+        for(int i=0;i<damageRectCount;i++)
+        {
+                for(int j=i+1;j<damageRectCount;j++)
+                {
+                        penalty = displayRectMergePenalty(&damageRects[i],&damageRects[j]);
+                        if(penalty<bestPenalty)
+                        {
+                                bestPenalty = penalty;
+                                bestI = i;
+                                bestJ = j;
+                        }
+                }
+        }
+        displayRectUnion(&damageRects[bestI],&damageRects[bestJ],&damageRects[bestI]);
+        displayDamageRemove(bestJ);
+        damageStats.rectsMerged++;
+}
+void displayDamageReset(void)
+{
+        damageRectCount = 0;
+}
+void displayDamageTrack(bool IS_TRACKING)
+{
+        damageTracking = IS_TRACKING;
+}
+bool displayDamageIsTracking(void)
+{
+        return damageTracking;
+}
+void displayDamageAdd(int XSTART, int XEND, int YSTART, int YEND)
+{
+        //Clip to the screen
+        if(XSTART<ST7789_XSTART)
+        {
+                XSTART = ST7789_XSTART;
+        }
+        if(YSTART<ST7789_YSTART)
+        {
+                YSTART = ST7789_YSTART;
+        }
+        if(XEND>ST7789_WIDTH-1)
+        {
+                XEND = ST7789_WIDTH-1;
+        }
+        if(YEND>ST7789_HEIGHT-1)
+        {
+                YEND = ST7789_HEIGHT-1;
+        }
+        if(XEND<XSTART||YEND<YSTART)
+        {
+                return;
+        }
+        if(damageRectCount==DISPLAY_DAMAGE_MAX_RECTS)
+        {
+                displayDamageMergeCheapest();
+        }
+        damageRects[damageRectCount].xStart = XSTART;
+        damageRects[damageRectCount].xEnd = XEND;
+        damageRects[damageRectCount].yStart = YSTART;
+        damageRects[damageRectCount].yEnd = YEND;
+        damageRectCount++;
+        damageStats.rectsAdded++;
+        displayDamageCoalesce();
+}
+int displayDamageGetRects(const displayRect_t **RECTS)
+{
+        *RECTS = damageRects;
+        return damageRectCount;
+}
+//Calls REDRAW once per merged region and empties the list. Tracking is
+//suspended while redrawing so the redraw doesn't damage itself.
+//Returns the number of pixel bytes pushed
+int displayDamageFlush(displayDamageRedraw_t REDRAW, void *USER_DATA)
+{
+        bool wasTracking = damageTracking;
+        int bytesFlushed = 0;
+
+        damageTracking = false;
+        for(int i=0;i<damageRectCount;i++)
+        {
+                REDRAW(&damageRects[i],USER_DATA);
+                bytesFlushed += displayRectArea(&damageRects[i])*BYTES_PER_PIXEL;
+        }
+        damageStats.rectsFlushed += damageRectCount;
+        damageStats.bytesFlushed += bytesFlushed;
+        damageRectCount = 0;
+        damageTracking = wasTracking;
+        return bytesFlushed;
+}
+void displayDamageGetStats(displayDamageStats_t *STATS)
+{
+        *STATS = damageStats;
+}
+void displayDamageResetStats(void)
+{
+        memset(&damageStats,0,sizeof(damageStats));
+}
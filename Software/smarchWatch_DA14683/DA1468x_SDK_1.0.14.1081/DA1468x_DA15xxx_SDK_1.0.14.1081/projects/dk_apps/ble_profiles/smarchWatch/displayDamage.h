@@ -0,0 +1,47 @@
+/*
+ * displayDamage.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef DISPLAYDAMAGE_H_
+#define DISPLAYDAMAGE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DISPLAY_DAMAGE_MAX_RECTS 8
+//Bus cost of one extra window in bytes of pixel data. CASET+RASET+RAMWR
+//is 11 bytes on the wire plus the command/data switching around them
+#define DISPLAY_DAMAGE_WINDOW_COST 64
+
+//Inclusive screen rectangle
+typedef struct
+{
+        int16_t xStart;
+        int16_t xEnd;
+        int16_t yStart;
+        int16_t yEnd;
+} displayRect_t;
+
+typedef struct
+{
+        uint32_t rectsAdded;
+        uint32_t rectsMerged;
+        uint32_t rectsFlushed;
+        uint32_t bytesFlushed;
+} displayDamageStats_t;
+
+typedef void (*displayDamageRedraw_t)(const displayRect_t *RECT, void *USER_DATA);
+
+void displayDamageReset(void);
+void displayDamageTrack(bool IS_TRACKING);
+bool displayDamageIsTracking(void);
+void displayDamageAdd(int XSTART, int XEND, int YSTART, int YEND);
+int  displayDamageGetRects(const displayRect_t **RECTS);
+int  displayDamageFlush(displayDamageRedraw_t REDRAW, void *USER_DATA);
+void displayDamageGetStats(displayDamageStats_t *STATS);
+void displayDamageResetStats(void);
+
+#endif /* DISPLAYDAMAGE_H_ */
@@ -6,8 +6,17 @@
  */
 
 #include <stdint.h>
-#include "math.h"
+#include <stdbool.h>
+#include <string.h>
 #include "displayDriver.h"
+#include "displayDamage.h"
+#include "displayList.h"
+#include "displaySpan.h"
+#include "displayPolygon.h"
+#include "fixedMath.h"
+#include "displayBezel.h"
+#include "displayImage.h"
+#include "displayAssets.h"
 #include "platform_devices.h"
 #include "ad_spi.h"
 #include "ad_nvms.h"
@@ -25,26 +34,271 @@ int absoluteValue(int NUMBER)
     }
 }
 
+//Display bus state. The bus is held open for the whole of a
+//transaction so a command and its parameters (or a whole command
+//list) only pay for one ad_spi_open/ad_spi_close
+static spi_device displaySpi;
+static int displayTransactionDepth = 0;
+static int displayDataMode = -1;
+static displayBusStats_t displayBusStats = {0};
+
+//Streaming blit state. Two ping-pong buffers so the next chunk can be
+//fetched from flash while the previous one is clocked out by SPI DMA.
+//Word aligned so indexed images can be expanded into them a word at a time
+static uint8_t displayBlitBuffer[DISPLAY_BLIT_BUFFERS][SPI_WRITE_BUFFER_SIZE] __attribute__((aligned(4)));
+static OS_EVENT displayWriteDoneEvent = NULL;
+static bool displayWriteInFlight = false;
+
+//Shadow copy of the controller's column/row address registers so a
+//window that hasn't changed costs nothing. -1 means unknown
+static int displayColumnStart = -1;
+static int displayColumnEnd = -1;
+static int displayRowStart = -1;
+static int displayRowEnd = -1;
+//Tracks the controller's RAM write pointer so a window that carries on
+//where the last write stopped can use RAMWRC instead of a new window
+static bool displayRamWriteActive = false;
+static uint32_t displayRamBytesWritten = 0;
+static displayWindowStats_t displayWindowStats = {0};
+
+//Init sequence, see displayWriteCommandList for the format
+static const uint8_t displayInitCommands[] =
+{
+        10,
+        //Out of sleep mode
+        ST7789_SLPOUT,  ST7789_CMD_DELAY,
+        10,
+        //Set the color mode to 16-bit
+        ST7789_COLMOD,  1 | ST7789_CMD_DELAY,
+        0x55,
+        10,
+        //Set the memory access control so that
+        //display data comes as row address then
+        //column address
+        //Also sets refresh from bottom to top
+        ST7789_MADCTL,  1,
+        0x00,
+        //Column address start and end
+        ST7789_CASET,   4,
+        ST7789_XSTART >> 8, ST7789_XSTART & 0xFF, ST7789_WIDTH >> 8, ST7789_WIDTH & 0xFF,
+        //Row address start and end
+        ST7789_RASET,   4,
+        (ST7789_YSTART+ST7789_HEIGHT_OFFSET) >> 8, (ST7789_YSTART+ST7789_HEIGHT_OFFSET) & 0xFF,
+        (ST7789_HEIGHT+ST7789_HEIGHT_OFFSET) >> 8, (ST7789_HEIGHT+ST7789_HEIGHT_OFFSET) & 0xFF,
+        //Enable extended command table
+        ST7789_CMD2EN,  4,
+        0x5A, 0x69, 0x02, 0x01,
+        //Set frame rate to 111 Hz (max)
+        ST7789_FRCTRL2, 1,
+        0x01,
+        //Set inversion on
+        ST7789_INVON,   0,
+        //Set normal display on
+        ST7789_NORON,   ST7789_CMD_DELAY,
+        10,
+        //Turn display on
+        ST7789_DISPON,  ST7789_CMD_DELAY,
+        10
+};
+
+void displayBeginTransaction(void)
+{
+        if(displayTransactionDepth==0)
+        {
+                if(displayWriteDoneEvent==NULL)
+                {
+                        OS_EVENT_CREATE(displayWriteDoneEvent);
+                }
+                displaySpi = ad_spi_open(DISPLAY_SPI);
+                displayDataMode = -1;
+                displayBusStats.busOpens++;
+        }
+        displayTransactionDepth++;
+}
+void displayEndTransaction(void)
+{
+        displayTransactionDepth--;
+        if(displayTransactionDepth==0)
+        {
+                displayWaitDataBuf();
+                ad_spi_close(displaySpi);
+        }
+}
+static void displayWriteDoneCallback(void *USER_DATA, uint16_t TRANSFERRED)
+{
+        OS_EVENT_SIGNAL_FROM_ISR(displayWriteDoneEvent);
+}
+void displayWaitDataBuf(void)
+{
+        if(displayWriteInFlight)
+        {
+                OS_EVENT_WAIT(displayWriteDoneEvent,OS_EVENT_FOREVER);
+                displayWriteInFlight = false;
+        }
+}
+//The ping-pong buffers, also used as render strips by displayList.c
+uint8_t *displayGetBlitBuffer(int INDEX)
+{
+        return displayBlitBuffer[INDEX];
+}
+static void displaySetDataMode(int IS_DATA)
+{
+        //Nothing can go out on the bus until a DMA write has finished
+        displayWaitDataBuf();
+        //The 9th bit is the D/C flag, only touch it when it changes
+        if(displayDataMode!=IS_DATA)
+        {
+                hw_spi_set_9th_bit(ad_spi_get_hw_spi_id(displaySpi),IS_DATA);
+                displayDataMode = IS_DATA;
+        }
+}
+static void displaySendCommand(uint8_t COMMAND)
+{
+        displaySetDataMode(0);
+        ad_spi_write(displaySpi,&COMMAND,1);
+        displayBusStats.commands++;
+        //Any other command ends the memory write
+        displayRamWriteActive = (COMMAND==ST7789_RAMWR)||(COMMAND==ST7789_RAMWRC);
+        if(COMMAND==ST7789_RAMWR)
+        {
+                displayRamBytesWritten = 0;
+        }
+}
+//Records the pixels a RAM write covers so the damage tracker knows
+//what changed on screen
+static void displayTrackRamWrite(uint32_t BYTE_OFFSET, int DATA_SIZE)
+{
+        int windowWidth = displayColumnEnd-displayColumnStart+1;
+        uint32_t firstPixel = BYTE_OFFSET/BYTES_PER_PIXEL;
+        uint32_t lastPixel = (BYTE_OFFSET+DATA_SIZE-1)/BYTES_PER_PIXEL;
+        int firstRow = 0;
+        int lastRow = 0;
+
+        if(!displayDamageIsTracking()||(windowWidth<=0)||(displayRowStart<0))
+        {
+                return;
+        }
+        firstRow = displayRowStart+(firstPixel/windowWidth);
+        lastRow = displayRowStart+(lastPixel/windowWidth);
+        if(firstRow==lastRow)
+        {
+                displayDamageAdd(displayColumnStart+(firstPixel%windowWidth),displayColumnStart+(lastPixel%windowWidth),firstRow,lastRow);
+        }
+        else
+        {
+                displayDamageAdd(displayColumnStart,displayColumnEnd,firstRow,lastRow);
+        }
+}
+static void displaySendData(const uint8_t DATA[], int DATA_SIZE)
+{
+        if(DATA_SIZE<=0)
+        {
+                return;
+        }
+        displaySetDataMode(1);
+        ad_spi_write(displaySpi,DATA,DATA_SIZE);
+        displayBusStats.dataWrites++;
+        displayBusStats.dataBytes += DATA_SIZE;
+        if(displayRamWriteActive)
+        {
+                displayTrackRamWrite(displayRamBytesWritten,DATA_SIZE);
+                displayRamBytesWritten += DATA_SIZE;
+        }
+}
 void displayWriteCommand(int COMMAND)
 {
-        spi_device displaySpi = ad_spi_open(DISPLAY_SPI);
-        hw_spi_set_9th_bit(ad_spi_get_hw_spi_id(displaySpi),0);
-        ad_spi_write(displaySpi,(uint8_t *)&COMMAND,1);
-        ad_spi_close(displaySpi);
+        displayBeginTransaction();
+        displaySendCommand(COMMAND);
+        displayEndTransaction();
 }
 void displayWriteData(int DATA)
 {
-        spi_device displaySpi = ad_spi_open(DISPLAY_SPI);
-        hw_spi_set_9th_bit(ad_spi_get_hw_spi_id(displaySpi),1);
-        ad_spi_write(displaySpi,(uint8_t *)&DATA,1);
-        ad_spi_close(displaySpi);
+        uint8_t dataByte = DATA;
+        displayBeginTransaction();
+        displaySendData(&dataByte,1);
+        displayEndTransaction();
 }
 void displayWriteDataBuf(uint8_t DATA[], int DATA_SIZE)
 {
-        spi_device displaySpi = ad_spi_open(DISPLAY_SPI);
-        hw_spi_set_9th_bit(ad_spi_get_hw_spi_id(displaySpi),1);
-        ad_spi_write(displaySpi,DATA,DATA_SIZE);
-        ad_spi_close(displaySpi);
+        displayBeginTransaction();
+        displaySendData(DATA,DATA_SIZE);
+        displayEndTransaction();
+}
+//Starts clocking DATA out by DMA and returns straight away, the
+//buffer must be left alone until displayWaitDataBuf returns. Only
+//valid inside a transaction
+void displayWriteDataBufAsync(const uint8_t DATA[], int DATA_SIZE)
+{
+        if(DATA_SIZE<=0)
+        {
+                return;
+        }
+        displaySetDataMode(1);
+        displayWriteInFlight = true;
+        displayBusStats.dataWrites++;
+        displayBusStats.dataBytes += DATA_SIZE;
+        if(displayRamWriteActive)
+        {
+                displayTrackRamWrite(displayRamBytesWritten,DATA_SIZE);
+                displayRamBytesWritten += DATA_SIZE;
+        }
+        ad_spi_write_async(displaySpi,DATA,DATA_SIZE,displayWriteDoneCallback,NULL);
+}
+void displayWriteCommandData(int COMMAND, const uint8_t PARAMETERS[], int PARAMETER_COUNT)
+{
+        displayBeginTransaction();
+        displaySendCommand(COMMAND);
+        displaySendData(PARAMETERS,PARAMETER_COUNT);
+        displayEndTransaction();
+}
+//Command list format: number of commands, then for each command
+//the command byte, the parameter count (ORed with ST7789_CMD_DELAY
+//when a delay follows), the parameters and the delay in ms
+void displayWriteCommandList(const uint8_t COMMAND_LIST[])
+{
+        int numberOfCommands = *COMMAND_LIST++;
+        displayBeginTransaction();
+        while(numberOfCommands--)
+        {
+                uint8_t command = *COMMAND_LIST++;
+                uint8_t parameterCount = *COMMAND_LIST++;
+                bool hasDelay = parameterCount & ST7789_CMD_DELAY;
+                parameterCount &= ~ST7789_CMD_DELAY;
+                displaySendCommand(command);
+                displaySendData(COMMAND_LIST,parameterCount);
+                COMMAND_LIST += parameterCount;
+                if(hasDelay)
+                {
+                        OS_DELAY_MS(*COMMAND_LIST++);
+                }
+        }
+        displayEndTransaction();
+}
+void displayGetBusStats(displayBusStats_t *STATS)
+{
+        *STATS = displayBusStats;
+}
+void displayResetBusStats(void)
+{
+        memset(&displayBusStats,0,sizeof(displayBusStats));
+}
+void displayGetWindowStats(displayWindowStats_t *STATS)
+{
+        *STATS = displayWindowStats;
+}
+void displayResetWindowStats(void)
+{
+        memset(&displayWindowStats,0,sizeof(displayWindowStats));
+}
+//Forget what the controller's address registers hold, e.g. after a
+//reset or after writing CASET/RASET directly
+void displayInvalidateWindowCache(void)
+{
+        displayColumnStart = -1;
+        displayColumnEnd = -1;
+        displayRowStart = -1;
+        displayRowEnd = -1;
+        displayRamWriteActive = false;
 }
 void displayInit(void)
 {
@@ -53,115 +307,107 @@ void displayInit(void)
         OS_DELAY_MS(10);
         hw_gpio_set_active(HW_GPIO_PORT_4,HW_GPIO_PIN_7);
         OS_DELAY_MS(10);
-        //Out of sleep mode
-        displayWriteCommand(ST7789_SLPOUT);
-        OS_DELAY_MS(10);
-        //Set the color mode to 16-bit
-        displayWriteCommand(ST7789_COLMOD);
-        displayWriteData(0x55);
-        OS_DELAY_MS(10);
-        //Set the memory access control so that
-        //display data comes as row address then
-        //column address
-        //Also sets refresh from bottom to top
-        displayWriteCommand(ST7789_MADCTL);
-        displayWriteData(0x00);
-        //Column address start and end
-        displaySetColumn(ST7789_XSTART,ST7789_WIDTH);
-        //Row address start and end
-        displaySetRow(ST7789_YSTART,ST7789_HEIGHT);
-        //Enable extended command table
-        displayWriteCommand(ST7789_CMD2EN);
-        displayWriteData(0x5A);
-        displayWriteData(0x69);
-        displayWriteData(0x02);
-        displayWriteData(0x01);
-        //Set frame rate to 111 Hz (max)
-        displayWriteCommand(ST7789_FRCTRL2);
-        displayWriteData(0x01);
-        //Set inversion on
-        displayWriteCommand(ST7789_INVON);
-        //Set normal display on
-        displayWriteCommand(ST7789_NORON);
-        OS_DELAY_MS(10);
-        //Turn display on
-        displayWriteCommand(ST7789_DISPON);
-        OS_DELAY_MS(10);
+        displayWriteCommandList(displayInitCommands);
+        displayInvalidateWindowCache();
 
         OS_DELAY_MS(1000); //TODO: CAN THIS BE REDUCED?
         ad_nvms_init();
 }
 void displaySetRotation(int ORIENTATION)
 {
-    displayWriteCommand(ST7789_MADCTL);
+    uint8_t madctl;
     switch(ORIENTATION)
     {
         case 0:
-            displayWriteData(ST7789_MADCTL_MX | ST7789_MADCTL_MY | ST7789_MADCTL_RGB);
+            madctl = ST7789_MADCTL_MX | ST7789_MADCTL_MY | ST7789_MADCTL_RGB;
             break;
         case 1:
-            displayWriteData(ST7789_MADCTL_MY | ST7789_MADCTL_MV | ST7789_MADCTL_RGB);
+            madctl = ST7789_MADCTL_MY | ST7789_MADCTL_MV | ST7789_MADCTL_RGB;
             break;
         case 2:
-            displayWriteData(ST7789_MADCTL_RGB);
+            madctl = ST7789_MADCTL_RGB;
             break;
         case 3:
-            displayWriteData(ST7789_MADCTL_MX | ST7789_MADCTL_MY | ST7789_MADCTL_RGB);
+            madctl = ST7789_MADCTL_MX | ST7789_MADCTL_MY | ST7789_MADCTL_RGB;
             break;
         default:
-            displayWriteData(ST7789_MADCTL_MX | ST7789_MADCTL_MV | ST7789_MADCTL_RGB);
+            madctl = ST7789_MADCTL_MX | ST7789_MADCTL_MV | ST7789_MADCTL_RGB;
             break;
     }
+    displayWriteCommandData(ST7789_MADCTL,&madctl,1);
 }
 void displaySetWindow(int XSTART, int XEND, int YSTART, int YEND)
 {
-    //Set column
-    displaySetColumn(XSTART,XEND);
-    //Set row
-    displaySetRow(YSTART,YEND);
-    //Begin writing frame to RAM
-    displayWriteCommand(ST7789_RAMWR);
+    int windowWidth = displayColumnEnd-displayColumnStart+1;
+    uint32_t pixelsWritten = displayRamBytesWritten/BYTES_PER_PIXEL;
+
+    displayBeginTransaction();
+    //If the last write filled whole rows of the same column range and
+    //stopped right where this window starts, just carry on writing
+    if(displayRamWriteActive&&(displayRamBytesWritten%BYTES_PER_PIXEL==0)&&
+       (XSTART==displayColumnStart)&&(XEND==displayColumnEnd)&&(windowWidth>0)&&
+       (pixelsWritten%windowWidth==0)&&(YSTART==displayRowStart+(int)(pixelsWritten/windowWidth))&&
+       (YEND<=displayRowEnd))
+    {
+        displaySendCommand(ST7789_RAMWRC);
+        displayWindowStats.ramwrcContinues++;
+    }
+    else
+    {
+        //Set column
+        displaySetColumn(XSTART,XEND);
+        //Set row
+        displaySetRow(YSTART,YEND);
+        //Begin writing frame to RAM
+        displaySendCommand(ST7789_RAMWR);
+    }
+    displayEndTransaction();
 }
 void displaySetWindow2(int XSTART, int XEND, int YSTART, int YEND)
 {
-    //Set column
-    displaySetColumn(XSTART,XEND);
-    //Set row
-    displaySetRow(YSTART,YEND);
-    //Begin writing frame to RAM
-    displayWriteCommand(ST7789_RAMWR);
+    displaySetWindow(XSTART,XEND,YSTART,YEND);
 }
 void displaySetColumn(int XSTART, int XEND)
 {
-    uint8_t xStartHigh = XSTART >> 8;
-    uint8_t xStartLow = XSTART & 0xFF;
-    uint8_t xEndHigh = XEND >> 8;
-    uint8_t xEndLow = XEND & 0xFF;
+    uint8_t columnParameters[4];
+    if((XSTART==displayColumnStart)&&(XEND==displayColumnEnd))
+    {
+        displayWindowStats.casetSkipped++;
+        return;
+    }
+    columnParameters[0] = XSTART >> 8;
+    columnParameters[1] = XSTART & 0xFF;
+    columnParameters[2] = XEND >> 8;
+    columnParameters[3] = XEND & 0xFF;
 
     //Set window X dimensions
-    displayWriteCommand(ST7789_CASET);
-    displayWriteData(xStartHigh);
-    displayWriteData(xStartLow);
-    displayWriteData(xEndHigh);
-    displayWriteData(xEndLow);
+    displayWriteCommandData(ST7789_CASET,columnParameters,sizeof(columnParameters));
+    displayColumnStart = XSTART;
+    displayColumnEnd = XEND;
+    displayWindowStats.casetSent++;
 }
 void displaySetRow(int YSTART, int YEND)
 {
+    uint8_t rowParameters[4];
+    if((YSTART==displayRowStart)&&(YEND==displayRowEnd))
+    {
+        displayWindowStats.rasetSkipped++;
+        return;
+    }
+    displayRowStart = YSTART;
+    displayRowEnd = YEND;
     //Add y-offset for display
     YSTART += ST7789_HEIGHT_OFFSET;
     YEND += ST7789_HEIGHT_OFFSET;
 
-    uint8_t yStartHigh = (YSTART) >> 8;
-    uint8_t yStartLow = (YSTART) & 0xFF;
-    uint8_t yEndHigh = (YEND) >> 8;
-    uint8_t yEndLow = (YEND) & 0xFF;
+    rowParameters[0] = YSTART >> 8;
+    rowParameters[1] = YSTART & 0xFF;
+    rowParameters[2] = YEND >> 8;
+    rowParameters[3] = YEND & 0xFF;
 
     //Set window Y dimensions
-    displayWriteCommand(ST7789_RASET);
-    displayWriteData(yStartHigh);
-    displayWriteData(yStartLow);
-    displayWriteData(yEndHigh);
-    displayWriteData(yEndLow);
+    displayWriteCommandData(ST7789_RASET,rowParameters,sizeof(rowParameters));
+    displayWindowStats.rasetSent++;
 }
 int display24to16Color(int COLOR)
 {
@@ -171,61 +417,43 @@ int display24to16Color(int COLOR)
     uint16_t newColor = ((redComponent<<11)|(greenComponent<<5))|(blueComponent);
     return newColor;
 }
+//Mixes two RGB565 colors, ALPHA goes from 0 for all BACKGROUND to 32
+//for all FOREGROUND. Green is moved to the top half so all three
+//channels are scaled with one multiply
+int displayBlendColor(int FOREGROUND, int BACKGROUND, int ALPHA)
+{
+        uint32_t foreground = (FOREGROUND|(FOREGROUND<<16))&0x07E0F81F;
+        uint32_t background = (BACKGROUND|(BACKGROUND<<16))&0x07E0F81F;
+        uint32_t mixed = ((((foreground-background)*ALPHA)>>5)+background)&0x07E0F81F;
+        return (mixed|(mixed>>16))&0xFFFF;
+}
 void displayClear(void)
 {
-    displaySetWindow(ST7789_XSTART,ST7789_WIDTH,ST7789_YSTART,ST7789_HEIGHT);
-    for(int i = 0; i<(ST7789_WIDTH-ST7789_XSTART)*(ST7789_HEIGHT-ST7789_YSTART)*2;i++)
-    {
-        displayWriteData(0x00);
-    }
+    displayFillScreen(DISPLAY_BLACK);
 }
 void displayClearBuf(void)
 {
-    uint8_t writeBuffer[SPI_WRITE_BUFFER_SIZE] = {0};
-    displaySetWindow(ST7789_XSTART,ST7789_WIDTH,ST7789_YSTART,ST7789_HEIGHT);
-    for(int i = 0; i<(((ST7789_WIDTH-ST7789_XSTART)*(ST7789_HEIGHT-ST7789_YSTART)*2)/SPI_WRITE_BUFFER_SIZE);i++)
-    {
-            for(int j=0;j<SPI_WRITE_BUFFER_SIZE;j++)
-            {
-                    writeBuffer[j]=0x00;
-            }
-            displayWriteDataBuf(writeBuffer,SPI_WRITE_BUFFER_SIZE);
-    }
+    displayFillScreen(DISPLAY_BLACK);
 }
 void displayFillScreen(int COLOR)
 {
-    uint8_t colorHigh = COLOR >> 8;
-    uint8_t colorLow = COLOR & 0xFF;
-    displaySetWindow(ST7789_XSTART,ST7789_WIDTH,ST7789_YSTART,ST7789_HEIGHT);
-    for(int i = 0; i<(ST7789_WIDTH-ST7789_XSTART)*(ST7789_HEIGHT-ST7789_YSTART);i++)
+    if(displayListAddRect(ST7789_XSTART,ST7789_WIDTH-1,ST7789_YSTART,ST7789_HEIGHT-1,COLOR))
     {
-        displayWriteData(colorHigh);
-        displayWriteData(colorLow);
+        return;
     }
+    displayFillRect(ST7789_XSTART,ST7789_WIDTH-1,ST7789_YSTART,ST7789_HEIGHT-1,COLOR);
 }
 void displayFillScreenBuf(int COLOR)
 {
-    uint8_t colorHigh = COLOR >> 8;
-    uint8_t colorLow = COLOR & 0xFF;
-    uint8_t writeBuffer[SPI_WRITE_BUFFER_SIZE] = {0};
-    displaySetWindow(ST7789_XSTART,ST7789_WIDTH,ST7789_YSTART,ST7789_HEIGHT);
-    for(int i = 0; i<(((ST7789_WIDTH-ST7789_XSTART)*(ST7789_HEIGHT-ST7789_YSTART)*2)/SPI_WRITE_BUFFER_SIZE);i++)
-    {
-            for(int j=0;j<SPI_WRITE_BUFFER_SIZE-1;j+=2)
-            {
-                    writeBuffer[j]=colorHigh;
-                    writeBuffer[j+1]=colorLow;
-            }
-            displayWriteDataBuf(writeBuffer,SPI_WRITE_BUFFER_SIZE);
-    }
+    displayFillScreen(COLOR);
 }
 void displayDrawPixel(int X_LOCATION, int Y_LOCATION, int COLOR)
 {
-    uint8_t colorHigh = COLOR >> 8;
-    uint8_t colorLow = COLOR & 0xFF;
-    displaySetWindow(X_LOCATION,ST7789_WIDTH-1,Y_LOCATION,ST7789_HEIGHT-1);
-    displayWriteData(colorHigh);
-    displayWriteData(colorLow);
+    if(displayListAddRect(X_LOCATION,X_LOCATION,Y_LOCATION,Y_LOCATION,COLOR))
+    {
+        return;
+    }
+    displaySpanAdd(Y_LOCATION,X_LOCATION,X_LOCATION,COLOR);
 }
 void displayDrawPixelThickness(int X_LOCATION, int Y_LOCATION, int COLOR, int THICKNESS)
 {
@@ -233,158 +461,114 @@ void displayDrawPixelThickness(int X_LOCATION, int Y_LOCATION, int COLOR, int TH
     int pixelXEnd = X_LOCATION + THICKNESS/2;
     int pixelYStart = Y_LOCATION - THICKNESS/2;
     int pixelYEnd = Y_LOCATION + THICKNESS/2;
-    displayDrawRectangle(pixelXStart, pixelXEnd, pixelYStart, pixelYEnd, COLOR);
+    if(displayListAddRect(pixelXStart,pixelXEnd,pixelYStart,pixelYEnd,COLOR))
+    {
+        return;
+    }
+    //As spans so neighbouring dots along a line join up
+    displaySpanBegin();
+    for(int y = pixelYStart; y<=pixelYEnd; y++)
+    {
+        displaySpanAdd(y,pixelXStart,pixelXEnd,COLOR);
+    }
+    displaySpanEnd();
 }
 void displayDrawLine(int START_X, int END_X, int START_Y, int END_Y, int COLOR)
 {
-    int deltaX = absoluteValue(END_X-START_X);
-    int xIncrement = START_X<END_X ? 1 : -1;
-    int deltaY = absoluteValue(END_Y-START_Y);
-    int yIncrement = START_Y<END_Y ? 1 : -1;
-    int lineError = (deltaX>deltaY ? deltaX : -deltaY)/2;
-    int oldLineError;
-
-        for(;;)
-        {
-            displayDrawPixel(START_X,START_Y,COLOR);
-            if (START_X==END_X && START_Y==END_Y) break;
-            oldLineError = lineError;
-            if (oldLineError >-deltaX)
-            {
-                lineError -= deltaY;
-                START_X += xIncrement;
-            }
-            if (oldLineError < deltaY)
-            {
-                lineError += deltaX;
-                START_Y += yIncrement;
-            }
-        }
+    if(displayListAddLine(START_X,END_X,START_Y,END_Y,COLOR,1))
+    {
+        return;
+    }
+    displayDrawLineThickness(START_X,END_X,START_Y,END_Y,COLOR,1);
 }
 void displayDrawLinePolar(int START_X, int START_Y, int RADIUS, int ANGLE, int COLOR)
 {
-    float newAngle = 3.1416*ANGLE/180;
-    int endX = START_X+RADIUS*cos(newAngle);
-    int endY = START_Y+RADIUS*sin(newAngle);
+    int endX = 0;
+    int endY = 0;
+    fixedPolarToCartesian(START_X,START_Y,RADIUS,FIXED_DEGREES(ANGLE),&endX,&endY);
     displayDrawLine(START_X,endX,START_Y,endY,COLOR);
 }
+//Thick lines are filled as one quad, one pixel lines are walked with
+//Bresenham and runs on the same row join up into single spans
 void displayDrawLineThickness(int START_X, int END_X, int START_Y, int END_Y, int COLOR, int THICKNESS)
 {
-    for(int j = THICKNESS/2; j>=0; j--)
+    if(displayListAddLine(START_X,END_X,START_Y,END_Y,COLOR,THICKNESS))
     {
-        for(int i = THICKNESS/2; i>0; i--)
-        {
-            displayDrawLine(START_X-i, END_X-i, START_Y-j, END_Y-j, COLOR);
-        }
-        for(int i = 0; i<THICKNESS/2; i++)
-        {
-            displayDrawLine(START_X+i, END_X+i, START_Y-j, END_Y-j, COLOR);
-        }
+        return;
     }
-    for(int j = 0; j<THICKNESS/2; j++)
+    if(THICKNESS>1)
     {
-        for(int i = THICKNESS/2; i>0; i--)
+        displayFillThickLine(START_X,END_X,START_Y,END_Y,COLOR,THICKNESS);
+        return;
+    }
+    int deltaX = absoluteValue(END_X-START_X);
+    int xIncrement = START_X<END_X ? 1 : -1;
+    int deltaY = absoluteValue(END_Y-START_Y);
+    int yIncrement = START_Y<END_Y ? 1 : -1;
+    int lineError = (deltaX>deltaY ? deltaX : -deltaY)/2;
+    int oldLineError;
+
+    displaySpanBegin();
+    for(;;)
+    {
+        displaySpanAdd(START_Y,START_X,START_X,COLOR);
+        if (START_X==END_X && START_Y==END_Y) break;
+        oldLineError = lineError;
+        if (oldLineError >-deltaX)
         {
-            displayDrawLine(START_X-i, END_X-i, START_Y+j, END_Y+j, COLOR);
+            lineError -= deltaY;
+            START_X += xIncrement;
         }
-        for(int i = 0; i<THICKNESS/2; i++)
+        if (oldLineError < deltaY)
         {
-            displayDrawLine(START_X+i, END_X+i, START_Y+j, END_Y+j, COLOR);
+            lineError += deltaX;
+            START_Y += yIncrement;
         }
     }
+    displaySpanEnd();
 }
+//Steps along x THICKNESS pixels at a time with y carried in Q16
 void displayDrawLineThickness2(int START_X, int END_X, int START_Y, int END_Y, int COLOR, int THICKNESS)
 {
-    float yLength = END_Y - START_Y;
-    float currentYPosition = START_Y;
-    if(END_X>START_X)
+    displaySpanBegin();
+    int xLength = absoluteValue(END_X - START_X);
+    int xDirection = (END_X>START_X) ? 1 : -1;
+    int32_t lineSlope = 0;
+    int32_t currentYPosition = (int32_t)START_Y<<16;
+    if(THICKNESS<1)
     {
-        float xLength = END_X - START_X;
-        float lineSlope = yLength/xLength;
-        for(int i = START_X; i<=END_X; i+=THICKNESS)
-        {
-            displayDrawPixelThickness(i,currentYPosition,COLOR,THICKNESS);
-            currentYPosition += lineSlope;
-        }
+        THICKNESS = 1;
     }
-    else
+    lineSlope = fixedDdaStep(END_Y - START_Y, xLength)*THICKNESS;
+    for(int i = 0; i<=xLength; i+=THICKNESS)
     {
-        float xLength = START_X - END_X;
-        float lineSlope = yLength/xLength;
-        for(int i = START_X; i>=END_X; i-=THICKNESS)
-        {
-            displayDrawPixelThickness(i,currentYPosition,COLOR,THICKNESS);
-            currentYPosition += lineSlope;
-        }
+        displayDrawPixelThickness(START_X+(i*xDirection),(currentYPosition+0x8000)>>16,COLOR,THICKNESS);
+        currentYPosition += lineSlope;
     }
+    displaySpanEnd();
 }
 void displayDrawLinePolarThickness(int START_X, int START_Y, int RADIUS, int ANGLE, int COLOR, int THICKNESS)
 {
-    for(int j = THICKNESS/2; j>=0; j--)
-    {
-        for(int i = THICKNESS/2; i>=0; i--)
-        {
-            displayDrawLinePolar(START_X-i,START_Y-j,RADIUS,ANGLE,COLOR);
-        }
-        for(int i = 0; i<THICKNESS/2; i++)
-        {
-            displayDrawLinePolar(START_X+i,START_Y-j,RADIUS,ANGLE,COLOR);
-        }
-    }
-    for(int j = 0; j<THICKNESS/2; j++)
-    {
-        for(int i = THICKNESS/2; i>=0; i--)
-        {
-            displayDrawLinePolar(START_X-i,START_Y+j,RADIUS,ANGLE,COLOR);
-        }
-        for(int i = 0; i<THICKNESS/2; i++)
-        {
-            displayDrawLinePolar(START_X+i,START_Y+j,RADIUS,ANGLE,COLOR);
-        }
-    }
+    int endX = 0;
+    int endY = 0;
+    fixedPolarToCartesian(START_X,START_Y,RADIUS,FIXED_DEGREES(ANGLE),&endX,&endY);
+    displayDrawLineThickness(START_X,endX,START_Y,endY,COLOR,THICKNESS);
 }
 void displayDrawRectangle(int XSTART, int XEND, int YSTART, int YEND, int COLOR)
 {
-    uint8_t colorHigh = COLOR >> 8;
-    uint8_t colorLow = COLOR & 0xFF;
-    displaySetWindow(XSTART,XEND,YSTART,YEND);
-    for(int i = 0; i<YEND*XEND*2;i++)
+    if(displayListAddRect(XSTART,XEND,YSTART,YEND,COLOR))
     {
-        displayWriteData(colorHigh);
-        displayWriteData(colorLow);
+        return;
     }
+    displayFillRect(XSTART,XEND,YSTART,YEND,COLOR);
 }
 void displayDrawRectangleBuf(int XSTART, int XEND, int YSTART, int YEND, int COLOR)
 {
-    uint8_t colorHigh = COLOR >> 8;
-    uint8_t colorLow = COLOR & 0xFF;
-    uint8_t rectangleWidth = (XEND>XSTART?(XEND-XSTART):(XSTART-XEND));
-    uint8_t rectangleHeight = (YEND>YSTART?(YEND-YSTART):(YSTART-YEND));
-    uint16_t leftOverData = (rectangleWidth*rectangleHeight*2)%SPI_WRITE_BUFFER_SIZE;
-    uint8_t writeBuffer[SPI_WRITE_BUFFER_SIZE] = {0};
-
-    displaySetWindow(XSTART,XEND,YSTART,YEND);
-    for(int i = 0; i<((rectangleWidth*rectangleHeight*2)/SPI_WRITE_BUFFER_SIZE);i++)
-    {
-            for(int j=0;j<SPI_WRITE_BUFFER_SIZE-1;j+=2)
-            {
-                    writeBuffer[j]=colorHigh;
-                    writeBuffer[j+1]=colorLow;
-            }
-            displayWriteDataBuf(writeBuffer,SPI_WRITE_BUFFER_SIZE);
-    }
-    if(leftOverData>0)
-    {
-            for(int k=0;k<leftOverData-1;k+=2)
-            {
-                    writeBuffer[k]=colorHigh;
-                    writeBuffer[k+1]=colorLow;
-            }
-            displayWriteDataBuf(writeBuffer,leftOverData);
-    }
+    displayDrawRectangle(XSTART,XEND,YSTART,YEND,COLOR);
 }
 void displayArrayBuf(int XSTART, int WIDTH, int YSTART, int HEIGHT, int (*ARRAY)[], int SIZE_OF_ARRAY)
 {
+    displayBeginTransaction();
 //    uint16_t sizeOfArray = sizeof((*ARRAY))/sizeof((*ARRAY)[0]);
     uint16_t sizeOfArray = SIZE_OF_ARRAY;
     uint16_t leftOverData = (WIDTH*HEIGHT)%SPI_WRITE_BUFFER_SIZE;
@@ -409,9 +593,15 @@ void displayArrayBuf(int XSTART, int WIDTH, int YSTART, int HEIGHT, int (*ARRAY)
             }
             displayWriteDataBuf(writeBuffer,(2*leftOverData));
     }
+    displayEndTransaction();
 }
 void displayDrawCircle(int CENTER_X, int CENTER_Y, int RADIUS, int COLOR)
 {
+    if(displayListAddCircle(CENTER_X,CENTER_Y,RADIUS,COLOR))
+    {
+        return;
+    }
+    displaySpanBegin();
     int x = RADIUS-1;
     int y = 0;
     int dx = 1;
@@ -420,14 +610,14 @@ void displayDrawCircle(int CENTER_X, int CENTER_Y, int RADIUS, int COLOR)
 
     while(x>=y)
     {
-        displayDrawPixel(CENTER_X-y, CENTER_Y+x, COLOR);
-        displayDrawPixel(CENTER_X+y, CENTER_Y+x, COLOR);
-        displayDrawPixel(CENTER_X-x, CENTER_Y+y, COLOR);
-        displayDrawPixel(CENTER_X+x, CENTER_Y+y, COLOR);
-        displayDrawPixel(CENTER_X-x, CENTER_Y-y, COLOR);
-        displayDrawPixel(CENTER_X+x, CENTER_Y-y, COLOR);
-        displayDrawPixel(CENTER_X-y, CENTER_Y-x, COLOR);
-        displayDrawPixel(CENTER_X+y, CENTER_Y-x, COLOR);
+        displaySpanAdd(CENTER_Y+x,CENTER_X-y,CENTER_X-y,COLOR);
+        displaySpanAdd(CENTER_Y+x,CENTER_X+y,CENTER_X+y,COLOR);
+        displaySpanAdd(CENTER_Y+y,CENTER_X-x,CENTER_X-x,COLOR);
+        displaySpanAdd(CENTER_Y+y,CENTER_X+x,CENTER_X+x,COLOR);
+        displaySpanAdd(CENTER_Y-y,CENTER_X-x,CENTER_X-x,COLOR);
+        displaySpanAdd(CENTER_Y-y,CENTER_X+x,CENTER_X+x,COLOR);
+        displaySpanAdd(CENTER_Y-x,CENTER_X-y,CENTER_X-y,COLOR);
+        displaySpanAdd(CENTER_Y-x,CENTER_X+y,CENTER_X+y,COLOR);
 
         if(err <=0)
         {
@@ -442,9 +632,11 @@ void displayDrawCircle(int CENTER_X, int CENTER_Y, int RADIUS, int COLOR)
             err += dx -(RADIUS<<1);
         }
     }
+    displaySpanEnd();
 }
 void displayTestPattern(void)
 {
+    displayBeginTransaction();
     displaySetWindow(ST7789_XSTART,ST7789_WIDTH,ST7789_YSTART,ST7789_HEIGHT);
     for(int i = 0; i<(ST7789_WIDTH-ST7789_XSTART)*(ST7789_HEIGHT-ST7789_YSTART)*2;i++)
     {
@@ -453,9 +645,11 @@ void displayTestPattern(void)
         displayWriteData(colorHigh);
         displayWriteData(colorLow);
     }
+    displayEndTransaction();
 }
 void displayTestPattern2(void)
 {
+    displayBeginTransaction();
     displaySetWindow(ST7789_XSTART,ST7789_WIDTH,ST7789_YSTART,ST7789_HEIGHT);
     for(int i = 0; i<(ST7789_WIDTH-ST7789_XSTART)*(ST7789_HEIGHT-ST7789_YSTART)*2;i++)
     {
@@ -470,76 +664,358 @@ void displayTestPattern2(void)
             displayWriteData(0x0);
         }
     }
+    displayEndTransaction();
+}
+
+//Where SIZE_IN_BYTES from ADDRESS_IN_MEMORY can be read in place in the
+//memory mapped flash, or NULL if the partition isn't mapped
+static const uint8_t *displayMappedFlash(int ADDRESS_IN_MEMORY, int SIZE_IN_BYTES)
+{
+#if DISPLAY_XIP_BLITS
+        const void *mappedAddress = NULL;
+        nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        if(ad_nvms_get_pointer(flashMemory, ADDRESS_IN_MEMORY, SIZE_IN_BYTES, &mappedAddress)>=SIZE_IN_BYTES)
+        {
+                return mappedAddress;
+        }
+#endif
+        return NULL;
 }
+//DMAs SIZE_IN_BYTES from the mapped flash into the current display
+//window. Nothing is copied so there's no buffer to wait for
+static void displayStreamMapped(const uint8_t *MAPPED_ADDRESS, int SIZE_IN_BYTES)
+{
+        int chunkSize = 0;
 
+        displayBusStats.mappedBytes += SIZE_IN_BYTES;
+        while(SIZE_IN_BYTES>0)
+        {
+                chunkSize = (SIZE_IN_BYTES>DISPLAY_XIP_MAX_TRANSFER)?DISPLAY_XIP_MAX_TRANSFER:SIZE_IN_BYTES;
+                displayWriteDataBufAsync(MAPPED_ADDRESS,chunkSize);
+                MAPPED_ADDRESS += chunkSize;
+                SIZE_IN_BYTES -= chunkSize;
+        }
+}
+//Streams SIZE_IN_BYTES of pixel data from flash into the current
+//display window, straight from the mapped flash when it can be, or
+//else overlapping each flash read with the DMA write of the previous
+//chunk
+void displayStreamFromMemory(int ADDRESS_IN_MEMORY, int SIZE_IN_BYTES)
+{
+        nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        const uint8_t *mappedAddress = displayMappedFlash(ADDRESS_IN_MEMORY,SIZE_IN_BYTES);
+        int currentBuffer = 0;
+        int chunkSize = 0;
+
+        displayBeginTransaction();
+        if(mappedAddress!=NULL)
+        {
+                displayStreamMapped(mappedAddress,SIZE_IN_BYTES);
+                displayEndTransaction();
+                return;
+        }
+        //A previous blit may still own one of the buffers
+        displayWaitDataBuf();
+        while(SIZE_IN_BYTES>0)
+        {
+                chunkSize = (SIZE_IN_BYTES>SPI_WRITE_BUFFER_SIZE)?SPI_WRITE_BUFFER_SIZE:SIZE_IN_BYTES;
+                //The write from this buffer two chunks ago has already been waited on
+                ad_nvms_read(flashMemory, ADDRESS_IN_MEMORY, (uint8 *) displayBlitBuffer[currentBuffer], chunkSize);
+                displayWriteDataBufAsync(displayBlitBuffer[currentBuffer],chunkSize);
+                currentBuffer ^= 1;
+                ADDRESS_IN_MEMORY += chunkSize;
+                SIZE_IN_BYTES -= chunkSize;
+        }
+        displayEndTransaction();
+}
+//Streams ROWS rows of ROW_SIZE_IN_BYTES, STRIDE_IN_BYTES apart in flash,
+//into the current display window. Full width rows are one contiguous
+//read, narrower ones are read exactly and packed tightly into the blit
+//buffers, which only ever go out holding valid pixels
+static void displayStreamRectFromMemory(int ADDRESS_IN_MEMORY, int STRIDE_IN_BYTES, int ROW_SIZE_IN_BYTES, int ROWS)
+{
+        nvms_t flashMemory = NULL;
+        const uint8_t *mappedAddress = NULL;
+        int bytesInBuffer = 0;
+        int currentBuffer = 0;
+
+        if((ROWS<=0)||(ROW_SIZE_IN_BYTES<=0))
+        {
+                return;
+        }
+        if((ROW_SIZE_IN_BYTES==STRIDE_IN_BYTES)||(ROWS==1))
+        {
+                displayStreamFromMemory(ADDRESS_IN_MEMORY,ROWS*ROW_SIZE_IN_BYTES);
+                return;
+        }
+        mappedAddress = displayMappedFlash(ADDRESS_IN_MEMORY,((ROWS-1)*STRIDE_IN_BYTES)+ROW_SIZE_IN_BYTES);
+        displayBeginTransaction();
+        if(mappedAddress!=NULL)
+        {
+                for(int row=0;row<ROWS;row++)
+                {
+                        displayStreamMapped(mappedAddress,ROW_SIZE_IN_BYTES);
+                        mappedAddress += STRIDE_IN_BYTES;
+                }
+                displayEndTransaction();
+                return;
+        }
+        flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        //A previous blit may still own one of the buffers
+        displayWaitDataBuf();
+        for(int row=0;row<ROWS;row++)
+        {
+                if((bytesInBuffer+ROW_SIZE_IN_BYTES)>SPI_WRITE_BUFFER_SIZE)
+                {
+                        //Hand the full buffer to DMA and keep packing rows into the other one
+                        displayWriteDataBufAsync(displayBlitBuffer[currentBuffer],bytesInBuffer);
+                        currentBuffer ^= 1;
+                        bytesInBuffer = 0;
+                }
+                ad_nvms_read(flashMemory, ADDRESS_IN_MEMORY, (uint8 *) &displayBlitBuffer[currentBuffer][bytesInBuffer], ROW_SIZE_IN_BYTES);
+                bytesInBuffer += ROW_SIZE_IN_BYTES;
+                ADDRESS_IN_MEMORY += STRIDE_IN_BYTES;
+        }
+        if(bytesInBuffer>0)
+        {
+                displayWriteDataBufAsync(displayBlitBuffer[currentBuffer],bytesInBuffer);
+        }
+        displayEndTransaction();
+}
+//Decodes PIXEL_COUNT pixels of a compressed image from pixel PIXEL into
+//the current display window, sending each buffer while the next is
+//decoded
+static void displayStreamDecoded(displayImageDecoder_t *DECODER, int PIXEL, int PIXEL_COUNT)
+{
+        int currentBuffer = 0;
+        int chunkPixels = 0;
+
+        displayBeginTransaction();
+        //A previous blit may still own one of the buffers
+        displayWaitDataBuf();
+        while(PIXEL_COUNT>0)
+        {
+                chunkPixels = (PIXEL_COUNT>(SPI_WRITE_BUFFER_SIZE/BYTES_PER_PIXEL))?(SPI_WRITE_BUFFER_SIZE/BYTES_PER_PIXEL):PIXEL_COUNT;
+                displayImageDecode(DECODER,PIXEL,displayBlitBuffer[currentBuffer],chunkPixels);
+                displayWriteDataBufAsync(displayBlitBuffer[currentBuffer],chunkPixels*BYTES_PER_PIXEL);
+                currentBuffer ^= 1;
+                PIXEL += chunkPixels;
+                PIXEL_COUNT -= chunkPixels;
+        }
+        displayEndTransaction();
+}
+//Streams the part of an image that is inside the glass, a window per
+//run of rows that clip to the same columns. Each visible row segment is
+//read from flash, or decoded when DECODER isn't NULL, into the blit
+//buffers and sent while the next is read
+static void displayStreamImageRound(int XSTART, int YSTART, int WIDTH, int HEIGHT, int STRIDE, int DATA_ADDRESS, displayImageDecoder_t *DECODER)
+{
+        int firstRow = (YSTART<ST7789_YSTART)?ST7789_YSTART:YSTART;
+        int lastRow = ((YSTART+HEIGHT-1)>ST7789_HEIGHT-1)?ST7789_HEIGHT-1:(YSTART+HEIGHT-1);
+        int xEnd = ((XSTART+WIDTH-1)>ST7789_WIDTH-1)?ST7789_WIDTH-1:(XSTART+WIDTH-1);
+        int xStart = (XSTART<ST7789_XSTART)?ST7789_XSTART:XSTART;
+        int currentBuffer = 0;
+
+        displayBeginTransaction();
+        //A previous blit may still own one of the buffers
+        displayWaitDataBuf();
+        for(int y=firstRow;y<=lastRow;y++)
+        {
+                int clippedStart = 0;
+                int clippedEnd = 0;
+                int bandEnd = displayBezelClipRows(y,lastRow,xStart,xEnd,&clippedStart,&clippedEnd);
+                int rowSizeInBytes = (clippedEnd-clippedStart+1)*BYTES_PER_PIXEL;
+                int bytesInBuffer = 0;
+                if(clippedStart>clippedEnd)
+                {
+                        y = bandEnd;
+                        continue;
+                }
+                displaySetWindow(clippedStart,clippedEnd,y,bandEnd);
+                if(DECODER==NULL)
+                {
+                        displayStreamRectFromMemory(DATA_ADDRESS+((((y-YSTART)*STRIDE)+(clippedStart-XSTART))*BYTES_PER_PIXEL),
+                                                    STRIDE*BYTES_PER_PIXEL,rowSizeInBytes,bandEnd-y+1);
+                        y = bandEnd;
+                        continue;
+                }
+                for(;y<=bandEnd;y++)
+                {
+                        if((bytesInBuffer+rowSizeInBytes)>SPI_WRITE_BUFFER_SIZE)
+                        {
+                                displayWriteDataBufAsync(displayBlitBuffer[currentBuffer],bytesInBuffer);
+                                currentBuffer ^= 1;
+                                bytesInBuffer = 0;
+                        }
+                        displayImageDecode(DECODER,((y-YSTART)*STRIDE)+(clippedStart-XSTART),
+                                           &displayBlitBuffer[currentBuffer][bytesInBuffer],clippedEnd-clippedStart+1);
+                        bytesInBuffer += rowSizeInBytes;
+                }
+                y = bandEnd;
+                displayWriteDataBufAsync(displayBlitBuffer[currentBuffer],bytesInBuffer);
+                currentBuffer ^= 1;
+        }
+        displayEndTransaction();
+}
+//Draws a whole image whose size is known. Raw rows are STRIDE pixels
+//apart, compressed ones are decoded by DECODER
+static void displaySizedImage(int XSTART, int YSTART, int WIDTH, int HEIGHT, int STRIDE, int ADDRESS_IN_MEMORY, displayImageDecoder_t *DECODER)
+{
+        if(displayListAddImage(XSTART,YSTART,0,0,WIDTH,HEIGHT,STRIDE,ADDRESS_IN_MEMORY))
+        {
+                return;
+        }
+        if(displayIsRoundMask())
+        {
+                displayStreamImageRound(XSTART,YSTART,WIDTH,HEIGHT,STRIDE,ADDRESS_IN_MEMORY+2,DECODER);
+                return;
+        }
+
+        displayBeginTransaction();
+        displaySetWindow(XSTART,(XSTART+WIDTH-1),YSTART,YSTART+HEIGHT-1);
+        if(DECODER!=NULL)
+        {
+                displayStreamDecoded(DECODER,0,WIDTH*HEIGHT);
+        }
+        else
+        {
+                displayStreamRectFromMemory(ADDRESS_IN_MEMORY+2,STRIDE*BYTES_PER_PIXEL,WIDTH*BYTES_PER_PIXEL,HEIGHT);
+        }
+        displayEndTransaction();
+}
+//Draws part of an image whose stride is known
+static void displayPartialImage(int SCREEN_XSTART, int SCREEN_YSTART, int IMAGE_XSTART, int IMAGE_YSTART, int IMAGE_PARTIAL_WIDTH, int IMAGE_PARTIAL_HEIGHT,
+                                int STRIDE, int ADDRESS_IN_MEMORY, displayImageDecoder_t *DECODER)
+{
+        if(displayListAddImage(SCREEN_XSTART,SCREEN_YSTART,IMAGE_XSTART,IMAGE_YSTART,IMAGE_PARTIAL_WIDTH,IMAGE_PARTIAL_HEIGHT,STRIDE,ADDRESS_IN_MEMORY))
+        {
+                return;
+        }
+        int partialImageAdressDataOffset = (STRIDE*IMAGE_YSTART*BYTES_PER_PIXEL)+(IMAGE_XSTART*BYTES_PER_PIXEL)+2+ADDRESS_IN_MEMORY;
+        int rowSizeInBytes = IMAGE_PARTIAL_WIDTH*BYTES_PER_PIXEL;
+        int bytesInBuffer = 0;
+        int currentBuffer = 0;
+
+        displayBeginTransaction();
+        displaySetWindow(SCREEN_XSTART,(SCREEN_XSTART+IMAGE_PARTIAL_WIDTH-1),SCREEN_YSTART,(SCREEN_YSTART+IMAGE_PARTIAL_HEIGHT-1));
+        if(DECODER==NULL)
+        {
+                displayStreamRectFromMemory(partialImageAdressDataOffset,STRIDE*BYTES_PER_PIXEL,rowSizeInBytes,IMAGE_PARTIAL_HEIGHT);
+                displayEndTransaction();
+                return;
+        }
+        //A previous blit may still own one of the buffers
+        displayWaitDataBuf();
+        for(int currentRow = 0;currentRow<(IMAGE_PARTIAL_HEIGHT);currentRow++)
+        {
+                if((bytesInBuffer+rowSizeInBytes)>SPI_WRITE_BUFFER_SIZE)
+                {
+                        //Hand the full buffer to DMA and keep packing rows into the other one
+                        displayWriteDataBufAsync(displayBlitBuffer[currentBuffer],bytesInBuffer);
+                        currentBuffer ^= 1;
+                        bytesInBuffer = 0;
+                }
+                displayImageDecode(DECODER,((IMAGE_YSTART+currentRow)*STRIDE)+IMAGE_XSTART,
+                                   &displayBlitBuffer[currentBuffer][bytesInBuffer],IMAGE_PARTIAL_WIDTH);
+                bytesInBuffer += rowSizeInBytes;
+        }
+        if(bytesInBuffer>0)
+        {
+                displayWriteDataBufAsync(displayBlitBuffer[currentBuffer],bytesInBuffer);
+        }
+        displayEndTransaction();
+}
 void displayImageFromMemory(int XSTART, int YSTART, int ADDRESS_IN_MEMORY)
 {
-        OS_TICK_TIME xNextWakeTime;
-        xNextWakeTime = OS_GET_TICK_COUNT();
         uint8_t sizeOfImageBuffer[2]={0};
         nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
         ad_nvms_read(flashMemory, ADDRESS_IN_MEMORY, (uint8 *) sizeOfImageBuffer, sizeof(sizeOfImageBuffer));
-        int imageAdressDataOffset = ADDRESS_IN_MEMORY+2;
         int widthOfImage = sizeOfImageBuffer[0];
         int heightOfImage = sizeOfImageBuffer[1];
-        int sizeOfImageInBytes = widthOfImage*heightOfImage*2;
-        int leftOverData = sizeOfImageInBytes%SPI_WRITE_BUFFER_SIZE;
-        int currentPositionInData = 0;
-
-        uint8_t writeBuffer[SPI_WRITE_BUFFER_SIZE] = {0};
-        displaySetWindow(XSTART,(XSTART+widthOfImage),YSTART,YSTART+heightOfImage);
-        for(int i = 0; i<(sizeOfImageInBytes/SPI_WRITE_BUFFER_SIZE);i++)
-        {
-                ad_nvms_read(flashMemory, ((i*SPI_WRITE_BUFFER_SIZE)+imageAdressDataOffset), (uint8 *) writeBuffer, sizeof(writeBuffer));
-                displayWriteDataBuf(writeBuffer,SPI_WRITE_BUFFER_SIZE);
-                currentPositionInData = i*SPI_WRITE_BUFFER_SIZE;
-        }
-        if(leftOverData>0)
+        int strideOfImage = widthOfImage+(widthOfImage%2);
+        displayImageDecoder_t *decoder = NULL;
+        if(widthOfImage==0)
         {
-                ad_nvms_read(flashMemory, (currentPositionInData+SPI_WRITE_BUFFER_SIZE+imageAdressDataOffset), (uint8 *) writeBuffer, sizeof(writeBuffer));
-                displayWriteDataBuf(writeBuffer,leftOverData);
+                //Compressed, the size is in the longer header
+                decoder = displayImageOpen(ADDRESS_IN_MEMORY);
+                if(decoder==NULL)
+                {
+                        return;
+                }
+                widthOfImage = decoder->width;
+                heightOfImage = decoder->height;
+                strideOfImage = widthOfImage;
         }
+        displaySizedImage(XSTART,YSTART,widthOfImage,heightOfImage,strideOfImage,ADDRESS_IN_MEMORY,decoder);
+}
+//Same as displayImageFromMemory for an image whose size the caller
+//already has, e.g. from a glyph table, so the pixels come out of
+//flash in one read with no header read in front
+void displaySizedImageFromMemory(int XSTART, int YSTART, int WIDTH, int HEIGHT, int ADDRESS_IN_MEMORY)
+{
+        displaySizedImage(XSTART,YSTART,WIDTH,HEIGHT,WIDTH,ADDRESS_IN_MEMORY,NULL);
 }
-
 void displayPartialImageFromMemory(int SCREEN_XSTART, int SCREEN_YSTART, int IMAGE_XSTART, int IMAGE_YSTART, int IMAGE_PARTIAL_WIDTH, int IMAGE_PARTIAL_HEIGHT, int ADDRESS_IN_MEMORY)
 {
-        OS_TICK_TIME xNextWakeTime;
-        xNextWakeTime = OS_GET_TICK_COUNT();
         nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
         uint8_t sizeOfImageBuffer[2]={0};
         ad_nvms_read(flashMemory, ADDRESS_IN_MEMORY, (uint8 *) sizeOfImageBuffer, sizeof(sizeOfImageBuffer));
         int widthOfImage = sizeOfImageBuffer[0];
-        if(widthOfImage%2)
+        displayImageDecoder_t *decoder = NULL;
+        if(widthOfImage==0)
+        {
+                decoder = displayImageOpen(ADDRESS_IN_MEMORY);
+                if(decoder==NULL)
+                {
+                        return;
+                }
+                widthOfImage = decoder->width;
+        }
+        else if(widthOfImage%2)
         {
                 widthOfImage++;
         }
-        int partialImageAdressDataOffset = (widthOfImage*IMAGE_YSTART*BYTES_PER_PIXEL)+(IMAGE_XSTART*BYTES_PER_PIXEL)+2+ADDRESS_IN_MEMORY;
-        int bufferCounter = 0;
-        int memoryReadSpot = 0;
-        uint8_t writeBuffer[SPI_WRITE_BUFFER_SIZE] = {0};
-        uint8_t partialImageWidthBuffer[(ST7789_WIDTH*BYTES_PER_PIXEL)] = {0};
-        displaySetWindow(SCREEN_XSTART,(SCREEN_XSTART+IMAGE_PARTIAL_WIDTH-1),SCREEN_YSTART,(SCREEN_YSTART+IMAGE_PARTIAL_HEIGHT));
-
-        for(int currentRow = 0;currentRow<(IMAGE_PARTIAL_HEIGHT);currentRow++)
+        displayPartialImage(SCREEN_XSTART,SCREEN_YSTART,IMAGE_XSTART,IMAGE_YSTART,IMAGE_PARTIAL_WIDTH,IMAGE_PARTIAL_HEIGHT,
+                            widthOfImage,ADDRESS_IN_MEMORY,decoder);
+}
+//Opens an image asset for drawing, NULL for a raw one. The directory
+//says what format it is, so nothing is read to find out
+static bool displayAssetImageOpen(const displayAsset_t *ASSET, displayImageDecoder_t **DECODER)
+{
+        *DECODER = NULL;
+        if(ASSET==NULL)
         {
-                memoryReadSpot = (currentRow*(widthOfImage)*BYTES_PER_PIXEL)+partialImageAdressDataOffset;
-                ad_nvms_read(flashMemory,memoryReadSpot, (uint8 *)partialImageWidthBuffer, sizeof(partialImageWidthBuffer));
-                if(((bufferCounter*(IMAGE_PARTIAL_WIDTH*BYTES_PER_PIXEL))+(IMAGE_PARTIAL_WIDTH*BYTES_PER_PIXEL))>SPI_WRITE_BUFFER_SIZE)
-                {
-                        memcpy(writeBuffer, partialImageWidthBuffer, IMAGE_PARTIAL_WIDTH*BYTES_PER_PIXEL);
-                        displayWriteDataBuf(writeBuffer,SPI_WRITE_BUFFER_SIZE);
-                        bufferCounter = 0;
-                }
-                else
-                {
-                        memcpy(&writeBuffer[((bufferCounter)*(IMAGE_PARTIAL_WIDTH*BYTES_PER_PIXEL))], partialImageWidthBuffer, IMAGE_PARTIAL_WIDTH*BYTES_PER_PIXEL);
-                        bufferCounter++;
-                }
+                return false;
+        }
+        if((ASSET->format==DISPLAY_IMAGE_FORMAT_RLE16)||(ASSET->format==DISPLAY_IMAGE_FORMAT_INDEXED))
+        {
+                *DECODER = displayImageOpen(displayAssetFlashAddress(ASSET));
+                return *DECODER!=NULL;
+        }
+        return ASSET->format==DISPLAY_IMAGE_FORMAT_RAW;
+}
+//Draws an image from the asset pack. The size comes from the directory
+//so raw images can be wider or taller than their header can say
+void displayImageFromAsset(int XSTART, int YSTART, uint32_t ASSET_ID)
+{
+        const displayAsset_t *asset = displayAssetFind(ASSET_ID);
+        displayImageDecoder_t *decoder = NULL;
+        if(!displayAssetImageOpen(asset,&decoder))
+        {
+                return;
         }
-        if(bufferCounter>0)
+        displaySizedImage(XSTART,YSTART,asset->width,asset->height,asset->stride,displayAssetFlashAddress(asset),decoder);
+}
+void displayPartialImageFromAsset(int SCREEN_XSTART, int SCREEN_YSTART, int IMAGE_XSTART, int IMAGE_YSTART, int IMAGE_PARTIAL_WIDTH, int IMAGE_PARTIAL_HEIGHT, uint32_t ASSET_ID)
+{
+        const displayAsset_t *asset = displayAssetFind(ASSET_ID);
+        displayImageDecoder_t *decoder = NULL;
+        if(!displayAssetImageOpen(asset,&decoder))
         {
-                displayWriteDataBuf(writeBuffer,(bufferCounter*(IMAGE_PARTIAL_WIDTH*BYTES_PER_PIXEL)));
+                return;
         }
+        displayPartialImage(SCREEN_XSTART,SCREEN_YSTART,IMAGE_XSTART,IMAGE_YSTART,IMAGE_PARTIAL_WIDTH,IMAGE_PARTIAL_HEIGHT,
+                            asset->stride,displayAssetFlashAddress(asset),decoder);
 }
 
 /*int getSizeOfImage(char *FILENAME, int NAME_SIZE)
@@ -8,7 +8,16 @@
 #ifndef DISPLAYDRIVER_H_
 #define DISPLAYDRIVER_H_
 
+#include <stdint.h>
+
 #define SPI_WRITE_BUFFER_SIZE 2880 //240*240*2/40 = 2880 which is also 6 lines per write
+#define DISPLAY_BLIT_BUFFERS 2 //Ping-pong buffers for streaming from flash
+//Blits DMA straight out of the memory mapped flash when the partition
+//allows it, set from the build config
+#ifndef DISPLAY_XIP_BLITS
+#define DISPLAY_XIP_BLITS 0
+#endif
+#define DISPLAY_XIP_MAX_TRANSFER 32768 //DMA length register is 16 bits
 
 #define SPI_DELAY       0
 
@@ -58,6 +67,9 @@
 #define ST7789_WRDISBV 0X51
 #define ST7789_WRCTRLD 0X53
 
+//Command list flag, a delay in ms follows the parameters
+#define ST7789_CMD_DELAY    0x80
+
 //Display orientations
 #define ST7789_MADCTL_MY  0x80
 #define ST7789_MADCTL_MX  0x40
@@ -81,16 +93,49 @@
 #define BITMAP_WIDTH_OFFSET 0x0012
 #define BITMAP_HEIGHT_OFFSET 0x0016
 
+//Display bus counters
+typedef struct
+{
+        uint32_t busOpens;
+        uint32_t commands;
+        uint32_t dataWrites;
+        uint32_t dataBytes;
+        uint32_t mappedBytes;
+} displayBusStats_t;
+
+//Window setup counters
+typedef struct
+{
+        uint32_t casetSent;
+        uint32_t casetSkipped;
+        uint32_t rasetSent;
+        uint32_t rasetSkipped;
+        uint32_t ramwrcContinues;
+} displayWindowStats_t;
+
 void displayInit(void);
+void displayBeginTransaction(void);
+void displayEndTransaction(void);
 void displayWriteCommand(int COMMAND);
 void displayWriteData(int DATA);
 void displayWriteDataBuf(uint8_t DATA[], int DATA_SIZE);
+void displayWriteDataBufAsync(const uint8_t DATA[], int DATA_SIZE);
+void displayWaitDataBuf(void);
+uint8_t *displayGetBlitBuffer(int INDEX);
+void displayWriteCommandData(int COMMAND, const uint8_t PARAMETERS[], int PARAMETER_COUNT);
+void displayWriteCommandList(const uint8_t COMMAND_LIST[]);
+void displayGetBusStats(displayBusStats_t *STATS);
+void displayResetBusStats(void);
+void displayGetWindowStats(displayWindowStats_t *STATS);
+void displayResetWindowStats(void);
+void displayInvalidateWindowCache(void);
 void displaySetRotation(int ORIENTATION);
 void displaySetColumn(int XSTART, int XEND);
 void displaySetRow(int YSTART, int YEND);
 void displaySetWindow(int XSTART, int XEND, int YSTART, int YEND);
 void displaySetWindow2(int XSTART, int XEND, int YSTART, int YEND);
 int  display24to16Color(int COLOR);
+int  displayBlendColor(int FOREGROUND, int BACKGROUND, int ALPHA);
 void displayClear(void);
 void displayClearBuf(void);
 void displayFillScreen(int COLOR);
@@ -108,8 +153,12 @@ void displayDrawCircle(int CENTER_X, int CENTER_Y, int RADIUS, int COLOR);
 void displayTestPattern(void);
 void displayTestPattern2(void);
 void displayArrayBuf(int XSTART, int WIDTH, int YSTART, int HEIGHT, int (*ARRAY)[], int SIZE_OF_ARRAY);
+void displayStreamFromMemory(int ADDRESS_IN_MEMORY, int SIZE_IN_BYTES);
 void displayImageFromMemory(int XSTART, int YSTART, int ADDRESS_IN_MEMORY);
+void displaySizedImageFromMemory(int XSTART, int YSTART, int WIDTH, int HEIGHT, int ADDRESS_IN_MEMORY);
 void displayPartialImageFromMemory(int SCREEN_XSTART, int SCREEN_YSTART, int IMAGE_XSTART, int IMAGE_YSTART, int IMAGE_PARTIAL_WIDTH, int IMAGE_PARTIAL_HEIGHT, int ADDRESS_IN_MEMORY);
+void displayImageFromAsset(int XSTART, int YSTART, uint32_t ASSET_ID);
+void displayPartialImageFromAsset(int SCREEN_XSTART, int SCREEN_YSTART, int IMAGE_XSTART, int IMAGE_YSTART, int IMAGE_PARTIAL_WIDTH, int IMAGE_PARTIAL_HEIGHT, uint32_t ASSET_ID);
 
 /*int getSizeOfImage(char *FILENAME, int NAME_SIZE);
 int getDataOffsetBMP(char *FILENAME, int NAME_SIZE);
@@ -8,433 +8,55 @@
 
 #include "displayFonts.h"
 #include "displayDriver.h"
-#include "imageOffsets.h"
+#include "displayGlyphs.h"
+#include "displayList.h"
+#include "displayText.h"
+#include "displayBezel.h"
 #include "math.h"
 
 int displayDrawCharacter(int X_START, int Y_START, char CHARACTER)
 {
-    int letterWidth = 0;
-    switch(CHARACTER)
-    {
-        case 'A':
-                displayPartialImageFromMemory(X_START,Y_START,0,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 10;
-                break;
-        case 'a':
-                displayPartialImageFromMemory(X_START,Y_START,0,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case 'B':
-                displayPartialImageFromMemory(X_START,Y_START,15,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case 'b':
-                displayPartialImageFromMemory(X_START,Y_START,15,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case 'C':
-                displayPartialImageFromMemory(X_START,Y_START,30,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 10;
-                break;
-        case 'c':
-                displayPartialImageFromMemory(X_START,Y_START,30,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 7;
-                break;
-        case 'D':
-                displayPartialImageFromMemory(X_START,Y_START,45,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case 'd':
-                displayPartialImageFromMemory(X_START,Y_START,45,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case 'E':
-                displayPartialImageFromMemory(X_START,Y_START,60,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 7;
-                break;
-        case 'e':
-                displayPartialImageFromMemory(X_START,Y_START,60,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case 'F':
-                displayPartialImageFromMemory(X_START,Y_START,75,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 6;
-                break;
-        case 'f':
-                displayPartialImageFromMemory(X_START,Y_START,75,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 5;
-                break;
-        case 'G':
-                displayPartialImageFromMemory(X_START,Y_START,90,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 10;
-                break;
-        case 'g':
-                displayPartialImageFromMemory(X_START,Y_START,90,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case 'H':
-                displayPartialImageFromMemory(X_START,Y_START,105,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 10;
-                break;
-        case 'h':
-                displayPartialImageFromMemory(X_START,Y_START,105,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 7;
-                break;
-        case 'I':
-                displayPartialImageFromMemory(X_START,Y_START,120,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 2;
-                break;
-        case 'i':
-                displayPartialImageFromMemory(X_START,Y_START,120,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 2;
-                break;
-        case 'J':
-                displayPartialImageFromMemory(X_START,Y_START,135,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 5;
-                break;
-        case 'j':
-                displayPartialImageFromMemory(X_START,Y_START,135,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 4;
-                break;
-        case 'K':
-                displayPartialImageFromMemory(X_START,Y_START,150,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 10;
-                break;
-        case 'k':
-                displayPartialImageFromMemory(X_START,Y_START,150,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case 'L':
-                displayPartialImageFromMemory(X_START,Y_START,165,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 7;
-                break;
-        case 'l':
-                displayPartialImageFromMemory(X_START,Y_START,165,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 2;
-                break;
-        case 'M':
-                displayPartialImageFromMemory(X_START,Y_START,180,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 12;
-                break;
-        case 'm':
-                displayPartialImageFromMemory(X_START,Y_START,180,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 14;
-                break;
-        case 'N':
-                displayPartialImageFromMemory(X_START,Y_START,0,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 10;
-                break;
-        case 'n':
-                displayPartialImageFromMemory(X_START,Y_START,0,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case 'O':
-                displayPartialImageFromMemory(X_START,Y_START,15,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 11;
-                break;
-        case 'o':
-                displayPartialImageFromMemory(X_START,Y_START,15,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case 'P':
-                displayPartialImageFromMemory(X_START,Y_START,30,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case 'p':
-                displayPartialImageFromMemory(X_START,Y_START,30,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case 'Q':
-                displayPartialImageFromMemory(X_START,Y_START,45,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 11;
-                break;
-        case 'q':
-                displayPartialImageFromMemory(X_START,Y_START,45,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case 'R':
-                displayPartialImageFromMemory(X_START,Y_START,60,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case 'r':
-                displayPartialImageFromMemory(X_START,Y_START,60,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 5;
-                break;
-        case 'S':
-                displayPartialImageFromMemory(X_START,Y_START,75,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case 's':
-                displayPartialImageFromMemory(X_START,Y_START,75,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 7;
-                break;
-        case 'T':
-                displayPartialImageFromMemory(X_START,Y_START,90,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case 't':
-                displayPartialImageFromMemory(X_START,Y_START,90,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 6;
-                break;
-        case 'U':
-                displayPartialImageFromMemory(X_START,Y_START,105,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case 'u':
-                displayPartialImageFromMemory(X_START,Y_START,105,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case 'V':
-                displayPartialImageFromMemory(X_START,Y_START,120,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 11;
-                break;
-        case 'v':
-                displayPartialImageFromMemory(X_START,Y_START,120,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case 'W':
-                displayPartialImageFromMemory(X_START,Y_START,135,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 15;
-                break;
-        case 'w':
-                displayPartialImageFromMemory(X_START,Y_START,135,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 12;
-                break;
-        case 'X':
-                displayPartialImageFromMemory(X_START,Y_START,150,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 10;
-                break;
-        case 'x':
-                displayPartialImageFromMemory(X_START,Y_START,150,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case 'Y':
-                displayPartialImageFromMemory(X_START,Y_START,165,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 11;
-                break;
-        case 'y':
-                displayPartialImageFromMemory(X_START,Y_START,165,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case 'Z':
-                displayPartialImageFromMemory(X_START,Y_START,180,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case 'z':
-                displayPartialImageFromMemory(X_START,Y_START,180,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 6;
-                break;
-        case '1':
-                displayPartialImageFromMemory(X_START,Y_START,0,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 5;
-                break;
-        case '2':
-                displayPartialImageFromMemory(X_START,Y_START,15,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case '3':
-                displayPartialImageFromMemory(X_START,Y_START,30,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case '4':
-                displayPartialImageFromMemory(X_START,Y_START,45,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case '5':
-                displayPartialImageFromMemory(X_START,Y_START,60,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case '6':
-                displayPartialImageFromMemory(X_START,Y_START,75,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case '7':
-                displayPartialImageFromMemory(X_START,Y_START,90,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 7;
-                break;
-        case '8':
-                displayPartialImageFromMemory(X_START,Y_START,105,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case '9':
-                displayPartialImageFromMemory(X_START,Y_START,120,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case '0':
-                displayPartialImageFromMemory(X_START,Y_START,135,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case '.':
-                displayPartialImageFromMemory(X_START,Y_START,0,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 2;
-                break;
-        case ',':
-                displayPartialImageFromMemory(X_START,Y_START,15,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 2;
-                break;
-        case '!':
-                displayPartialImageFromMemory(X_START,Y_START,30,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 2;
-                break;
-        case '?':
-                displayPartialImageFromMemory(X_START,Y_START,45,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 8;
-                break;
-        case ':':
-                displayPartialImageFromMemory(X_START,Y_START,60,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 2;
-                break;
-        case '/':
-                displayPartialImageFromMemory(X_START,Y_START,75,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 6;
-                break;
-        case '"':
-                displayPartialImageFromMemory(X_START,Y_START,90,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 6;
-                break;
-        case '\'':
-                displayPartialImageFromMemory(X_START,Y_START,105,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 2;
-                break;
-        case '(':
-                displayPartialImageFromMemory(X_START,Y_START,120,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 4;
-                break;
-        case ')':
-                displayPartialImageFromMemory(X_START,Y_START,135,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 4;
-                break;
-        case '#':
-                displayPartialImageFromMemory(X_START,Y_START,150,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case '$':
-                displayPartialImageFromMemory(X_START,Y_START,165,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 9;
-                break;
-        case '@':
-                displayPartialImageFromMemory(X_START,Y_START,180,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,FONT_OFFSET);
-                letterWidth = 15;
-                break;
-        default:
-                letterWidth = 5;
-        break;
-    }
-    return letterWidth;
+    return displayGlyphDraw(X_START,Y_START,(uint8_t)CHARACTER);
 }
-int setCircularMargin(int CURRENT_Y_POSITION)
-{
-    int minimumCircularMargin = 80;
-    int xMargin = 0;
+//Characters drawn between these are put together in RAM and go to the
+//panel under one window when the line ends, gaps and all, instead of a
+//window and a transfer per character. Inside a recording that is
+//already going, e.g. text over the watch face, they just join it
+static bool displayTextLineIsOpen = false;
 
-    if(CURRENT_Y_POSITION<=20||CURRENT_Y_POSITION>=220)
-    {
-        xMargin = minimumCircularMargin*9/10;
-    }
-    else if(CURRENT_Y_POSITION<=40||CURRENT_Y_POSITION>=200)
-    {
-        xMargin = minimumCircularMargin*6/10;
-    }
-    else if(CURRENT_Y_POSITION<=60||CURRENT_Y_POSITION>=180)
-    {
-        xMargin = minimumCircularMargin*4/10;
-    }
-    else if(CURRENT_Y_POSITION<=80||CURRENT_Y_POSITION>=160)
-    {
-        xMargin = minimumCircularMargin*3/10;
-    }
-    else if(CURRENT_Y_POSITION<=100||CURRENT_Y_POSITION>=140)
+void displayTextLineBegin(void)
+{
+    if(!displayListIsRecording())
     {
-        xMargin = minimumCircularMargin*2/10;
+        displayListBegin(displayGlyphBackground());
+        displayTextLineIsOpen = true;
     }
-    else
+}
+void displayTextLineEnd(void)
+{
+    if(displayTextLineIsOpen)
     {
-        xMargin = minimumCircularMargin*1/10;
+        displayListEnd();
+        displayTextLineIsOpen = false;
     }
-    return xMargin;
+}
+//How far in from the edges a line of text starting at this row has to
+//start so none of it is behind the bezel
+int setCircularMargin(int CURRENT_Y_POSITION)
+{
+    return displayBezelInsetForRows(CURRENT_Y_POSITION,CURRENT_Y_POSITION+FONT_CHARACTER_HEIGHT-1);
 }
 void displayDrawString(int X_START, int Y_START, int KERNING_SIZE, int MARGIN, int POINTER_TO_STRING)
 {
-    char stringToWrite[255]={NULL};
-    strncpy(stringToWrite,POINTER_TO_STRING,255);
-    int numberOfCharacters = 0;
-    int stringLength = strlen(stringToWrite);
-    int currentXLocation = X_START;
-    int currentYLocation = Y_START;
-    int nextSpaceCount = 0;
-    int xMargin = 0;
-    int letterSize = FONT_CHARACTER_WIDTH;
-
-    int minimumCircularMargin = 20;
-
-    if(Y_START<MARGIN+minimumCircularMargin)
-    {
-        currentYLocation = MARGIN+minimumCircularMargin;
-    }
-
-    xMargin = setCircularMargin(currentYLocation)+MARGIN;
-
-    if(X_START<xMargin)
-    {
-        currentXLocation = xMargin;
-    }
-    while(numberOfCharacters!=stringLength)
-    {
-        if(stringToWrite[numberOfCharacters]==' ')
-        {
-            nextSpaceCount = 0;
-            for(int nextSpaceLocation = 1; nextSpaceLocation<(stringLength-numberOfCharacters);nextSpaceLocation++)
-            {
-                if(stringToWrite[numberOfCharacters+nextSpaceLocation]==' ')
-                {
-                    break;
-                }
-                nextSpaceCount++;
-            }
-            //Check if the next space comes after the text reaches the edge of the writing area
-            if(((currentXLocation+(nextSpaceCount*(FONT_CHARACTER_WIDTH+KERNING_SIZE)))>(ST7789_WIDTH-xMargin))||(nextSpaceCount==(stringLength-numberOfCharacters)))
-            {
-                numberOfCharacters++;
-                currentYLocation += FONT_CHARACTER_HEIGHT;
-                if((currentYLocation+FONT_CHARACTER_HEIGHT+MARGIN+minimumCircularMargin)>ST7789_HEIGHT)
-                {
-                    break;
-                }
-                xMargin = setCircularMargin(currentYLocation)+MARGIN;
-                if(X_START>xMargin)
-                {
-                    currentXLocation = X_START;
-                }
-                else
-                {
-                    currentXLocation = xMargin;
-                }
-            }
-        }
-        if(((currentXLocation+(FONT_CHARACTER_WIDTH+KERNING_SIZE)+xMargin)>ST7789_WIDTH)&&(stringToWrite[numberOfCharacters]==' '))
-        {
-            currentYLocation += FONT_CHARACTER_HEIGHT;
-            if((currentYLocation+FONT_CHARACTER_HEIGHT+MARGIN+minimumCircularMargin)>ST7789_HEIGHT)
-            {
-                break;
-            }
-            xMargin = setCircularMargin(currentYLocation)+MARGIN;
-            if(X_START>xMargin)
-            {
-                currentXLocation = X_START;
-            }
-            else
-            {
-                currentXLocation = xMargin;
-            }
-        }
-        else
-        {
-            letterSize = displayDrawCharacter(currentXLocation, currentYLocation, stringToWrite[numberOfCharacters]);
-            currentXLocation += (letterSize+KERNING_SIZE);
-        }
-        numberOfCharacters++;
-    }
+    displayDrawStringPage(X_START,Y_START,KERNING_SIZE,MARGIN,POINTER_TO_STRING,0);
+}
+//Draws one screenful of a string, returns how many there are. Pages of
+//the same string are laid out once and drawn from the cached layout
+int displayDrawStringPage(int X_START, int Y_START, int KERNING_SIZE, int MARGIN, int POINTER_TO_STRING, int PAGE)
+{
+    const displayTextLayout_t *layout = displayTextGetLayout((const char *)POINTER_TO_STRING,X_START,Y_START,KERNING_SIZE,MARGIN,DISPLAY_TEXT_MAX_LINES);
+    displayTextDrawPage(layout,PAGE);
+    return displayTextPageCount(layout);
 }
 /*
 void displayDrawCharacter(int X_START, int Y_START, int SIZE, int COLOR, char CHARACTER)
@@ -14,7 +14,10 @@
 #define FONT_CHARACTERS_ROWS 6
 
 int displayDrawCharacter(int X_START, int Y_START, char CHARACTER);
+void displayTextLineBegin(void);
+void displayTextLineEnd(void);
 void displayDrawString(int X_START, int Y_START, int KERNING_SIZE, int MARGIN, int POINTER_TO_STRING);
+int displayDrawStringPage(int X_START, int Y_START, int KERNING_SIZE, int MARGIN, int POINTER_TO_STRING, int PAGE);
 int setCircularMargin(int CURRENT_Y_POSITION);
 
 #endif /* DISPLAYFONTS_H_ */
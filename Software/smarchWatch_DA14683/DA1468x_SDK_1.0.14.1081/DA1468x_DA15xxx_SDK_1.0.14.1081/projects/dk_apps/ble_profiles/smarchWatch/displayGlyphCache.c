@@ -0,0 +1,106 @@
+/*
+ * displayGlyphCache.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "ad_nvms.h"
+#include "displayGlyphCache.h"
+
+//Glyph masks read from flash are kept here so repeated characters are
+//drawn from RAM. Every slot is the size of the largest glyph of the
+//current font and the least recently used one is replaced on a miss
+typedef struct
+{
+        uint16_t codepoint;
+        bool isValid;
+        uint32_t lastUsed;
+} displayGlyphCacheEntry_t;
+
+static uint8_t displayGlyphCachePool[DISPLAY_GLYPH_CACHE_BYTES];
+static displayGlyphCacheEntry_t displayGlyphCacheEntries[DISPLAY_GLYPH_CACHE_MAX_ENTRIES];
+static int displayGlyphCacheSlotSize = 0;
+static int displayGlyphCacheSlots = 0;
+static uint32_t displayGlyphCacheClock = 0;
+static displayGlyphCacheStats_t displayGlyphCacheStats = {0};
+
+//Empties the cache and splits it into slots of SLOT_SIZE bytes. Fails
+//if not even one slot fits
+bool displayGlyphCacheReset(int SLOT_SIZE)
+{
+        memset(displayGlyphCacheEntries,0,sizeof(displayGlyphCacheEntries));
+        displayGlyphCacheSlotSize = 0;
+        displayGlyphCacheSlots = 0;
+        if((SLOT_SIZE<=0)||(SLOT_SIZE>DISPLAY_GLYPH_CACHE_BYTES))
+        {
+                return false;
+        }
+        displayGlyphCacheSlotSize = SLOT_SIZE;
+        displayGlyphCacheSlots = DISPLAY_GLYPH_CACHE_BYTES/SLOT_SIZE;
+        if(displayGlyphCacheSlots>DISPLAY_GLYPH_CACHE_MAX_ENTRIES)
+        {
+                displayGlyphCacheSlots = DISPLAY_GLYPH_CACHE_MAX_ENTRIES;
+        }
+        return true;
+}
+//Returns the SIZE bytes at ADDRESS_IN_MEMORY, from RAM if the glyph
+//was used recently. The pointer is good until the next call
+const uint8_t *displayGlyphCacheGet(uint16_t CODEPOINT, int ADDRESS_IN_MEMORY, int SIZE)
+{
+        displayGlyphCacheEntry_t *oldestEntry = &displayGlyphCacheEntries[0];
+        nvms_t flashMemory;
+        int slot = 0;
+
+        if((displayGlyphCacheSlots==0)||(SIZE>displayGlyphCacheSlotSize))
+        {
+                return NULL;
+        }
+        for(int i=0;i<displayGlyphCacheSlots;i++)
+        {
+                displayGlyphCacheEntry_t *entry = &displayGlyphCacheEntries[i];
+                if(entry->isValid&&(entry->codepoint==CODEPOINT))
+                {
+                        entry->lastUsed = displayGlyphCacheClock++;
+                        displayGlyphCacheStats.hits++;
+                        return &displayGlyphCachePool[i*displayGlyphCacheSlotSize];
+                }
+                if(!entry->isValid)
+                {
+                        //Empty slots go first
+                        if(oldestEntry->isValid)
+                        {
+                                oldestEntry = entry;
+                        }
+                }
+                else if(oldestEntry->isValid&&(entry->lastUsed<oldestEntry->lastUsed))
+                {
+                        oldestEntry = entry;
+                }
+        }
+        if(oldestEntry->isValid)
+        {
+                displayGlyphCacheStats.evictions++;
+        }
+        slot = oldestEntry-displayGlyphCacheEntries;
+        flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        ad_nvms_read(flashMemory, ADDRESS_IN_MEMORY, (uint8 *) &displayGlyphCachePool[slot*displayGlyphCacheSlotSize], SIZE);
+        oldestEntry->codepoint = CODEPOINT;
+        oldestEntry->isValid = true;
+        oldestEntry->lastUsed = displayGlyphCacheClock++;
+        displayGlyphCacheStats.misses++;
+        displayGlyphCacheStats.flashBytesRead += SIZE;
+        return &displayGlyphCachePool[slot*displayGlyphCacheSlotSize];
+}
+void displayGetGlyphCacheStats(displayGlyphCacheStats_t *STATS)
+{
+        *STATS = displayGlyphCacheStats;
+}
+void displayResetGlyphCacheStats(void)
+{
+        memset(&displayGlyphCacheStats,0,sizeof(displayGlyphCacheStats));
+}
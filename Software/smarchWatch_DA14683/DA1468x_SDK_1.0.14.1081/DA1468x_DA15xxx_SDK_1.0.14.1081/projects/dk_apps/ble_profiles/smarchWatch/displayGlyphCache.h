@@ -0,0 +1,33 @@
+/*
+ * displayGlyphCache.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef DISPLAYGLYPHCACHE_H_
+#define DISPLAYGLYPHCACHE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//RAM set aside for glyph masks, can be overridden from the build
+#ifndef DISPLAY_GLYPH_CACHE_BYTES
+#define DISPLAY_GLYPH_CACHE_BYTES 4096
+#endif
+#define DISPLAY_GLYPH_CACHE_MAX_ENTRIES 64
+
+typedef struct
+{
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t evictions;
+        uint32_t flashBytesRead;
+} displayGlyphCacheStats_t;
+
+bool displayGlyphCacheReset(int SLOT_SIZE);
+const uint8_t *displayGlyphCacheGet(uint16_t CODEPOINT, int ADDRESS_IN_MEMORY, int SIZE);
+void displayGetGlyphCacheStats(displayGlyphCacheStats_t *STATS);
+void displayResetGlyphCacheStats(void);
+
+#endif /* DISPLAYGLYPHCACHE_H_ */
@@ -0,0 +1,416 @@
+/*
+ * displayGlyphs.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "ad_nvms.h"
+#include "displayGlyphs.h"
+#include "displayFonts.h"
+#include "displayDriver.h"
+#include "displayGlyphCache.h"
+#include "displayList.h"
+#include "displayAssets.h"
+#include "imageOffsets.h"
+
+//Font that was flashed with the firmware, used until a table is loaded
+static const displayGlyph_t displayDefaultGlyphs[] =
+{
+        {'!',30,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,2,0,0,0,0},
+        {'"',90,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,6,0,0,0,0},
+        {'#',150,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {'$',165,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {'\'',105,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,2,0,0,0,0},
+        {'(',120,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,4,0,0,0,0},
+        {')',135,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,4,0,0,0,0},
+        {',',15,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,2,0,0,0,0},
+        {'.',0,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,2,0,0,0,0},
+        {'/',75,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,6,0,0,0,0},
+        {'0',135,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {'1',0,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,5,0,0,0,0},
+        {'2',15,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'3',30,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'4',45,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {'5',60,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'6',75,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {'7',90,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,7,0,0,0,0},
+        {'8',105,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'9',120,100,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {':',60,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,2,0,0,0,0},
+        {'?',45,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'@',180,125,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,15,0,0,0,0},
+        {'A',0,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,10,0,0,0,0},
+        {'B',15,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {'C',30,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,10,0,0,0,0},
+        {'D',45,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {'E',60,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,7,0,0,0,0},
+        {'F',75,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,6,0,0,0,0},
+        {'G',90,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,10,0,0,0,0},
+        {'H',105,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,10,0,0,0,0},
+        {'I',120,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,2,0,0,0,0},
+        {'J',135,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,5,0,0,0,0},
+        {'K',150,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,10,0,0,0,0},
+        {'L',165,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,7,0,0,0,0},
+        {'M',180,0,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,12,0,0,0,0},
+        {'N',0,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,10,0,0,0,0},
+        {'O',15,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,11,0,0,0,0},
+        {'P',30,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {'Q',45,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,11,0,0,0,0},
+        {'R',60,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {'S',75,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {'T',90,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {'U',105,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {'V',120,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,11,0,0,0,0},
+        {'W',135,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,15,0,0,0,0},
+        {'X',150,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,10,0,0,0,0},
+        {'Y',165,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,11,0,0,0,0},
+        {'Z',180,25,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'a',0,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'b',15,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'c',30,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,7,0,0,0,0},
+        {'d',45,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'e',60,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'f',75,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,5,0,0,0,0},
+        {'g',90,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {'h',105,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,7,0,0,0,0},
+        {'i',120,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,2,0,0,0,0},
+        {'j',135,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,4,0,0,0,0},
+        {'k',150,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,9,0,0,0,0},
+        {'l',165,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,2,0,0,0,0},
+        {'m',180,50,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,14,0,0,0,0},
+        {'n',0,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'o',15,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'p',30,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'q',45,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'r',60,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,5,0,0,0,0},
+        {'s',75,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,7,0,0,0,0},
+        {'t',90,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,6,0,0,0,0},
+        {'u',105,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'v',120,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'w',135,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,12,0,0,0,0},
+        {'x',150,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'y',165,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,8,0,0,0,0},
+        {'z',180,75,FONT_CHARACTER_WIDTH,FONT_CHARACTER_HEIGHT,6,0,0,0,0},
+};
+
+//The atlas is wherever the pack put FONT, filled in when it is used
+static displayGlyphTableHeader_t displayDefaultGlyphHeader =
+{
+        DISPLAY_GLYPH_TABLE_MAGIC,
+        DISPLAY_GLYPH_TABLE_VERSION,
+        FONT_CHARACTER_HEIGHT,
+        5,
+        0,
+        sizeof(displayDefaultGlyphs)/sizeof(displayDefaultGlyphs[0]),
+        0,
+        0,
+        -1
+};
+
+static displayGlyph_t displayLoadedGlyphs[DISPLAY_GLYPH_MAX_GLYPHS];
+static displayGlyphTableHeader_t displayLoadedGlyphHeader;
+
+static const displayGlyph_t *displayGlyphs = NULL;
+static const displayGlyphTableHeader_t *displayGlyphHeader = NULL;
+//Position in the table of each printable ASCII character
+static uint8_t displayGlyphAscii[DISPLAY_GLYPH_ASCII_LAST-DISPLAY_GLYPH_ASCII_FIRST+1];
+static displayGlyphStats_t displayGlyphStats = {0};
+static uint16_t displayGlyphForegroundColor = DISPLAY_WHITE;
+static uint16_t displayGlyphBackgroundColor = DISPLAY_BLACK;
+//Panel bytes for every coverage level of the current colors
+static uint8_t displayGlyphRamp[1<<DISPLAY_GLYPH_MAX_BITS_PER_PIXEL][BYTES_PER_PIXEL];
+static bool displayGlyphRampIsValid = false;
+
+static void displayGlyphIndex(const displayGlyphTableHeader_t *HEADER, const displayGlyph_t GLYPHS[])
+{
+        memset(displayGlyphAscii,DISPLAY_GLYPH_NONE,sizeof(displayGlyphAscii));
+        for(int i=0;i<HEADER->glyphCount;i++)
+        {
+                uint16_t codepoint = GLYPHS[i].codepoint;
+                if((codepoint>=DISPLAY_GLYPH_ASCII_FIRST)&&(codepoint<=DISPLAY_GLYPH_ASCII_LAST))
+                {
+                        displayGlyphAscii[codepoint-DISPLAY_GLYPH_ASCII_FIRST] = i;
+                }
+        }
+        displayGlyphHeader = HEADER;
+        displayGlyphs = GLYPHS;
+        displayGlyphRampIsValid = false;
+}
+static int displayGlyphMaskRowSize(const displayGlyph_t *GLYPH)
+{
+        return ((GLYPH->width*displayGlyphHeader->bitsPerPixel)+7)/8;
+}
+void displayGlyphUseDefault(void)
+{
+        displayDefaultGlyphHeader.atlasAddress = displayAssetAddress(FONT_ASSET);
+        displayGlyphIndex(&displayDefaultGlyphHeader,displayDefaultGlyphs);
+}
+//Reads a glyph table from flash into RAM. A table that is missing,
+//too big or out of order is rejected, as is a mask font whose largest
+//glyph doesn't fit the glyph cache
+bool displayGlyphLoad(int ADDRESS_IN_MEMORY)
+{
+        nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        displayGlyphTableHeader_t header;
+        int largestMask = 0;
+
+        ad_nvms_read(flashMemory, ADDRESS_IN_MEMORY, (uint8 *) &header, sizeof(header));
+        if((header.magic!=DISPLAY_GLYPH_TABLE_MAGIC)||(header.version!=DISPLAY_GLYPH_TABLE_VERSION)||
+           (header.glyphCount==0)||(header.glyphCount>DISPLAY_GLYPH_MAX_GLYPHS))
+        {
+                return false;
+        }
+        if((header.bitsPerPixel!=0)&&
+           (((header.flags&DISPLAY_GLYPH_FLAG_PACKED)==0)||(header.bitsPerPixel>DISPLAY_GLYPH_MAX_BITS_PER_PIXEL)||
+            (DISPLAY_GLYPH_MAX_BITS_PER_PIXEL%header.bitsPerPixel)))
+        {
+                return false;
+        }
+        //The current font may be the loaded one, so check before copying
+        //over it
+        if(displayGlyphs==displayLoadedGlyphs)
+        {
+                displayGlyphUseDefault();
+        }
+        ad_nvms_read(flashMemory, ADDRESS_IN_MEMORY+sizeof(header), (uint8 *) displayLoadedGlyphs, header.glyphCount*sizeof(displayGlyph_t));
+        for(int i=1;i<header.glyphCount;i++)
+        {
+                if(displayLoadedGlyphs[i].codepoint<=displayLoadedGlyphs[i-1].codepoint)
+                {
+                        return false;
+                }
+        }
+        for(int i=0;i<header.glyphCount;i++)
+        {
+                int maskSize = displayLoadedGlyphs[i].height*(((displayLoadedGlyphs[i].width*header.bitsPerPixel)+7)/8);
+                largestMask = (maskSize>largestMask)?maskSize:largestMask;
+        }
+        if((header.bitsPerPixel!=0)&&!displayGlyphCacheReset(largestMask))
+        {
+                return false;
+        }
+        //The packer writes the atlas address from the start of the pack,
+        //which is in whichever bank is active
+        header.atlasAddress += displayAssetBase();
+        displayLoadedGlyphHeader = header;
+        displayGlyphIndex(&displayLoadedGlyphHeader,displayLoadedGlyphs);
+        return true;
+}
+//Sets the colors mask glyphs are drawn in. RGB565 glyphs keep the
+//colors they were drawn with
+void displayGlyphSetColors(int FOREGROUND, int BACKGROUND)
+{
+        displayGlyphForegroundColor = FOREGROUND;
+        displayGlyphBackgroundColor = BACKGROUND;
+        displayGlyphRampIsValid = false;
+}
+int displayGlyphForeground(void)
+{
+        return displayGlyphForegroundColor;
+}
+int displayGlyphBackground(void)
+{
+        return displayGlyphBackgroundColor;
+}
+//The mask of a glyph from a mask font, from the glyph cache when it
+//was drawn recently. Good until the next glyph is fetched
+const uint8_t *displayGlyphGetMask(const displayGlyph_t *GLYPH)
+{
+        return displayGlyphCacheGet(GLYPH->codepoint,displayGlyphHeader->atlasAddress+GLYPH->dataOffset+2,
+                                    GLYPH->height*displayGlyphMaskRowSize(GLYPH));
+}
+//Coverage of pixel X,Y of a glyph as an alpha from 0 to 32
+int displayGlyphAlpha(const displayGlyph_t *GLYPH, const uint8_t MASK[], int X, int Y)
+{
+        int bitsPerPixel = displayGlyphHeader->bitsPerPixel;
+        int maximum = (1<<bitsPerPixel)-1;
+        int bit = X*bitsPerPixel;
+        int coverage = (MASK[(Y*displayGlyphMaskRowSize(GLYPH))+(bit>>3)]>>(8-bitsPerPixel-(bit&7)))&maximum;
+        return ((coverage*32)+(maximum/2))/maximum;
+}
+static void displayGlyphBuildRamp(void)
+{
+        int maximum = (1<<displayGlyphHeader->bitsPerPixel)-1;
+        for(int level=0;level<=maximum;level++)
+        {
+                int color = displayBlendColor(displayGlyphForegroundColor,displayGlyphBackgroundColor,
+                                              ((level*32)+(maximum/2))/maximum);
+                displayGlyphRamp[level][0] = color >> 8;
+                displayGlyphRamp[level][1] = color & 0xFF;
+        }
+        displayGlyphRampIsValid = true;
+}
+//Expands a mask glyph to the current colors straight into the blit
+//buffers, a row at a time
+static void displayGlyphDrawMask(const displayGlyph_t *GLYPH, int XSTART, int YSTART)
+{
+        const uint8_t *mask = displayGlyphGetMask(GLYPH);
+        int bitsPerPixel = displayGlyphHeader->bitsPerPixel;
+        int maximum = (1<<bitsPerPixel)-1;
+        int rowSize = displayGlyphMaskRowSize(GLYPH);
+        int bytesInBuffer = 0;
+        int currentBuffer = 0;
+        uint8_t *buffer;
+
+        if(mask==NULL)
+        {
+                return;
+        }
+        if(!displayGlyphRampIsValid)
+        {
+                displayGlyphBuildRamp();
+        }
+        displayBeginTransaction();
+        displaySetWindow(XSTART,XSTART+GLYPH->width-1,YSTART,YSTART+GLYPH->height-1);
+        //A previous blit may still own one of the buffers
+        displayWaitDataBuf();
+        buffer = displayGetBlitBuffer(currentBuffer);
+        for(int y=0;y<GLYPH->height;y++)
+        {
+                const uint8_t *maskRow = &mask[y*rowSize];
+                if((bytesInBuffer+(GLYPH->width*BYTES_PER_PIXEL))>SPI_WRITE_BUFFER_SIZE)
+                {
+                        displayWriteDataBufAsync(buffer,bytesInBuffer);
+                        currentBuffer ^= 1;
+                        buffer = displayGetBlitBuffer(currentBuffer);
+                        bytesInBuffer = 0;
+                }
+                for(int x=0;x<GLYPH->width;x++)
+                {
+                        int bit = x*bitsPerPixel;
+                        int coverage = (maskRow[bit>>3]>>(8-bitsPerPixel-(bit&7)))&maximum;
+                        buffer[bytesInBuffer++] = displayGlyphRamp[coverage][0];
+                        buffer[bytesInBuffer++] = displayGlyphRamp[coverage][1];
+                }
+        }
+        displayWriteDataBufAsync(buffer,bytesInBuffer);
+        displayEndTransaction();
+}
+//Draws one glyph and returns how far to move along for the next one
+int displayGlyphDraw(int X_START, int Y_START, uint32_t CODEPOINT)
+{
+        const displayGlyph_t *glyph = displayGlyphFind(CODEPOINT);
+        int screenX = 0;
+        int screenY = 0;
+
+        if(glyph==NULL)
+        {
+                return displayGlyphHeader->defaultAdvance;
+        }
+        if((glyph->width==0)||(glyph->height==0))
+        {
+                return glyph->advance;
+        }
+        screenX = X_START+glyph->bearingX;
+        screenY = Y_START+glyph->bearingY;
+        displayGlyphStats.glyphsDrawn++;
+        if(displayGlyphHeader->bitsPerPixel!=0)
+        {
+                //Recorded glyphs are blended over whatever is under them
+                if(!displayListAddGlyph(screenX,screenY,glyph->width,glyph->height,glyph->codepoint,displayGlyphForegroundColor))
+                {
+                        displayGlyphDrawMask(glyph,screenX,screenY);
+                }
+        }
+        else if(displayGlyphHeader->flags&DISPLAY_GLYPH_FLAG_PACKED)
+        {
+                //The whole glyph is one run of flash
+                displaySizedImageFromMemory(screenX,screenY,glyph->width,glyph->height,
+                                            displayGlyphHeader->atlasAddress+glyph->dataOffset);
+                displayGlyphStats.flashBytesRead += glyph->width*glyph->height*BYTES_PER_PIXEL;
+        }
+        else
+        {
+                //The atlas header, then just the glyph's part of each row
+                displayPartialImageFromMemory(screenX,screenY,glyph->atlasX,glyph->atlasY,glyph->width,glyph->height,
+                                              displayGlyphHeader->atlasAddress);
+                displayGlyphStats.flashBytesRead += 2+(glyph->width*glyph->height*BYTES_PER_PIXEL);
+        }
+        return glyph->advance;
+}
+//Printable ASCII is one table read, anything else is a binary search
+//of the sorted glyphs. Returns NULL if the font has no such glyph
+const displayGlyph_t *displayGlyphFind(uint32_t CODEPOINT)
+{
+        int low = 0;
+        int high = 0;
+
+        if(displayGlyphs==NULL)
+        {
+                displayGlyphUseDefault();
+        }
+        if((CODEPOINT>=DISPLAY_GLYPH_ASCII_FIRST)&&(CODEPOINT<=DISPLAY_GLYPH_ASCII_LAST))
+        {
+                uint8_t index = displayGlyphAscii[CODEPOINT-DISPLAY_GLYPH_ASCII_FIRST];
+                displayGlyphStats.asciiLookups++;
+                if(index==DISPLAY_GLYPH_NONE)
+                {
+                        displayGlyphStats.missingGlyphs++;
+                        return NULL;
+                }
+                return &displayGlyphs[index];
+        }
+        displayGlyphStats.searchLookups++;
+        high = displayGlyphHeader->glyphCount-1;
+        while(low<=high)
+        {
+                int middle = (low+high)/2;
+                if(displayGlyphs[middle].codepoint==CODEPOINT)
+                {
+                        return &displayGlyphs[middle];
+                }
+                if(displayGlyphs[middle].codepoint<CODEPOINT)
+                {
+                        low = middle+1;
+                }
+                else
+                {
+                        high = middle-1;
+                }
+        }
+        displayGlyphStats.missingGlyphs++;
+        return NULL;
+}
+//How far a character moves the pen, for measuring text without drawing
+int displayGlyphAdvance(uint32_t CODEPOINT)
+{
+        const displayGlyph_t *glyph = displayGlyphFind(CODEPOINT);
+        return (glyph==NULL)?displayGlyphHeader->defaultAdvance:glyph->advance;
+}
+int displayGlyphAtlasAddress(void)
+{
+        if(displayGlyphs==NULL)
+        {
+                displayGlyphUseDefault();
+        }
+        return displayGlyphHeader->atlasAddress;
+}
+int displayGlyphLineHeight(void)
+{
+        if(displayGlyphs==NULL)
+        {
+                displayGlyphUseDefault();
+        }
+        return displayGlyphHeader->lineHeight;
+}
+int displayGlyphDefaultAdvance(void)
+{
+        if(displayGlyphs==NULL)
+        {
+                displayGlyphUseDefault();
+        }
+        return displayGlyphHeader->defaultAdvance;
+}
+void displayGetGlyphStats(displayGlyphStats_t *STATS)
+{
+        *STATS = displayGlyphStats;
+}
+void displayResetGlyphStats(void)
+{
+        memset(&displayGlyphStats,0,sizeof(displayGlyphStats));
+}
@@ -0,0 +1,87 @@
+/*
+ * displayGlyphs.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef DISPLAYGLYPHS_H_
+#define DISPLAYGLYPHS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Glyph tables in flash start with this, "GLYF" little endian
+#define DISPLAY_GLYPH_TABLE_MAGIC 0x46594C47
+#define DISPLAY_GLYPH_TABLE_VERSION 2
+//Each glyph is its own small image instead of a rectangle of an atlas
+#define DISPLAY_GLYPH_FLAG_PACKED 0x01
+//Coverage mask depths for fonts drawn in any color, 0 is RGB565
+#define DISPLAY_GLYPH_MAX_BITS_PER_PIXEL 4
+//Largest table that can be loaded into RAM
+#define DISPLAY_GLYPH_MAX_GLYPHS 160
+//Codepoints looked up straight from the ASCII index
+#define DISPLAY_GLYPH_ASCII_FIRST 0x20
+#define DISPLAY_GLYPH_ASCII_LAST 0x7E
+#define DISPLAY_GLYPH_NONE 0xFF
+
+//One glyph, 16 bytes in flash and RAM. Tables are sorted by codepoint.
+//Packed glyphs are an image header and width*height pixels at
+//atlasAddress+dataOffset, atlas glyphs use atlasX and atlasY instead.
+//Mask glyphs have 1, 2 or 4 bits of coverage per pixel, most
+//significant first, and every row starts on a new byte
+typedef struct
+{
+        uint16_t codepoint;
+        uint16_t atlasX;
+        uint16_t atlasY;
+        uint8_t width;
+        uint8_t height;
+        uint8_t advance;
+        int8_t bearingX;
+        int8_t bearingY;
+        uint8_t reserved;
+        uint32_t dataOffset;
+} displayGlyph_t;
+
+//Table header, followed by glyphCount glyphs. atlasAddress is where
+//the atlas image, or the packed glyph data, is in flash
+typedef struct
+{
+        uint32_t magic;
+        uint8_t version;
+        uint8_t lineHeight;
+        uint8_t defaultAdvance;
+        uint8_t flags;
+        uint16_t glyphCount;
+        uint8_t bitsPerPixel;
+        uint8_t reserved;
+        int32_t atlasAddress;
+} displayGlyphTableHeader_t;
+
+typedef struct
+{
+        uint32_t asciiLookups;
+        uint32_t searchLookups;
+        uint32_t missingGlyphs;
+        uint32_t glyphsDrawn;
+        uint32_t flashBytesRead;
+} displayGlyphStats_t;
+
+bool displayGlyphLoad(int ADDRESS_IN_MEMORY);
+void displayGlyphUseDefault(void);
+const displayGlyph_t *displayGlyphFind(uint32_t CODEPOINT);
+int displayGlyphDraw(int X_START, int Y_START, uint32_t CODEPOINT);
+int displayGlyphAdvance(uint32_t CODEPOINT);
+void displayGlyphSetColors(int FOREGROUND, int BACKGROUND);
+int displayGlyphForeground(void);
+int displayGlyphBackground(void);
+const uint8_t *displayGlyphGetMask(const displayGlyph_t *GLYPH);
+int displayGlyphAlpha(const displayGlyph_t *GLYPH, const uint8_t MASK[], int X, int Y);
+int displayGlyphAtlasAddress(void);
+int displayGlyphLineHeight(void);
+int displayGlyphDefaultAdvance(void);
+void displayGetGlyphStats(displayGlyphStats_t *STATS);
+void displayResetGlyphStats(void);
+
+#endif /* DISPLAYGLYPHS_H_ */
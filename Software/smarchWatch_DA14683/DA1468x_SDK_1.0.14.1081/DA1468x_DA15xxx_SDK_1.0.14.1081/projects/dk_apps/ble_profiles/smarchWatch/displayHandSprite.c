@@ -0,0 +1,161 @@
+/*
+ * displayHandSprite.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "ad_nvms.h"
+#include "displayHandSprite.h"
+#include "displaySpan.h"
+#include "displayList.h"
+
+//Hands are drawn from runs the packer rasterized at every angle, so a
+//hand costs one flash stream of its spans and no geometry
+static displayHandSpriteHeader_t displayHandSpriteHeader;
+static displayHandSpriteHand_t displayHandSpriteHands[DISPLAY_HAND_SPRITE_MAX_HANDS];
+static int displayHandSpriteAddress = -1;
+static displayHandSpriteStats_t displayHandSpriteStats = {0};
+
+//A negative address, from a pack without hands, unloads the last set
+bool displayHandSpritesLoad(int ADDRESS_IN_MEMORY)
+{
+        nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        displayHandSpriteHeader_t header;
+
+        if(ADDRESS_IN_MEMORY<0)
+        {
+                displayHandSpriteAddress = -1;
+                return false;
+        }
+        ad_nvms_read(flashMemory, ADDRESS_IN_MEMORY, (uint8 *) &header, sizeof(header));
+        if((header.magic!=DISPLAY_HAND_SPRITE_MAGIC)||(header.version!=DISPLAY_HAND_SPRITE_VERSION)||
+           (header.handCount==0)||(header.handCount>DISPLAY_HAND_SPRITE_MAX_HANDS)||(header.angleCount==0))
+        {
+                displayHandSpriteAddress = -1;
+                return false;
+        }
+        ad_nvms_read(flashMemory, ADDRESS_IN_MEMORY+sizeof(header), (uint8 *) displayHandSpriteHands,
+                     header.handCount*sizeof(displayHandSpriteHand_t));
+        displayHandSpriteHeader = header;
+        displayHandSpriteAddress = ADDRESS_IN_MEMORY;
+        return true;
+}
+bool displayHandSpritesLoaded(void)
+{
+        return displayHandSpriteAddress>=0;
+}
+int displayHandSpriteCount(void)
+{
+        return displayHandSpritesLoaded()?displayHandSpriteHeader.handCount:0;
+}
+int displayHandSpriteAngles(void)
+{
+        return displayHandSpritesLoaded()?displayHandSpriteHeader.angleCount:0;
+}
+//Nearest sprite to ANGLE in degrees
+int displayHandSpriteIndex(int ANGLE)
+{
+        int angleCount = displayHandSpriteAngles();
+        if(angleCount==0)
+        {
+                return 0;
+        }
+        ANGLE %= 360;
+        if(ANGLE<0)
+        {
+                ANGLE += 360;
+        }
+        return (((ANGLE*angleCount)+180)/360)%angleCount;
+}
+int displayHandSpriteColor(int HAND)
+{
+        return displayHandSpriteHands[HAND].color;
+}
+bool displayHandSpriteGet(int HAND, int ANGLE, displayHandSprite_t *SPRITE)
+{
+        nvms_t flashMemory;
+        int recordAddress = 0;
+
+        if(!displayHandSpritesLoaded()||(HAND<0)||(HAND>=displayHandSpriteHeader.handCount))
+        {
+                return false;
+        }
+        flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        recordAddress = displayHandSpriteAddress+sizeof(displayHandSpriteHeader_t)+
+                        (displayHandSpriteHeader.handCount*sizeof(displayHandSpriteHand_t))+
+                        (((HAND*displayHandSpriteHeader.angleCount)+displayHandSpriteIndex(ANGLE))*sizeof(displayHandSprite_t));
+        ad_nvms_read(flashMemory, recordAddress, (uint8 *) SPRITE, sizeof(displayHandSprite_t));
+        displayHandSpriteStats.flashBytesRead += sizeof(displayHandSprite_t);
+        return true;
+}
+int displayHandSpriteSpanAddress(const displayHandSprite_t *SPRITE)
+{
+        return displayHandSpriteAddress+SPRITE->dataOffset;
+}
+static void displayHandSpriteStream(const displayHandSprite_t *SPRITE, int COLOR, int X_CENTER, int Y_CENTER, displaySpanOutput_t OUTPUT, void *USER_DATA)
+{
+        displayHandSpan_t spans[DISPLAY_HAND_SPRITE_CHUNK];
+        nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        int spanAddress = displayHandSpriteSpanAddress(SPRITE);
+
+        for(int first=0;first<SPRITE->spanCount;first+=DISPLAY_HAND_SPRITE_CHUNK)
+        {
+                int count = SPRITE->spanCount-first;
+                count = (count>DISPLAY_HAND_SPRITE_CHUNK)?DISPLAY_HAND_SPRITE_CHUNK:count;
+                ad_nvms_read(flashMemory, spanAddress+(first*sizeof(displayHandSpan_t)), (uint8 *) spans, count*sizeof(displayHandSpan_t));
+                displayHandSpriteStats.flashBytesRead += count*sizeof(displayHandSpan_t);
+                for(int i=0;i<count;i++)
+                {
+                        int xStart = X_CENTER+spans[i].xStart;
+                        OUTPUT(Y_CENTER+spans[i].y,xStart,xStart+spans[i].length-1,COLOR,USER_DATA);
+                }
+        }
+        displayHandSpriteStats.spansDrawn += SPRITE->spanCount;
+}
+//Streams the spans of a hand in screen coordinates, top to bottom
+void displayHandSpriteSpans(int HAND, int ANGLE, int X_CENTER, int Y_CENTER, displaySpanOutput_t OUTPUT, void *USER_DATA)
+{
+        displayHandSprite_t sprite;
+
+        if(displayHandSpriteGet(HAND,ANGLE,&sprite))
+        {
+                displayHandSpriteStream(&sprite,displayHandSpriteHands[HAND].color,X_CENTER,Y_CENTER,OUTPUT,USER_DATA);
+        }
+}
+static void displayHandSpriteSpan(int Y, int XSTART, int XEND, int COLOR, void *USER_DATA)
+{
+        displaySpanAdd(Y,XSTART,XEND,COLOR);
+}
+//Draws hand HAND of the loaded set pointing at ANGLE degrees with its
+//pivot at X_CENTER, Y_CENTER. While a display list is recording the
+//spans are read when the list is rendered, over whatever is under them
+void displayDrawHandSprite(int HAND, int ANGLE, int X_CENTER, int Y_CENTER)
+{
+        displayHandSprite_t sprite;
+
+        if(!displayHandSpriteGet(HAND,ANGLE,&sprite))
+        {
+                return;
+        }
+        displayHandSpriteStats.spritesDrawn++;
+        if((sprite.spanCount==0)||
+           displayListAddHandSprite(X_CENTER,Y_CENTER,&sprite,displayHandSpriteHands[HAND].color))
+        {
+                return;
+        }
+        displaySpanBegin();
+        displayHandSpriteStream(&sprite,displayHandSpriteHands[HAND].color,X_CENTER,Y_CENTER,displayHandSpriteSpan,NULL);
+        displaySpanEnd();
+}
+void displayGetHandSpriteStats(displayHandSpriteStats_t *STATS)
+{
+        *STATS = displayHandSpriteStats;
+}
+void displayResetHandSpriteStats(void)
+{
+        memset(&displayHandSpriteStats,0,sizeof(displayHandSpriteStats));
+}
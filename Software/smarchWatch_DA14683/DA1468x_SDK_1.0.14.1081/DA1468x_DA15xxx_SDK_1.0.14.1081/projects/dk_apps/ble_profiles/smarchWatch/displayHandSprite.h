@@ -0,0 +1,84 @@
+/*
+ * displayHandSprite.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef DISPLAYHANDSPRITE_H_
+#define DISPLAYHANDSPRITE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "displayPolygon.h"
+
+//Hand sprite sets in flash start with this, "HSPR" little endian
+#define DISPLAY_HAND_SPRITE_MAGIC 0x52505348
+#define DISPLAY_HAND_SPRITE_VERSION 1
+#define DISPLAY_HAND_SPRITE_MAX_HANDS 4
+//Spans read from flash at a time
+#define DISPLAY_HAND_SPRITE_CHUNK 32
+
+//Set header, followed by handCount hands, then angleCount sprites for
+//each hand in hand order. Sprite n of a hand points at n*360/angleCount
+//degrees, 0 being three o'clock
+typedef struct
+{
+        uint32_t magic;
+        uint8_t version;
+        uint8_t handCount;
+        uint16_t angleCount;
+        uint8_t reserved[8];
+} displayHandSpriteHeader_t;
+
+typedef struct
+{
+        uint16_t color;
+        uint8_t length;
+        uint8_t reserved;
+} displayHandSpriteHand_t;
+
+//One hand at one angle. dataOffset is from the start of the set and
+//the bounds are relative to the pivot
+typedef struct
+{
+        uint32_t dataOffset;
+        uint16_t spanCount;
+        int8_t xMin;
+        int8_t xMax;
+        int8_t yMin;
+        int8_t yMax;
+        uint16_t reserved;
+} displayHandSprite_t;
+
+//Run of opaque pixels relative to the pivot, sorted by row. Everything
+//between runs is transparent
+typedef struct
+{
+        int8_t y;
+        int8_t xStart;
+        uint8_t length;
+        uint8_t reserved;
+} displayHandSpan_t;
+
+typedef struct
+{
+        uint32_t spritesDrawn;
+        uint32_t spansDrawn;
+        uint32_t flashBytesRead;
+} displayHandSpriteStats_t;
+
+bool displayHandSpritesLoad(int ADDRESS_IN_MEMORY);
+bool displayHandSpritesLoaded(void);
+int  displayHandSpriteCount(void);
+int  displayHandSpriteAngles(void);
+int  displayHandSpriteIndex(int ANGLE);
+int  displayHandSpriteColor(int HAND);
+bool displayHandSpriteGet(int HAND, int ANGLE, displayHandSprite_t *SPRITE);
+int  displayHandSpriteSpanAddress(const displayHandSprite_t *SPRITE);
+void displayHandSpriteSpans(int HAND, int ANGLE, int X_CENTER, int Y_CENTER, displaySpanOutput_t OUTPUT, void *USER_DATA);
+void displayDrawHandSprite(int HAND, int ANGLE, int X_CENTER, int Y_CENTER);
+void displayGetHandSpriteStats(displayHandSpriteStats_t *STATS);
+void displayResetHandSpriteStats(void);
+
+#endif /* DISPLAYHANDSPRITE_H_ */
@@ -0,0 +1,338 @@
+/*
+ * displayImage.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "ad_nvms.h"
+#include "displayImage.h"
+#include "displayDriver.h"
+
+//Compressed images are decoded straight into whatever buffer the
+//pixels are going to, a few dozen bytes of flash at a time
+static displayImageDecoder_t displayImageDecoders[DISPLAY_IMAGE_DECODERS];
+static uint32_t displayImageClock = 0;
+//Theme palette used for every indexed image while it is set
+static uint16_t displayImagePalette[DISPLAY_IMAGE_MAX_COLORS];
+static bool displayImageHasPalette = false;
+static displayImageStats_t displayImageStats = {0};
+
+bool displayImageIsCompressed(int ADDRESS_IN_MEMORY)
+{
+        uint8_t marker = 0;
+        nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        ad_nvms_read(flashMemory, ADDRESS_IN_MEMORY, (uint8 *) &marker, sizeof(marker));
+        return marker==0;
+}
+//RGB565 colors as they are stored by a little endian halfword write, so
+//the panel gets the high byte first
+static void displayImageSwapColors(uint16_t COLORS[], int COLOR_COUNT)
+{
+        for(int i=0;i<COLOR_COUNT;i++)
+        {
+                COLORS[i] = (COLORS[i]>>8)|(COLORS[i]<<8);
+        }
+}
+//Returns a decoder for the compressed image at ADDRESS_IN_MEMORY, or
+//NULL if it isn't one this build can read. Decoders are kept for the
+//images used last so a face drawn band by band isn't reopened each time
+displayImageDecoder_t *displayImageOpen(int ADDRESS_IN_MEMORY)
+{
+        displayImageDecoder_t *decoder = &displayImageDecoders[0];
+        displayImageHeader_t header;
+        nvms_t flashMemory;
+
+        for(int i=0;i<DISPLAY_IMAGE_DECODERS;i++)
+        {
+                if((displayImageDecoders[i].lastUsed!=0)&&(displayImageDecoders[i].address==ADDRESS_IN_MEMORY))
+                {
+                        displayImageDecoders[i].lastUsed = ++displayImageClock;
+                        return &displayImageDecoders[i];
+                }
+                if(displayImageDecoders[i].lastUsed<decoder->lastUsed)
+                {
+                        decoder = &displayImageDecoders[i];
+                }
+        }
+        flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        ad_nvms_read(flashMemory, ADDRESS_IN_MEMORY, (uint8 *) &header, sizeof(header));
+        if((header.marker!=0)||(header.width==0))
+        {
+                return NULL;
+        }
+        if(header.format==DISPLAY_IMAGE_FORMAT_INDEXED)
+        {
+                if(((header.bitsPerPixel!=2)&&(header.bitsPerPixel!=4)&&(header.bitsPerPixel!=8))||
+                   (header.paletteCount>(1<<header.bitsPerPixel)))
+                {
+                        return NULL;
+                }
+                memset(decoder->palette,0,sizeof(decoder->palette));
+                ad_nvms_read(flashMemory, ADDRESS_IN_MEMORY+sizeof(header), (uint8 *) decoder->palette, header.paletteCount*sizeof(uint16_t));
+                displayImageSwapColors(decoder->palette,header.paletteCount);
+                decoder->dataAddress = ADDRESS_IN_MEMORY+sizeof(header)+(header.paletteCount*sizeof(uint16_t));
+                decoder->rowBytes = ((header.width*header.bitsPerPixel)+7)/8;
+        }
+        else if((header.format!=DISPLAY_IMAGE_FORMAT_RLE16)||(header.rowsPerBlock==0)||
+                (header.blockCount!=((header.height+header.rowsPerBlock-1)/header.rowsPerBlock)))
+        {
+                return NULL;
+        }
+        else
+        {
+                decoder->dataAddress = ADDRESS_IN_MEMORY+sizeof(header)+(header.blockCount*sizeof(uint32_t));
+        }
+        decoder->address = ADDRESS_IN_MEMORY;
+        decoder->format = header.format;
+        decoder->bitsPerPixel = header.bitsPerPixel;
+        decoder->dataEnd = decoder->dataAddress+header.dataSize;
+        decoder->width = header.width;
+        decoder->height = header.height;
+        decoder->rowsPerBlock = header.rowsPerBlock;
+        decoder->blockCount = header.blockCount;
+        decoder->paletteCount = (header.format==DISPLAY_IMAGE_FORMAT_INDEXED)?header.paletteCount:0;
+        //Past the end, so the first decode starts at a block
+        decoder->pixel = header.width*header.height;
+        decoder->bufferLength = 0;
+        decoder->runLeft = 0;
+        decoder->lastUsed = ++displayImageClock;
+        return decoder;
+}
+//Copies up to MAX_COLORS of the palette of an indexed image to COLORS
+//as RGB565, e.g. to make a darker one for displayImageSetPalette.
+//Returns the number of colors it has
+int displayImageGetPalette(int ADDRESS_IN_MEMORY, uint16_t COLORS[], int MAX_COLORS)
+{
+        displayImageDecoder_t *decoder = displayImageOpen(ADDRESS_IN_MEMORY);
+        int colorCount = 0;
+        if((decoder==NULL)||(decoder->format!=DISPLAY_IMAGE_FORMAT_INDEXED))
+        {
+                return 0;
+        }
+        colorCount = (decoder->paletteCount>MAX_COLORS)?MAX_COLORS:decoder->paletteCount;
+        memcpy(COLORS,decoder->palette,colorCount*sizeof(uint16_t));
+        displayImageSwapColors(COLORS,colorCount);
+        return colorCount;
+}
+//Draws every indexed image with COLORS instead of its own palette, for
+//themes and night mode. Indices past COLOR_COUNT are black. NULL goes
+//back to each image's own colors
+void displayImageSetPalette(const uint16_t COLORS[], int COLOR_COUNT)
+{
+        displayImageHasPalette = (COLORS!=NULL);
+        memset(displayImagePalette,0,sizeof(displayImagePalette));
+        if(COLORS!=NULL)
+        {
+                COLOR_COUNT = (COLOR_COUNT>DISPLAY_IMAGE_MAX_COLORS)?DISPLAY_IMAGE_MAX_COLORS:COLOR_COUNT;
+                memcpy(displayImagePalette,COLORS,COLOR_COUNT*sizeof(uint16_t));
+                displayImageSwapColors(displayImagePalette,COLOR_COUNT);
+        }
+}
+//Forgets every open image, for when flash has been rewritten
+void displayImageInvalidate(void)
+{
+        memset(displayImageDecoders,0,sizeof(displayImageDecoders));
+}
+static void displayImageFill(displayImageDecoder_t *DECODER)
+{
+        nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        DECODER->bufferAddress = DECODER->readAddress;
+        DECODER->bufferLength = DISPLAY_IMAGE_INPUT_CHUNK;
+        //The last chunk stops where the data ends, corrupt data that runs
+        //past it is read a byte at a time
+        if((DECODER->dataEnd-DECODER->bufferAddress)<DISPLAY_IMAGE_INPUT_CHUNK)
+        {
+                DECODER->bufferLength = (DECODER->dataEnd>DECODER->bufferAddress)?(DECODER->dataEnd-DECODER->bufferAddress):1;
+        }
+        ad_nvms_read(flashMemory, DECODER->bufferAddress, (uint8 *) DECODER->buffer, DECODER->bufferLength);
+        displayImageStats.flashBytesRead += DECODER->bufferLength;
+}
+//Bytes of compressed data at readAddress that are already buffered
+static int displayImageBuffered(displayImageDecoder_t *DECODER)
+{
+        int offset = DECODER->readAddress-DECODER->bufferAddress;
+        if((offset<0)||(offset>=DECODER->bufferLength))
+        {
+                displayImageFill(DECODER);
+                offset = 0;
+        }
+        return DECODER->bufferLength-offset;
+}
+//Copies SIZE compressed bytes to OUT, or steps over them if OUT is NULL
+static void displayImageTake(displayImageDecoder_t *DECODER, uint8_t OUT[], int SIZE)
+{
+        while(SIZE>0)
+        {
+                int chunkSize = 0;
+                if(OUT==NULL)
+                {
+                        DECODER->readAddress += SIZE;
+                        return;
+                }
+                chunkSize = displayImageBuffered(DECODER);
+                chunkSize = (chunkSize>SIZE)?SIZE:chunkSize;
+                memcpy(OUT,&DECODER->buffer[DECODER->readAddress-DECODER->bufferAddress],chunkSize);
+                DECODER->readAddress += chunkSize;
+                OUT += chunkSize;
+                SIZE -= chunkSize;
+        }
+}
+static void displayImageNextToken(displayImageDecoder_t *DECODER)
+{
+        uint8_t control = 0;
+        displayImageTake(DECODER,&control,1);
+        DECODER->isLiteral = control<DISPLAY_IMAGE_RLE_RUN;
+        if(DECODER->isLiteral)
+        {
+                DECODER->runLeft = control+1;
+        }
+        else
+        {
+                DECODER->runLeft = (control-DISPLAY_IMAGE_RLE_RUN)+1;
+                displayImageTake(DECODER,DECODER->runPixel,BYTES_PER_PIXEL);
+        }
+}
+//Decodes PIXEL_COUNT pixels from where the decoder is into OUT, or
+//skips them if OUT is NULL
+static void displayImageRun(displayImageDecoder_t *DECODER, uint8_t OUT[], int PIXEL_COUNT)
+{
+        DECODER->pixel += PIXEL_COUNT;
+        while(PIXEL_COUNT>0)
+        {
+                int count = 0;
+                if(DECODER->runLeft==0)
+                {
+                        displayImageNextToken(DECODER);
+                }
+                count = (DECODER->runLeft>PIXEL_COUNT)?PIXEL_COUNT:DECODER->runLeft;
+                if(DECODER->isLiteral)
+                {
+                        displayImageTake(DECODER,OUT,count*BYTES_PER_PIXEL);
+                }
+                else if(OUT!=NULL)
+                {
+                        for(int i=0;i<count;i++)
+                        {
+                                OUT[i*BYTES_PER_PIXEL] = DECODER->runPixel[0];
+                                OUT[(i*BYTES_PER_PIXEL)+1] = DECODER->runPixel[1];
+                        }
+                }
+                if(OUT!=NULL)
+                {
+                        OUT += count*BYTES_PER_PIXEL;
+                }
+                DECODER->runLeft -= count;
+                PIXEL_COUNT -= count;
+        }
+}
+//Index of the pixel BIT bits into IN, most significant first
+#define DISPLAY_IMAGE_INDEX(IN,BIT,BPP) (((IN)[(BIT)>>3]>>(8-(BPP)-((BIT)&7)))&((1<<(BPP))-1))
+
+//Turns COUNT indices starting BIT bits into IN into colors at OUT. IN
+//may be the end of OUT, each pair of indices is read before the word
+//they become is stored, two pixels at a time once OUT is word aligned
+static void displayImageExpand(const uint8_t IN[], int BIT, int BPP, const uint16_t PALETTE[], uint8_t OUT[], int COUNT)
+{
+        uint16_t *out16 = (uint16_t *)OUT;
+        uint32_t *out32;
+
+        if(((uintptr_t)OUT)&1)
+        {
+                //Not halfword aligned, only ever from a caller's own buffer
+                for(;COUNT>0;COUNT--,BIT+=BPP)
+                {
+                        uint16_t color = PALETTE[DISPLAY_IMAGE_INDEX(IN,BIT,BPP)];
+                        *OUT++ = color & 0xFF;
+                        *OUT++ = color >> 8;
+                }
+                return;
+        }
+        if((((uintptr_t)out16)&2)&&(COUNT>0))
+        {
+                *out16++ = PALETTE[DISPLAY_IMAGE_INDEX(IN,BIT,BPP)];
+                BIT += BPP;
+                COUNT--;
+        }
+        out32 = (uint32_t *)out16;
+        for(;COUNT>=2;COUNT-=2)
+        {
+                uint32_t first = PALETTE[DISPLAY_IMAGE_INDEX(IN,BIT,BPP)];
+                uint32_t second = PALETTE[DISPLAY_IMAGE_INDEX(IN,BIT+BPP,BPP)];
+                *out32++ = first|(second<<16);
+                BIT += 2*BPP;
+        }
+        if(COUNT>0)
+        {
+                *(uint16_t *)out32 = PALETTE[DISPLAY_IMAGE_INDEX(IN,BIT,BPP)];
+        }
+}
+//Indexed rows are read straight into the end of OUT, a quarter to half
+//the size of the colors they become, and expanded in place
+static void displayImageDecodeIndexed(displayImageDecoder_t *DECODER, int PIXEL, uint8_t OUT[], int PIXEL_COUNT)
+{
+        nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        const uint16_t *palette = displayImageHasPalette?displayImagePalette:DECODER->palette;
+
+        while(PIXEL_COUNT>0)
+        {
+                int y = PIXEL/DECODER->width;
+                int x = PIXEL%DECODER->width;
+                int count = ((DECODER->width-x)>PIXEL_COUNT)?PIXEL_COUNT:(DECODER->width-x);
+                int firstBit = x*DECODER->bitsPerPixel;
+                int firstByte = firstBit>>3;
+                int readSize = ((((x+count)*DECODER->bitsPerPixel)+7)>>3)-firstByte;
+                uint8_t *indices = &OUT[(count*BYTES_PER_PIXEL)-readSize];
+                ad_nvms_read(flashMemory, DECODER->dataAddress+(y*DECODER->rowBytes)+firstByte, (uint8 *) indices, readSize);
+                displayImageStats.flashBytesRead += readSize;
+                displayImageExpand(indices,firstBit&7,DECODER->bitsPerPixel,palette,OUT,count);
+                OUT += count*BYTES_PER_PIXEL;
+                PIXEL += count;
+                PIXEL_COUNT -= count;
+        }
+}
+//Decodes PIXEL_COUNT pixels starting at pixel PIXEL of the image, row
+//by row from the top left, into OUT as RGB565 ready for the panel
+void displayImageDecode(displayImageDecoder_t *DECODER, int PIXEL, uint8_t OUT[], int PIXEL_COUNT)
+{
+        int blockPixels = DECODER->width*DECODER->rowsPerBlock;
+        int block = 0;
+
+        if(DECODER->format==DISPLAY_IMAGE_FORMAT_INDEXED)
+        {
+                displayImageDecodeIndexed(DECODER,PIXEL,OUT,PIXEL_COUNT);
+                displayImageStats.pixelsDecoded += PIXEL_COUNT;
+                DECODER->lastUsed = ++displayImageClock;
+                return;
+        }
+        block = PIXEL/blockPixels;
+
+        if((PIXEL<DECODER->pixel)||(block!=(DECODER->pixel/blockPixels)))
+        {
+                nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+                uint32_t blockOffset = 0;
+                ad_nvms_read(flashMemory, DECODER->address+sizeof(displayImageHeader_t)+(block*sizeof(uint32_t)),
+                             (uint8 *) &blockOffset, sizeof(blockOffset));
+                DECODER->readAddress = DECODER->dataAddress+blockOffset;
+                DECODER->pixel = block*blockPixels;
+                DECODER->runLeft = 0;
+                displayImageStats.blockSeeks++;
+        }
+        displayImageStats.pixelsSkipped += PIXEL-DECODER->pixel;
+        displayImageRun(DECODER,NULL,PIXEL-DECODER->pixel);
+        displayImageRun(DECODER,OUT,PIXEL_COUNT);
+        displayImageStats.pixelsDecoded += PIXEL_COUNT;
+        DECODER->lastUsed = ++displayImageClock;
+}
+void displayGetImageStats(displayImageStats_t *STATS)
+{
+        *STATS = displayImageStats;
+}
+void displayResetImageStats(void)
+{
+        memset(&displayImageStats,0,sizeof(displayImageStats));
+}
@@ -0,0 +1,96 @@
+/*
+ * displayImage.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef DISPLAYIMAGE_H_
+#define DISPLAYIMAGE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Raw images start with their width, which is never 0, so a 0 first
+//byte means the second byte is one of these formats
+#define DISPLAY_IMAGE_FORMAT_RAW 0
+#define DISPLAY_IMAGE_FORMAT_RLE16 1
+#define DISPLAY_IMAGE_FORMAT_INDEXED 2
+//Largest palette of an indexed image, 8 bits per pixel
+#define DISPLAY_IMAGE_MAX_COLORS 256
+//Compressed images kept open at a time
+#define DISPLAY_IMAGE_DECODERS 2
+//Compressed bytes read from flash at a time
+#define DISPLAY_IMAGE_INPUT_CHUNK 64
+//A control byte below this starts control+1 literal pixels, from it on
+//the next pixel repeated (control-DISPLAY_IMAGE_RLE_RUN)+1 times
+#define DISPLAY_IMAGE_RLE_RUN 0x80
+
+//Header of an image that isn't raw. An RLE16 image is followed by
+//blockCount 32 bit offsets of each block from the start of the data and
+//then the data. A block is rowsPerBlock rows encoded on their own, so
+//decoding can start at any block. Rows are exactly width pixels.
+//An indexed image is followed by paletteCount RGB565 colors and then
+//rows of bitsPerPixel indices, most significant first, each row
+//starting on a new byte
+typedef struct
+{
+        uint8_t marker;
+        uint8_t format;
+        uint8_t width;
+        uint8_t height;
+        uint16_t rowsPerBlock;
+        uint16_t blockCount;
+        uint32_t dataSize;
+        uint8_t bitsPerPixel;
+        uint8_t reserved;
+        uint16_t paletteCount;
+} displayImageHeader_t;
+
+//Where a compressed image is being decoded. Only moves forward, going
+//back or far ahead restarts at a block. Indexed images are read where
+//they are asked for and only use the palette, kept ready to store in
+//panel byte order
+typedef struct
+{
+        int32_t address;
+        uint8_t format;
+        uint8_t bitsPerPixel;
+        uint16_t rowBytes;
+        int32_t dataAddress;
+        int32_t dataEnd;
+        int32_t readAddress;
+        int32_t bufferAddress;
+        int32_t pixel;
+        uint32_t lastUsed;
+        uint16_t width;
+        uint16_t height;
+        uint16_t rowsPerBlock;
+        uint16_t blockCount;
+        uint16_t bufferLength;
+        uint16_t runLeft;
+        uint16_t paletteCount;
+        bool isLiteral;
+        uint8_t runPixel[2];
+        uint8_t buffer[DISPLAY_IMAGE_INPUT_CHUNK];
+        uint16_t palette[DISPLAY_IMAGE_MAX_COLORS];
+} displayImageDecoder_t;
+
+typedef struct
+{
+        uint32_t pixelsDecoded;
+        uint32_t pixelsSkipped;
+        uint32_t blockSeeks;
+        uint32_t flashBytesRead;
+} displayImageStats_t;
+
+bool displayImageIsCompressed(int ADDRESS_IN_MEMORY);
+displayImageDecoder_t *displayImageOpen(int ADDRESS_IN_MEMORY);
+void displayImageDecode(displayImageDecoder_t *DECODER, int PIXEL, uint8_t OUT[], int PIXEL_COUNT);
+int  displayImageGetPalette(int ADDRESS_IN_MEMORY, uint16_t COLORS[], int MAX_COLORS);
+void displayImageSetPalette(const uint16_t COLORS[], int COLOR_COUNT);
+void displayImageInvalidate(void);
+void displayGetImageStats(displayImageStats_t *STATS);
+void displayResetImageStats(void);
+
+#endif /* DISPLAYIMAGE_H_ */
@@ -0,0 +1,628 @@
+/*
+ * displayList.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include "displayList.h"
+#include "displayDriver.h"
+#include "displayGlyphs.h"
+#include "displayImage.h"
+#include "displayAssets.h"
+#include "ad_nvms.h"
+
+//Draw calls made while recording are kept here and replayed one band
+//at a time into a RAM strip, so overlapping shapes cost RAM writes and
+//the panel only sees one window and one burst per band
+static displayListItem_t displayListItems[DISPLAY_LIST_MAX_ITEMS];
+static int displayListCount = 0;
+//Polygon outlines, items point into this
+static displayPoint_t displayListPoints[DISPLAY_LIST_MAX_POINTS];
+static int displayListPointCount = 0;
+static bool displayListRecording = false;
+static uint16_t displayListBackgroundColor = DISPLAY_BLACK;
+static int displayListBackgroundAddress = -1;
+static int displayListBackgroundStride = 0;
+static bool displayListBackgroundIsCompressed = false;
+//Rendered region when it is set rather than taken from the items
+static displayRect_t displayListRegion;
+static bool displayListHasRegion = false;
+static displayListStats_t displayListStats = {0};
+
+static int displayListMin(int A, int B)
+{
+        return (A<B)?A:B;
+}
+static int displayListMax(int A, int B)
+{
+        return (A>B)?A:B;
+}
+static void displayListStart(void)
+{
+        displayListCount = 0;
+        displayListPointCount = 0;
+        displayListHasRegion = false;
+        displayListRecording = true;
+}
+//Starts recording, the rendered region starts out as BACKGROUND_COLOR
+void displayListBegin(int BACKGROUND_COLOR)
+{
+        displayListBackgroundColor = BACKGROUND_COLOR;
+        displayListBackgroundAddress = -1;
+        displayListStart();
+}
+//Starts recording, the rendered region starts out as the matching part
+//of a full screen image asset, e.g. the watch face. The directory has
+//its format and padded stride, which the image header can't always
+//say. A pack without it leaves a black background
+void displayListBeginOverImage(uint32_t ASSET_ID)
+{
+        const displayAsset_t *asset = displayAssetFind(ASSET_ID);
+        bool isCompressed = (asset!=NULL)&&
+                            ((asset->format==DISPLAY_IMAGE_FORMAT_RLE16)||(asset->format==DISPLAY_IMAGE_FORMAT_INDEXED));
+
+        if((asset==NULL)||(!isCompressed&&(asset->format!=DISPLAY_IMAGE_FORMAT_RAW))||
+           (isCompressed&&(displayImageOpen(displayAssetFlashAddress(asset))==NULL)))
+        {
+                displayListBegin(DISPLAY_BLACK);
+                return;
+        }
+        displayListBackgroundAddress = displayAssetFlashAddress(asset);
+        displayListBackgroundStride = asset->stride;
+        displayListBackgroundIsCompressed = isCompressed;
+        displayListStart();
+}
+bool displayListIsRecording(void)
+{
+        return displayListRecording;
+}
+//Renders exactly REGION whatever is recorded, e.g. to put back the
+//background where something used to be
+void displayListSetRegion(const displayRect_t *REGION)
+{
+        displayListRegion = *REGION;
+        displayListHasRegion = true;
+}
+//Bounding box of everything recorded, or the region that was set,
+//clipped to the screen
+static bool displayListGetRegion(displayRect_t *REGION)
+{
+        if(displayListHasRegion)
+        {
+                *REGION = displayListRegion;
+        }
+        else if(displayListCount==0)
+        {
+                return false;
+        }
+        else
+        {
+                *REGION = displayListItems[0].bounds;
+        }
+        for(int i=(displayListHasRegion?displayListCount:1);i<displayListCount;i++)
+        {
+                REGION->xStart = displayListMin(REGION->xStart,displayListItems[i].bounds.xStart);
+                REGION->xEnd = displayListMax(REGION->xEnd,displayListItems[i].bounds.xEnd);
+                REGION->yStart = displayListMin(REGION->yStart,displayListItems[i].bounds.yStart);
+                REGION->yEnd = displayListMax(REGION->yEnd,displayListItems[i].bounds.yEnd);
+        }
+        REGION->xStart = displayListMax(REGION->xStart,ST7789_XSTART);
+        REGION->xEnd = displayListMin(REGION->xEnd,ST7789_WIDTH-1);
+        REGION->yStart = displayListMax(REGION->yStart,ST7789_YSTART);
+        REGION->yEnd = displayListMin(REGION->yEnd,ST7789_HEIGHT-1);
+        return (REGION->xStart<=REGION->xEnd)&&(REGION->yStart<=REGION->yEnd);
+}
+static void displayListSendBand(const displayRect_t *BAND, const uint8_t *PIXELS, int SIZE, void *USER_DATA)
+{
+        displayWriteDataBufAsync(PIXELS,SIZE);
+}
+//Pushes the recorded region to the panel and empties the list. The
+//region is used up with it, so nothing renders it a second time
+static void displayListFlush(void)
+{
+        displayRect_t region;
+        if(displayListGetRegion(&region))
+        {
+                displayBeginTransaction();
+                displaySetWindow(region.xStart,region.xEnd,region.yStart,region.yEnd);
+                displayListRenderTo(displayListSendBand,NULL);
+                displayEndTransaction();
+        }
+        displayListCount = 0;
+        displayListPointCount = 0;
+        displayListHasRegion = false;
+}
+//Stops recording and pushes the recorded region to the panel
+void displayListEnd(void)
+{
+        displayListRecording = false;
+        displayListFlush();
+}
+//Out of room. What is recorded goes to the panel as it stands and the
+//calls still to come until displayListEnd are drawn directly on top of
+//it. A second batch can't carry on, its background would paint over
+//whatever the first one drew inside its bounds
+static void displayListOverflow(void)
+{
+        displayListStats.overflows++;
+        displayListFlush();
+        displayListRecording = false;
+}
+//Returns a free slot, or NULL when the call should be drawn directly
+static displayListItem_t *displayListNewItem(displayListItemType_t TYPE, int COLOR, int XSTART, int XEND, int YSTART, int YEND)
+{
+        displayListItem_t *item;
+        if(!displayListRecording)
+        {
+                return NULL;
+        }
+        if(displayListCount==DISPLAY_LIST_MAX_ITEMS)
+        {
+                displayListOverflow();
+                return NULL;
+        }
+        item = &displayListItems[displayListCount++];
+        item->type = TYPE;
+        item->thickness = 1;
+        item->color = COLOR;
+        item->bounds.xStart = displayListMin(XSTART,XEND);
+        item->bounds.xEnd = displayListMax(XSTART,XEND);
+        item->bounds.yStart = displayListMin(YSTART,YEND);
+        item->bounds.yEnd = displayListMax(YSTART,YEND);
+        displayListStats.itemsRecorded++;
+        return item;
+}
+bool displayListAddRect(int XSTART, int XEND, int YSTART, int YEND, int COLOR)
+{
+        return displayListNewItem(DISPLAY_LIST_RECT,COLOR,XSTART,XEND,YSTART,YEND)!=NULL;
+}
+//Lines thicker than a pixel are drawn as displayThickLineQuad outlines
+bool displayListAddLine(int START_X, int END_X, int START_Y, int END_Y, int COLOR, int THICKNESS)
+{
+        //A square end on a diagonal reaches out further than half a width
+        int margin = 0;
+        displayListItem_t *item;
+        if(THICKNESS<1)
+        {
+                THICKNESS = 1;
+        }
+        if(THICKNESS>1)
+        {
+                margin = THICKNESS;
+        }
+        item = displayListNewItem(DISPLAY_LIST_LINE,COLOR,
+                                  displayListMin(START_X,END_X)-margin,displayListMax(START_X,END_X)+margin,
+                                  displayListMin(START_Y,END_Y)-margin,displayListMax(START_Y,END_Y)+margin);
+        if(item==NULL)
+        {
+                return false;
+        }
+        item->thickness = THICKNESS;
+        item->line.startX = START_X;
+        item->line.startY = START_Y;
+        item->line.endX = END_X;
+        item->line.endY = END_Y;
+        return true;
+}
+bool displayListAddCircle(int CENTER_X, int CENTER_Y, int RADIUS, int COLOR)
+{
+        displayListItem_t *item = displayListNewItem(DISPLAY_LIST_CIRCLE,COLOR,
+                                                     CENTER_X-RADIUS+1,CENTER_X+RADIUS-1,
+                                                     CENTER_Y-RADIUS+1,CENTER_Y+RADIUS-1);
+        if(item==NULL)
+        {
+                return false;
+        }
+        item->circle.centerX = CENTER_X;
+        item->circle.centerY = CENTER_Y;
+        item->circle.radius = RADIUS;
+        return true;
+}
+bool displayListAddPolygon(const displayPoint_t POINTS[], int POINT_COUNT, int COLOR)
+{
+        displayListItem_t *item;
+        int xMin = POINTS[0].x;
+        int xMax = POINTS[0].x;
+        int yMin = POINTS[0].y;
+        int yMax = POINTS[0].y;
+        if(!displayListRecording)
+        {
+                return false;
+        }
+        if((POINT_COUNT>DISPLAY_LIST_MAX_POINTS)||(displayListPointCount+POINT_COUNT>DISPLAY_LIST_MAX_POINTS))
+        {
+                displayListOverflow();
+                return false;
+        }
+        for(int i=1;i<POINT_COUNT;i++)
+        {
+                xMin = displayListMin(xMin,POINTS[i].x);
+                xMax = displayListMax(xMax,POINTS[i].x);
+                yMin = displayListMin(yMin,POINTS[i].y);
+                yMax = displayListMax(yMax,POINTS[i].y);
+        }
+        item = displayListNewItem(DISPLAY_LIST_POLYGON,COLOR,
+                                  xMin>>DISPLAY_SUBPIXEL_BITS,xMax>>DISPLAY_SUBPIXEL_BITS,
+                                  yMin>>DISPLAY_SUBPIXEL_BITS,yMax>>DISPLAY_SUBPIXEL_BITS);
+        if(item==NULL)
+        {
+                return false;
+        }
+        item->polygon.firstPoint = displayListPointCount;
+        item->polygon.pointCount = POINT_COUNT;
+        memcpy(&displayListPoints[displayListPointCount],POINTS,POINT_COUNT*sizeof(displayPoint_t));
+        displayListPointCount += POINT_COUNT;
+        return true;
+}
+//A mask glyph, blended over what is under it in COLOR
+bool displayListAddGlyph(int XSTART, int YSTART, int WIDTH, int HEIGHT, int CODEPOINT, int COLOR)
+{
+        displayListItem_t *item = displayListNewItem(DISPLAY_LIST_GLYPH,COLOR,
+                                                     XSTART,XSTART+WIDTH-1,
+                                                     YSTART,YSTART+HEIGHT-1);
+        if(item==NULL)
+        {
+                return false;
+        }
+        item->glyph.codepoint = CODEPOINT;
+        return true;
+}
+//Spans of a hand sprite, read from flash as the bands reach them
+bool displayListAddHandSprite(int X_CENTER, int Y_CENTER, const displayHandSprite_t *SPRITE, int COLOR)
+{
+        displayListItem_t *item = displayListNewItem(DISPLAY_LIST_HAND_SPRITE,COLOR,
+                                                     X_CENTER+SPRITE->xMin,X_CENTER+SPRITE->xMax,
+                                                     Y_CENTER+SPRITE->yMin,Y_CENTER+SPRITE->yMax);
+        if(item==NULL)
+        {
+                return false;
+        }
+        item->handSprite.address = displayHandSpriteSpanAddress(SPRITE);
+        item->handSprite.centerX = X_CENTER;
+        item->handSprite.centerY = Y_CENTER;
+        item->handSprite.spanCount = SPRITE->spanCount;
+        item->handSprite.nextSpan = 0;
+        return true;
+}
+//STRIDE is the width of a stored image row in pixels
+bool displayListAddImage(int SCREEN_XSTART, int SCREEN_YSTART, int IMAGE_XSTART, int IMAGE_YSTART, int WIDTH, int HEIGHT, int STRIDE, int ADDRESS_IN_MEMORY)
+{
+        displayListItem_t *item = displayListNewItem(DISPLAY_LIST_IMAGE,0,
+                                                     SCREEN_XSTART,SCREEN_XSTART+WIDTH-1,
+                                                     SCREEN_YSTART,SCREEN_YSTART+HEIGHT-1);
+        if(item==NULL)
+        {
+                return false;
+        }
+        item->image.address = ADDRESS_IN_MEMORY;
+        item->image.imageX = IMAGE_XSTART;
+        item->image.imageY = IMAGE_YSTART;
+        item->image.stride = STRIDE;
+        item->image.isCompressed = displayImageIsCompressed(ADDRESS_IN_MEMORY);
+        return true;
+}
+
+//Fills one row of the band from XSTART to XEND, clipped to the band
+static void displayStripSpan(uint8_t STRIP[], const displayRect_t *BAND, int Y, int XSTART, int XEND, uint16_t COLOR)
+{
+        uint8_t colorHigh = COLOR >> 8;
+        uint8_t colorLow = COLOR & 0xFF;
+        uint8_t *pixel;
+        if((Y<BAND->yStart)||(Y>BAND->yEnd))
+        {
+                return;
+        }
+        XSTART = displayListMax(XSTART,BAND->xStart);
+        XEND = displayListMin(XEND,BAND->xEnd);
+        pixel = &STRIP[(((Y-BAND->yStart)*(BAND->xEnd-BAND->xStart+1))+(XSTART-BAND->xStart))*BYTES_PER_PIXEL];
+        for(int x=XSTART;x<=XEND;x++)
+        {
+                *pixel++ = colorHigh;
+                *pixel++ = colorLow;
+        }
+}
+//Copies part of an image row from flash straight into the band
+static void displayStripImageRow(nvms_t FLASH, uint8_t STRIP[], const displayRect_t *BAND, int Y, int XSTART, int XEND, int ROW_ADDRESS, int ROW_XSTART)
+{
+        int firstX = displayListMax(XSTART,BAND->xStart);
+        int lastX = displayListMin(XEND,BAND->xEnd);
+        if((Y<BAND->yStart)||(Y>BAND->yEnd)||(firstX>lastX))
+        {
+                return;
+        }
+        ad_nvms_read(FLASH, ROW_ADDRESS+((firstX-ROW_XSTART)*BYTES_PER_PIXEL),
+                     (uint8 *) &STRIP[(((Y-BAND->yStart)*(BAND->xEnd-BAND->xStart+1))+(firstX-BAND->xStart))*BYTES_PER_PIXEL],
+                     (lastX-firstX+1)*BYTES_PER_PIXEL);
+}
+//Same for a compressed image, ROW_PIXEL is the index in the image of
+//the pixel at ROW_XSTART
+static void displayStripDecodedRow(uint8_t STRIP[], const displayRect_t *BAND, int Y, int XSTART, int XEND, int ADDRESS_IN_MEMORY, int ROW_PIXEL, int ROW_XSTART)
+{
+        int firstX = displayListMax(XSTART,BAND->xStart);
+        int lastX = displayListMin(XEND,BAND->xEnd);
+        displayImageDecoder_t *decoder;
+        if((Y<BAND->yStart)||(Y>BAND->yEnd)||(firstX>lastX)||((decoder = displayImageOpen(ADDRESS_IN_MEMORY))==NULL))
+        {
+                return;
+        }
+        displayImageDecode(decoder,ROW_PIXEL+(firstX-ROW_XSTART),
+                           &STRIP[(((Y-BAND->yStart)*(BAND->xEnd-BAND->xStart+1))+(firstX-BAND->xStart))*BYTES_PER_PIXEL],
+                           lastX-firstX+1);
+}
+typedef struct
+{
+        uint8_t *strip;
+        const displayRect_t *band;
+} displayStripTarget_t;
+
+static void displayStripPolygonSpan(int Y, int XSTART, int XEND, int COLOR, void *USER_DATA)
+{
+        displayStripTarget_t *target = USER_DATA;
+        displayStripSpan(target->strip,target->band,Y,XSTART,XEND,COLOR);
+}
+static void displayStripPolygon(uint8_t STRIP[], const displayRect_t *BAND, const displayPoint_t POINTS[], int POINT_COUNT, int COLOR)
+{
+        displayStripTarget_t target = {STRIP,BAND};
+        displayPolygonRasterize(POINTS,POINT_COUNT,BAND->yStart,BAND->yEnd,COLOR,displayStripPolygonSpan,&target);
+}
+static void displayStripLine(uint8_t STRIP[], const displayRect_t *BAND, const displayListItem_t *ITEM)
+{
+        int x = ITEM->line.startX;
+        int y = ITEM->line.startY;
+        int deltaX = abs(ITEM->line.endX-x);
+        int xIncrement = x<ITEM->line.endX ? 1 : -1;
+        int deltaY = abs(ITEM->line.endY-y);
+        int yIncrement = y<ITEM->line.endY ? 1 : -1;
+        int lineError = (deltaX>deltaY ? deltaX : -deltaY)/2;
+        int oldLineError;
+
+        if(ITEM->thickness>1)
+        {
+                displayPoint_t quad[4];
+                int pointCount = displayThickLineQuad(ITEM->line.startX,ITEM->line.endX,ITEM->line.startY,ITEM->line.endY,ITEM->thickness,quad);
+                displayStripPolygon(STRIP,BAND,quad,pointCount,ITEM->color);
+                return;
+        }
+        for(;;)
+        {
+                //The line only moves one way in y, stop once it has left the band
+                if(((yIncrement>0)&&(y>BAND->yEnd))||((yIncrement<0)&&(y<BAND->yStart)))
+                {
+                        break;
+                }
+                displayStripSpan(STRIP,BAND,y,x,x,ITEM->color);
+                if (x==ITEM->line.endX && y==ITEM->line.endY) break;
+                oldLineError = lineError;
+                if (oldLineError >-deltaX)
+                {
+                        lineError -= deltaY;
+                        x += xIncrement;
+                }
+                if (oldLineError < deltaY)
+                {
+                        lineError += deltaX;
+                        y += yIncrement;
+                }
+        }
+}
+static void displayStripCircle(uint8_t STRIP[], const displayRect_t *BAND, const displayListItem_t *ITEM)
+{
+        int centerX = ITEM->circle.centerX;
+        int centerY = ITEM->circle.centerY;
+        int x = ITEM->circle.radius-1;
+        int y = 0;
+        int dx = 1;
+        int dy = 1;
+        int err = dx-(ITEM->circle.radius<<1);
+
+        while(x>=y)
+        {
+                displayStripSpan(STRIP,BAND,centerY+x,centerX-y,centerX-y,ITEM->color);
+                displayStripSpan(STRIP,BAND,centerY+x,centerX+y,centerX+y,ITEM->color);
+                displayStripSpan(STRIP,BAND,centerY+y,centerX-x,centerX-x,ITEM->color);
+                displayStripSpan(STRIP,BAND,centerY+y,centerX+x,centerX+x,ITEM->color);
+                displayStripSpan(STRIP,BAND,centerY-y,centerX-x,centerX-x,ITEM->color);
+                displayStripSpan(STRIP,BAND,centerY-y,centerX+x,centerX+x,ITEM->color);
+                displayStripSpan(STRIP,BAND,centerY-x,centerX-y,centerX-y,ITEM->color);
+                displayStripSpan(STRIP,BAND,centerY-x,centerX+y,centerX+y,ITEM->color);
+
+                if(err <=0)
+                {
+                        y++;
+                        err += dy;
+                        dy += 2;
+                }
+                else
+                {
+                        x--;
+                        dx += 2;
+                        err += dx -(ITEM->circle.radius<<1);
+                }
+        }
+}
+static void displayStripImage(nvms_t FLASH, uint8_t STRIP[], const displayRect_t *BAND, const displayListItem_t *ITEM)
+{
+        int firstY = displayListMax(ITEM->bounds.yStart,BAND->yStart);
+        int lastY = displayListMin(ITEM->bounds.yEnd,BAND->yEnd);
+        int rowAddress = 0;
+        for(int y=firstY;y<=lastY;y++)
+        {
+                if(ITEM->image.isCompressed)
+                {
+                        displayStripDecodedRow(STRIP,BAND,y,ITEM->bounds.xStart,ITEM->bounds.xEnd,ITEM->image.address,
+                                               ((ITEM->image.imageY+(y-ITEM->bounds.yStart))*ITEM->image.stride)+ITEM->image.imageX,ITEM->bounds.xStart);
+                        continue;
+                }
+                rowAddress = ITEM->image.address+2+
+                             ((((ITEM->image.imageY+(y-ITEM->bounds.yStart))*ITEM->image.stride)+ITEM->image.imageX)*BYTES_PER_PIXEL);
+                displayStripImageRow(FLASH,STRIP,BAND,y,ITEM->bounds.xStart,ITEM->bounds.xEnd,rowAddress,ITEM->bounds.xStart);
+        }
+}
+static void displayStripGlyph(uint8_t STRIP[], const displayRect_t *BAND, const displayListItem_t *ITEM)
+{
+        const displayGlyph_t *glyph = displayGlyphFind(ITEM->glyph.codepoint);
+        const uint8_t *mask;
+        int firstX = displayListMax(ITEM->bounds.xStart,BAND->xStart);
+        int lastX = displayListMin(ITEM->bounds.xEnd,BAND->xEnd);
+        int firstY = displayListMax(ITEM->bounds.yStart,BAND->yStart);
+        int lastY = displayListMin(ITEM->bounds.yEnd,BAND->yEnd);
+
+        if((glyph==NULL)||((mask = displayGlyphGetMask(glyph))==NULL))
+        {
+                return;
+        }
+        for(int y=firstY;y<=lastY;y++)
+        {
+                uint8_t *pixel = &STRIP[(((y-BAND->yStart)*(BAND->xEnd-BAND->xStart+1))+(firstX-BAND->xStart))*BYTES_PER_PIXEL];
+                for(int x=firstX;x<=lastX;x++,pixel+=BYTES_PER_PIXEL)
+                {
+                        int alpha = displayGlyphAlpha(glyph,mask,x-ITEM->bounds.xStart,y-ITEM->bounds.yStart);
+                        int color = 0;
+                        if(alpha==0)
+                        {
+                                continue;
+                        }
+                        color = displayBlendColor(ITEM->color,(pixel[0]<<8)|pixel[1],alpha);
+                        pixel[0] = color >> 8;
+                        pixel[1] = color & 0xFF;
+                }
+        }
+}
+//Bands go top to bottom and the spans are sorted by row, so each item
+//keeps its place and every span is read once per render. Enough spans
+//are read for two runs per row of the band
+static void displayStripHandSprite(nvms_t FLASH, uint8_t STRIP[], const displayRect_t *BAND, displayListItem_t *ITEM)
+{
+        displayHandSpan_t spans[DISPLAY_HAND_SPRITE_CHUNK];
+        int chunkSize = displayListMin(DISPLAY_HAND_SPRITE_CHUNK,(BAND->yEnd-BAND->yStart+1)*2);
+
+        while(ITEM->handSprite.nextSpan<ITEM->handSprite.spanCount)
+        {
+                int count = displayListMin(chunkSize,ITEM->handSprite.spanCount-ITEM->handSprite.nextSpan);
+                ad_nvms_read(FLASH, ITEM->handSprite.address+(ITEM->handSprite.nextSpan*sizeof(displayHandSpan_t)),
+                             (uint8 *) spans, count*sizeof(displayHandSpan_t));
+                for(int i=0;i<count;i++)
+                {
+                        int y = ITEM->handSprite.centerY+spans[i].y;
+                        int xStart = ITEM->handSprite.centerX+spans[i].xStart;
+                        if(y>BAND->yEnd)
+                        {
+                                return;
+                        }
+                        displayStripSpan(STRIP,BAND,y,xStart,xStart+spans[i].length-1,ITEM->color);
+                        ITEM->handSprite.nextSpan++;
+                }
+        }
+}
+static void displayStripBackground(nvms_t FLASH, uint8_t STRIP[], const displayRect_t *BAND)
+{
+        for(int y=BAND->yStart;y<=BAND->yEnd;y++)
+        {
+                if(displayListBackgroundAddress<0)
+                {
+                        displayStripSpan(STRIP,BAND,y,BAND->xStart,BAND->xEnd,displayListBackgroundColor);
+                }
+                else if(displayListBackgroundIsCompressed)
+                {
+                        displayStripDecodedRow(STRIP,BAND,y,BAND->xStart,BAND->xEnd,displayListBackgroundAddress,y*displayListBackgroundStride,0);
+                }
+                else
+                {
+                        displayStripImageRow(FLASH,STRIP,BAND,y,BAND->xStart,BAND->xEnd,
+                                             displayListBackgroundAddress+2+(y*displayListBackgroundStride*BYTES_PER_PIXEL),0);
+                }
+        }
+}
+//Replays the list band by band into the blit buffers and hands each
+//band to OUTPUT, top to bottom. The list is left as it is so a host
+//build can pass its own OUTPUT and dump the composited frame
+void displayListRenderTo(displayListOutput_t OUTPUT, void *USER_DATA)
+{
+        displayRect_t region;
+        displayRect_t band;
+        nvms_t flashMemory;
+        int regionWidth = 0;
+        int rowsPerBand = 0;
+        int currentBuffer = 0;
+        uint8_t *strip;
+
+        if(!displayListGetRegion(&region))
+        {
+                return;
+        }
+        flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
+        regionWidth = region.xEnd-region.xStart+1;
+        rowsPerBand = SPI_WRITE_BUFFER_SIZE/(regionWidth*BYTES_PER_PIXEL);
+        band.xStart = region.xStart;
+        band.xEnd = region.xEnd;
+        for(int i=0;i<displayListCount;i++)
+        {
+                if(displayListItems[i].type==DISPLAY_LIST_HAND_SPRITE)
+                {
+                        displayListItems[i].handSprite.nextSpan = 0;
+                }
+        }
+        //A previous blit may still own one of the buffers
+        displayWaitDataBuf();
+        for(int bandY=region.yStart;bandY<=region.yEnd;bandY+=rowsPerBand)
+        {
+                band.yStart = bandY;
+                band.yEnd = displayListMin(bandY+rowsPerBand-1,region.yEnd);
+                strip = displayGetBlitBuffer(currentBuffer);
+                displayStripBackground(flashMemory,strip,&band);
+                for(int i=0;i<displayListCount;i++)
+                {
+                        const displayListItem_t *item = &displayListItems[i];
+                        if((item->bounds.yEnd<band.yStart)||(item->bounds.yStart>band.yEnd)||
+                           (item->bounds.xEnd<band.xStart)||(item->bounds.xStart>band.xEnd))
+                        {
+                                continue;
+                        }
+                        switch(item->type)
+                        {
+                                case DISPLAY_LIST_RECT:
+                                        for(int y=displayListMax(item->bounds.yStart,band.yStart);y<=displayListMin(item->bounds.yEnd,band.yEnd);y++)
+                                        {
+                                                displayStripSpan(strip,&band,y,item->bounds.xStart,item->bounds.xEnd,item->color);
+                                        }
+                                        break;
+                                case DISPLAY_LIST_LINE:
+                                        displayStripLine(strip,&band,item);
+                                        break;
+                                case DISPLAY_LIST_CIRCLE:
+                                        displayStripCircle(strip,&band,item);
+                                        break;
+                                case DISPLAY_LIST_IMAGE:
+                                        displayStripImage(flashMemory,strip,&band,item);
+                                        break;
+                                case DISPLAY_LIST_POLYGON:
+                                        displayStripPolygon(strip,&band,&displayListPoints[item->polygon.firstPoint],item->polygon.pointCount,item->color);
+                                        break;
+                                case DISPLAY_LIST_GLYPH:
+                                        displayStripGlyph(strip,&band,item);
+                                        break;
+                                case DISPLAY_LIST_HAND_SPRITE:
+                                        displayStripHandSprite(flashMemory,strip,&band,&displayListItems[i]);
+                                        break;
+                                default:
+                                        break;
+                        }
+                }
+                OUTPUT(&band,strip,regionWidth*(band.yEnd-band.yStart+1)*BYTES_PER_PIXEL,USER_DATA);
+                displayListStats.bandsRendered++;
+                displayListStats.bytesRendered += regionWidth*(band.yEnd-band.yStart+1)*BYTES_PER_PIXEL;
+                currentBuffer ^= 1;
+        }
+}
+void displayListGetStats(displayListStats_t *STATS)
+{
+        *STATS = displayListStats;
+}
+void displayListResetStats(void)
+{
+        memset(&displayListStats,0,sizeof(displayListStats));
+}
@@ -0,0 +1,107 @@
+/*
+ * displayList.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef DISPLAYLIST_H_
+#define DISPLAYLIST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "displayDamage.h"
+#include "displayPolygon.h"
+#include "displayHandSprite.h"
+
+#define DISPLAY_LIST_MAX_ITEMS 96
+#define DISPLAY_LIST_MAX_POINTS 64
+
+typedef enum
+{
+        DISPLAY_LIST_RECT,
+        DISPLAY_LIST_LINE,
+        DISPLAY_LIST_CIRCLE,
+        DISPLAY_LIST_IMAGE,
+        DISPLAY_LIST_POLYGON,
+        DISPLAY_LIST_GLYPH,
+        DISPLAY_LIST_HAND_SPRITE
+} displayListItemType_t;
+
+typedef struct
+{
+        uint8_t type;
+        uint8_t thickness;
+        uint16_t color;
+        displayRect_t bounds;
+        union
+        {
+                struct
+                {
+                        int16_t startX;
+                        int16_t startY;
+                        int16_t endX;
+                        int16_t endY;
+                } line;
+                struct
+                {
+                        int16_t centerX;
+                        int16_t centerY;
+                        int16_t radius;
+                } circle;
+                struct
+                {
+                        int32_t address;
+                        int16_t imageX;
+                        int16_t imageY;
+                        int16_t stride;
+                        bool isCompressed;
+                } image;
+                struct
+                {
+                        int16_t firstPoint;
+                        int16_t pointCount;
+                } polygon;
+                struct
+                {
+                        uint16_t codepoint;
+                } glyph;
+                struct
+                {
+                        int32_t address;
+                        int16_t centerX;
+                        int16_t centerY;
+                        uint16_t spanCount;
+                        uint16_t nextSpan;
+                } handSprite;
+        };
+} displayListItem_t;
+
+typedef struct
+{
+        uint32_t itemsRecorded;
+        uint32_t overflows;
+        uint32_t bandsRendered;
+        uint32_t bytesRendered;
+} displayListStats_t;
+
+//Receives each rendered band, PIXELS stays valid until the band after next
+typedef void (*displayListOutput_t)(const displayRect_t *BAND, const uint8_t *PIXELS, int SIZE, void *USER_DATA);
+
+void displayListBegin(int BACKGROUND_COLOR);
+void displayListBeginOverImage(uint32_t ASSET_ID);
+bool displayListIsRecording(void);
+void displayListSetRegion(const displayRect_t *REGION);
+void displayListEnd(void);
+void displayListRenderTo(displayListOutput_t OUTPUT, void *USER_DATA);
+bool displayListAddRect(int XSTART, int XEND, int YSTART, int YEND, int COLOR);
+bool displayListAddLine(int START_X, int END_X, int START_Y, int END_Y, int COLOR, int THICKNESS);
+bool displayListAddCircle(int CENTER_X, int CENTER_Y, int RADIUS, int COLOR);
+bool displayListAddPolygon(const displayPoint_t POINTS[], int POINT_COUNT, int COLOR);
+bool displayListAddGlyph(int XSTART, int YSTART, int WIDTH, int HEIGHT, int CODEPOINT, int COLOR);
+bool displayListAddHandSprite(int X_CENTER, int Y_CENTER, const displayHandSprite_t *SPRITE, int COLOR);
+bool displayListAddImage(int SCREEN_XSTART, int SCREEN_YSTART, int IMAGE_XSTART, int IMAGE_YSTART, int WIDTH, int HEIGHT, int STRIDE, int ADDRESS_IN_MEMORY);
+void displayListGetStats(displayListStats_t *STATS);
+void displayListResetStats(void);
+
+#endif /* DISPLAYLIST_H_ */
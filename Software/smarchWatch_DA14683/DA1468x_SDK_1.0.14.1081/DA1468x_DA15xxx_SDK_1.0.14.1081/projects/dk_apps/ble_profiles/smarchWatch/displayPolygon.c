@@ -0,0 +1,193 @@
+/*
+ * displayPolygon.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "displayPolygon.h"
+#include "displayDriver.h"
+#include "displaySpan.h"
+#include "displayList.h"
+#include "fixedMath.h"
+
+//Polygon edge, x is in Q16 pixels at the center of the current row
+typedef struct
+{
+        int16_t yFirst;
+        int16_t yLast;
+        int32_t x;
+        int32_t xStep;
+} displayEdge_t;
+
+//First pixel whose center is at or right of X (Q16 pixels)
+static int displayEdgeToPixel(int32_t X)
+{
+        return (X-0x8000+0xFFFF)>>16;
+}
+//Edge table and active edge list scan conversion. Rows are sampled at
+//pixel centers and filled even-odd, so concave and self-crossing
+//outlines work too. Only rows YSTART to YEND are produced
+void displayPolygonRasterize(const displayPoint_t POINTS[], int POINT_COUNT, int YSTART, int YEND, int COLOR, displaySpanOutput_t OUTPUT, void *USER_DATA)
+{
+        displayEdge_t edges[DISPLAY_POLYGON_MAX_POINTS];
+        displayEdge_t *active[DISPLAY_POLYGON_MAX_POINTS];
+        int edgeCount = 0;
+        int activeCount = 0;
+        int nextEdge = 0;
+        int lastRow = YSTART-1;
+
+        if(POINT_COUNT>DISPLAY_POLYGON_MAX_POINTS)
+        {
+                POINT_COUNT = DISPLAY_POLYGON_MAX_POINTS;
+        }
+        //Build the edge table, sorted by first row
+        for(int i=0;i<POINT_COUNT;i++)
+        {
+                displayPoint_t top = POINTS[i];
+                displayPoint_t bottom = POINTS[(i+1)%POINT_COUNT];
+                displayEdge_t edge;
+                int rowCenter = 0;
+                int j = 0;
+                if(top.y==bottom.y)
+                {
+                        continue;
+                }
+                if(top.y>bottom.y)
+                {
+                        displayPoint_t swap = top;
+                        top = bottom;
+                        bottom = swap;
+                }
+                edge.yFirst = (top.y-(DISPLAY_SUBPIXEL/2)+DISPLAY_SUBPIXEL-1)>>DISPLAY_SUBPIXEL_BITS;
+                edge.yLast = ((bottom.y-(DISPLAY_SUBPIXEL/2)+DISPLAY_SUBPIXEL-1)>>DISPLAY_SUBPIXEL_BITS)-1;
+                if(edge.yFirst>edge.yLast)
+                {
+                        continue;
+                }
+                rowCenter = DISPLAY_PIXEL_CENTER(edge.yFirst);
+                edge.xStep = ((int64_t)(bottom.x-top.x)<<16)/(bottom.y-top.y);
+                edge.x = ((int32_t)top.x<<(16-DISPLAY_SUBPIXEL_BITS))+
+                         (int32_t)((((int64_t)(rowCenter-top.y)*(bottom.x-top.x))<<(16-DISPLAY_SUBPIXEL_BITS))/(bottom.y-top.y));
+                if(edge.yLast>lastRow)
+                {
+                        lastRow = edge.yLast;
+                }
+                for(j=edgeCount;(j>0)&&(edges[j-1].yFirst>edge.yFirst);j--)
+                {
+                        edges[j] = edges[j-1];
+                }
+                edges[j] = edge;
+                edgeCount++;
+        }
+        if(edgeCount==0)
+        {
+                return;
+        }
+        if(YSTART<edges[0].yFirst)
+        {
+                YSTART = edges[0].yFirst;
+        }
+        if(YEND>lastRow)
+        {
+                YEND = lastRow;
+        }
+        for(int y=YSTART;y<=YEND;y++)
+        {
+                //Pick up edges that start on or above this row, skipping
+                //them forward if the rows above were clipped off
+                while((nextEdge<edgeCount)&&(edges[nextEdge].yFirst<=y))
+                {
+                        displayEdge_t *edge = &edges[nextEdge++];
+                        if(edge->yLast<y)
+                        {
+                                continue;
+                        }
+                        edge->x += edge->xStep*(y-edge->yFirst);
+                        active[activeCount++] = edge;
+                }
+                //Drop finished edges and keep the rest sorted by x
+                for(int i=0;i<activeCount;i++)
+                {
+                        if(active[i]->yLast<y)
+                        {
+                                active[i--] = active[--activeCount];
+                        }
+                }
+                for(int i=1;i<activeCount;i++)
+                {
+                        displayEdge_t *edge = active[i];
+                        int j = i;
+                        for(;(j>0)&&(active[j-1]->x>edge->x);j--)
+                        {
+                                active[j] = active[j-1];
+                        }
+                        active[j] = edge;
+                }
+                for(int i=0;i+1<activeCount;i+=2)
+                {
+                        int xStart = displayEdgeToPixel(active[i]->x);
+                        int xEnd = displayEdgeToPixel(active[i+1]->x)-1;
+                        if(xStart<=xEnd)
+                        {
+                                OUTPUT(y,xStart,xEnd,COLOR,USER_DATA);
+                        }
+                }
+                for(int i=0;i<activeCount;i++)
+                {
+                        active[i]->x += active[i]->xStep;
+                }
+        }
+}
+//Outline of a THICKNESS wide line with square ends reaching half a
+//width past each end point. Returns the number of points
+int displayThickLineQuad(int START_X, int END_X, int START_Y, int END_Y, int THICKNESS, displayPoint_t QUAD[4])
+{
+        int deltaX = (END_X-START_X)*DISPLAY_SUBPIXEL;
+        int deltaY = (END_Y-START_Y)*DISPLAY_SUBPIXEL;
+        int length = fixedSqrt((uint32_t)((deltaX*deltaX)+(deltaY*deltaY)));
+        int halfWidth = (THICKNESS*DISPLAY_SUBPIXEL)/2;
+        int alongX = halfWidth;
+        int alongY = 0;
+        int acrossX = 0;
+        int acrossY = halfWidth;
+
+        if(length>0)
+        {
+                alongX = (deltaX*halfWidth)/length;
+                alongY = (deltaY*halfWidth)/length;
+                acrossX = -alongY;
+                acrossY = alongX;
+        }
+        QUAD[0].x = DISPLAY_PIXEL_CENTER(START_X)-alongX+acrossX;
+        QUAD[0].y = DISPLAY_PIXEL_CENTER(START_Y)-alongY+acrossY;
+        QUAD[1].x = DISPLAY_PIXEL_CENTER(END_X)+alongX+acrossX;
+        QUAD[1].y = DISPLAY_PIXEL_CENTER(END_Y)+alongY+acrossY;
+        QUAD[2].x = DISPLAY_PIXEL_CENTER(END_X)+alongX-acrossX;
+        QUAD[2].y = DISPLAY_PIXEL_CENTER(END_Y)+alongY-acrossY;
+        QUAD[3].x = DISPLAY_PIXEL_CENTER(START_X)-alongX-acrossX;
+        QUAD[3].y = DISPLAY_PIXEL_CENTER(START_Y)-alongY-acrossY;
+        return 4;
+}
+static void displayPolygonSpan(int Y, int XSTART, int XEND, int COLOR, void *USER_DATA)
+{
+        displaySpanAdd(Y,XSTART,XEND,COLOR);
+}
+void displayFillPolygon(const displayPoint_t POINTS[], int POINT_COUNT, int COLOR)
+{
+        if(displayListAddPolygon(POINTS,POINT_COUNT,COLOR))
+        {
+                return;
+        }
+        displaySpanBegin();
+        displayPolygonRasterize(POINTS,POINT_COUNT,ST7789_YSTART,ST7789_HEIGHT-1,COLOR,displayPolygonSpan,NULL);
+        displaySpanEnd();
+}
+void displayFillThickLine(int START_X, int END_X, int START_Y, int END_Y, int COLOR, int THICKNESS)
+{
+        displayPoint_t quad[4];
+        int pointCount = displayThickLineQuad(START_X,END_X,START_Y,END_Y,THICKNESS,quad);
+        displayFillPolygon(quad,pointCount,COLOR);
+}
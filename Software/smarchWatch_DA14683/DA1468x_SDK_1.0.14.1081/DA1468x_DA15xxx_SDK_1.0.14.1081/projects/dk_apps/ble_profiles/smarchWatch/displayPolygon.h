@@ -0,0 +1,33 @@
+/*
+ * displayPolygon.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef DISPLAYPOLYGON_H_
+#define DISPLAYPOLYGON_H_
+
+#include <stdint.h>
+
+#define DISPLAY_POLYGON_MAX_POINTS 16
+//Polygon points are in 1/16 pixel units
+#define DISPLAY_SUBPIXEL_BITS 4
+#define DISPLAY_SUBPIXEL (1<<DISPLAY_SUBPIXEL_BITS)
+//Center of pixel N in polygon units
+#define DISPLAY_PIXEL_CENTER(N) (((N)<<DISPLAY_SUBPIXEL_BITS)+(DISPLAY_SUBPIXEL/2))
+
+typedef struct
+{
+        int16_t x;
+        int16_t y;
+} displayPoint_t;
+
+typedef void (*displaySpanOutput_t)(int Y, int XSTART, int XEND, int COLOR, void *USER_DATA);
+
+void displayPolygonRasterize(const displayPoint_t POINTS[], int POINT_COUNT, int YSTART, int YEND, int COLOR, displaySpanOutput_t OUTPUT, void *USER_DATA);
+int  displayThickLineQuad(int START_X, int END_X, int START_Y, int END_Y, int THICKNESS, displayPoint_t QUAD[4]);
+void displayFillPolygon(const displayPoint_t POINTS[], int POINT_COUNT, int COLOR);
+void displayFillThickLine(int START_X, int END_X, int START_Y, int END_Y, int COLOR, int THICKNESS);
+
+#endif /* DISPLAYPOLYGON_H_ */
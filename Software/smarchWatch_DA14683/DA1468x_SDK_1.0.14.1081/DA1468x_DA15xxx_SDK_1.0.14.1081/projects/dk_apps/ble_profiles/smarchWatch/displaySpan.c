@@ -0,0 +1,238 @@
+/*
+ * displaySpan.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "displaySpan.h"
+#include "displayDriver.h"
+#include "displayBezel.h"
+
+//Every shape is drawn as horizontal runs of one color. Runs on the
+//same row that touch are joined before they go out, and each run
+//costs one window and one burst instead of a window per pixel
+typedef struct
+{
+        int16_t y;
+        int16_t xStart;
+        int16_t xEnd;
+        uint16_t color;
+        uint32_t lastUsed;
+        bool isPending;
+} displaySpan_t;
+
+static displaySpan_t displaySpans[DISPLAY_SPAN_SLOTS];
+static int displaySpanDepth = 0;
+static uint32_t displaySpanClock = 0;
+static displaySpanStats_t displaySpanStats = {0};
+
+//Fills a rectangle that is already on screen with one window and as
+//few bursts as the blit buffer allows
+static void displayFillClippedWindow(int XSTART, int XEND, int YSTART, int YEND, int COLOR)
+{
+        uint8_t colorHigh = COLOR >> 8;
+        uint8_t colorLow = COLOR & 0xFF;
+        uint8_t *fillBuffer;
+        uint32_t bytesLeft = (XEND-XSTART+1)*(YEND-YSTART+1)*BYTES_PER_PIXEL;
+        uint32_t chunkSize = (bytesLeft>SPI_WRITE_BUFFER_SIZE)?SPI_WRITE_BUFFER_SIZE:bytesLeft;
+
+        displayBeginTransaction();
+        displaySetWindow(XSTART,XEND,YSTART,YEND);
+        //The pattern goes in a blit buffer that may still be going out
+        displayWaitDataBuf();
+        fillBuffer = displayGetBlitBuffer(0);
+        for(uint32_t i=0;i<chunkSize;i+=2)
+        {
+                fillBuffer[i] = colorHigh;
+                fillBuffer[i+1] = colorLow;
+        }
+        if(bytesLeft==chunkSize)
+        {
+                displayWriteDataBuf(fillBuffer,chunkSize);
+        }
+        else
+        {
+                //The pattern never changes so each burst can be queued
+                //as soon as the last one is done
+                while(bytesLeft>0)
+                {
+                        chunkSize = (bytesLeft>SPI_WRITE_BUFFER_SIZE)?SPI_WRITE_BUFFER_SIZE:bytesLeft;
+                        displayWriteDataBufAsync(fillBuffer,chunkSize);
+                        bytesLeft -= chunkSize;
+                }
+        }
+        displayEndTransaction();
+        displaySpanStats.rectsFilled++;
+}
+static void displayFillWindow(int XSTART, int XEND, int YSTART, int YEND, int COLOR)
+{
+        if(XSTART>XEND)
+        {
+                int swap = XSTART;
+                XSTART = XEND;
+                XEND = swap;
+        }
+        if(YSTART>YEND)
+        {
+                int swap = YSTART;
+                YSTART = YEND;
+                YEND = swap;
+        }
+        XSTART = (XSTART<ST7789_XSTART)?ST7789_XSTART:XSTART;
+        XEND = (XEND>ST7789_WIDTH-1)?ST7789_WIDTH-1:XEND;
+        YSTART = (YSTART<ST7789_YSTART)?ST7789_YSTART:YSTART;
+        YEND = (YEND>ST7789_HEIGHT-1)?ST7789_HEIGHT-1:YEND;
+        if((XSTART>XEND)||(YSTART>YEND))
+        {
+                return;
+        }
+        if(!displayIsRoundMask())
+        {
+                displayFillClippedWindow(XSTART,XEND,YSTART,YEND,COLOR);
+                return;
+        }
+        //Behind the bezel nothing needs filling, so the rectangle goes
+        //out as a window per run of rows that clip the same
+        displayBeginTransaction();
+        for(int y=YSTART;y<=YEND;y++)
+        {
+                int clippedStart = 0;
+                int clippedEnd = 0;
+                int lastRow = displayBezelClipRows(y,YEND,XSTART,XEND,&clippedStart,&clippedEnd);
+                if(clippedStart<=clippedEnd)
+                {
+                        displayFillClippedWindow(clippedStart,clippedEnd,y,lastRow,COLOR);
+                }
+                y = lastRow;
+        }
+        displayEndTransaction();
+}
+static void displaySpanFlushSlot(displaySpan_t *SPAN)
+{
+        displayFillWindow(SPAN->xStart,SPAN->xEnd,SPAN->y,SPAN->y,SPAN->color);
+        SPAN->isPending = false;
+        displaySpanStats.spansFlushed++;
+}
+void displayFillRect(int XSTART, int XEND, int YSTART, int YEND, int COLOR)
+{
+        //Pending spans were drawn earlier so they go out first
+        displaySpanFlush();
+        displayFillWindow(XSTART,XEND,YSTART,YEND,COLOR);
+}
+//Spans are held until the outermost batch ends so runs from several
+//calls, e.g. the three strokes of a watch hand, can be joined
+void displaySpanBegin(void)
+{
+        if(displaySpanDepth==0)
+        {
+                displayBeginTransaction();
+        }
+        displaySpanDepth++;
+}
+void displaySpanEnd(void)
+{
+        displaySpanDepth--;
+        if(displaySpanDepth==0)
+        {
+                displaySpanFlush();
+                displayEndTransaction();
+        }
+}
+void displaySpanFlush(void)
+{
+        for(int i=0;i<DISPLAY_SPAN_SLOTS;i++)
+        {
+                if(displaySpans[i].isPending)
+                {
+                        displaySpanFlushSlot(&displaySpans[i]);
+                }
+        }
+}
+void displaySpanAdd(int Y, int XSTART, int XEND, int COLOR)
+{
+        displaySpan_t *freeSlot = NULL;
+        displaySpan_t *oldestSlot = &displaySpans[0];
+
+        if(XSTART>XEND)
+        {
+                int swap = XSTART;
+                XSTART = XEND;
+                XEND = swap;
+        }
+        XSTART = (XSTART<ST7789_XSTART)?ST7789_XSTART:XSTART;
+        XEND = (XEND>ST7789_WIDTH-1)?ST7789_WIDTH-1:XEND;
+        if((Y<ST7789_YSTART)||(Y>ST7789_HEIGHT-1))
+        {
+                return;
+        }
+        if(displayIsRoundMask())
+        {
+                XSTART = (XSTART<DISPLAY_BEZEL_XSTART(Y))?DISPLAY_BEZEL_XSTART(Y):XSTART;
+                XEND = (XEND>DISPLAY_BEZEL_XEND(Y))?DISPLAY_BEZEL_XEND(Y):XEND;
+        }
+        if(XSTART>XEND)
+        {
+                return;
+        }
+        displaySpanStats.spansAdded++;
+        displaySpanBegin();
+        //Anything of another color under the new span was drawn first so
+        //it has to reach the panel first
+        for(int i=0;i<DISPLAY_SPAN_SLOTS;i++)
+        {
+                displaySpan_t *span = &displaySpans[i];
+                if(span->isPending&&(span->y==Y)&&(span->color!=COLOR)&&
+                   (XSTART<=span->xEnd)&&(XEND>=span->xStart))
+                {
+                        displaySpanFlushSlot(span);
+                }
+        }
+        for(int i=0;i<DISPLAY_SPAN_SLOTS;i++)
+        {
+                displaySpan_t *span = &displaySpans[i];
+                if(!span->isPending)
+                {
+                        freeSlot = span;
+                        continue;
+                }
+                if((span->y==Y)&&(span->color==COLOR)&&(XSTART<=span->xEnd+1)&&(XEND>=span->xStart-1))
+                {
+                        span->xStart = (XSTART<span->xStart)?XSTART:span->xStart;
+                        span->xEnd = (XEND>span->xEnd)?XEND:span->xEnd;
+                        span->lastUsed = displaySpanClock++;
+                        displaySpanStats.spansCoalesced++;
+                        displaySpanEnd();
+                        return;
+                }
+                if(span->lastUsed<oldestSlot->lastUsed)
+                {
+                        oldestSlot = span;
+                }
+        }
+        if(freeSlot==NULL)
+        {
+                //Out of slots, the span that hasn't grown for longest is
+                //probably finished
+                displaySpanFlushSlot(oldestSlot);
+                freeSlot = oldestSlot;
+        }
+        freeSlot->y = Y;
+        freeSlot->xStart = XSTART;
+        freeSlot->xEnd = XEND;
+        freeSlot->color = COLOR;
+        freeSlot->lastUsed = displaySpanClock++;
+        freeSlot->isPending = true;
+        displaySpanEnd();
+}
+void displayGetSpanStats(displaySpanStats_t *STATS)
+{
+        *STATS = displaySpanStats;
+}
+void displayResetSpanStats(void)
+{
+        memset(&displaySpanStats,0,sizeof(displaySpanStats));
+}
@@ -0,0 +1,33 @@
+/*
+ * displaySpan.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef DISPLAYSPAN_H_
+#define DISPLAYSPAN_H_
+
+#include <stdint.h>
+
+//Pending spans kept per batch, enough for the eight octants of a
+//circle with room to spare
+#define DISPLAY_SPAN_SLOTS 16
+
+typedef struct
+{
+        uint32_t spansAdded;
+        uint32_t spansCoalesced;
+        uint32_t spansFlushed;
+        uint32_t rectsFilled;
+} displaySpanStats_t;
+
+void displayFillRect(int XSTART, int XEND, int YSTART, int YEND, int COLOR);
+void displaySpanBegin(void);
+void displaySpanEnd(void);
+void displaySpanAdd(int Y, int XSTART, int XEND, int COLOR);
+void displaySpanFlush(void);
+void displayGetSpanStats(displaySpanStats_t *STATS);
+void displayResetSpanStats(void);
+
+#endif /* DISPLAYSPAN_H_ */
@@ -0,0 +1,224 @@
+/*
+ * displayText.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "displayText.h"
+#include "displayFonts.h"
+#include "displayGlyphs.h"
+#include "displayDriver.h"
+#include "displayBezel.h"
+
+//Text is laid out once into line records and drawn from those, so
+//drawing another page of the same message costs no measuring
+static displayTextLayout_t displayTextCache[DISPLAY_TEXT_CACHED_LAYOUTS];
+static uint32_t displayTextClock = 0;
+static displayTextStats_t displayTextStats = {0};
+
+static int displayTextAdvance(char CHARACTER, int KERNING_SIZE)
+{
+        return displayGlyphAdvance((uint8_t)CHARACTER)+KERNING_SIZE;
+}
+static int displayTextMeasure(const char TEXT[], int START, int END, int KERNING_SIZE)
+{
+        int width = 0;
+        for(int i=START;i<END;i++)
+        {
+                width += displayTextAdvance(TEXT[i],KERNING_SIZE);
+        }
+        return width;
+}
+//Hash of the part of TEXT a layout keeps
+static uint32_t displayTextHash(const char TEXT[])
+{
+        uint32_t hash = 2166136261u;
+        for(int i=0;(i<DISPLAY_TEXT_MAX_LENGTH)&&TEXT[i];i++)
+        {
+                hash = (hash^(uint8_t)TEXT[i])*16777619u;
+        }
+        return hash;
+}
+//Breaks TEXT into lines at spaces and newlines, using the real advance
+//of every character and the bezel inset of the rows each line lands on.
+//Lines are placed page by page from Y_START, so every page of a long
+//message fits the round screen the same way. Text that doesn't fit in
+//MAX_LINES ends in an ellipsis
+void displayTextLayout(displayTextLayout_t *LAYOUT, const char TEXT[], int X_START, int Y_START, int KERNING_SIZE, int MARGIN, int MAX_LINES)
+{
+        int minimumCircularMargin = 20;
+        int textLength = 0;
+        int position = 0;
+        const char *text = LAYOUT->text;
+        //Text past what a layout can keep is dropped like lines that don't fit
+        bool isCut = (strnlen(TEXT,DISPLAY_TEXT_MAX_LENGTH+1)>DISPLAY_TEXT_MAX_LENGTH);
+
+        strncpy(LAYOUT->text,TEXT,DISPLAY_TEXT_MAX_LENGTH);
+        LAYOUT->text[DISPLAY_TEXT_MAX_LENGTH] = 0;
+        textLength = strlen(LAYOUT->text);
+        LAYOUT->hash = displayTextHash(LAYOUT->text);
+        LAYOUT->xStart = X_START;
+        LAYOUT->yStart = Y_START;
+        LAYOUT->yTop = (Y_START<MARGIN+minimumCircularMargin)?MARGIN+minimumCircularMargin:Y_START;
+        LAYOUT->kerning = KERNING_SIZE;
+        LAYOUT->margin = MARGIN;
+        LAYOUT->maxLines = (MAX_LINES>DISPLAY_TEXT_MAX_LINES)?DISPLAY_TEXT_MAX_LINES:MAX_LINES;
+        LAYOUT->lineHeight = displayGlyphLineHeight();
+        LAYOUT->fontAddress = displayGlyphAtlasAddress();
+        LAYOUT->lineCount = 0;
+        LAYOUT->isTruncated = false;
+        LAYOUT->linesPerPage = 1;
+        while((LAYOUT->yTop+((LAYOUT->linesPerPage+1)*LAYOUT->lineHeight)+MARGIN+minimumCircularMargin)<=ST7789_HEIGHT)
+        {
+                LAYOUT->linesPerPage++;
+        }
+
+        while((position<textLength)&&(LAYOUT->lineCount<LAYOUT->maxLines))
+        {
+                displayTextLine_t *line = &LAYOUT->lines[LAYOUT->lineCount];
+                int y = LAYOUT->yTop+((LAYOUT->lineCount%LAYOUT->linesPerPage)*LAYOUT->lineHeight);
+                int xMargin = displayBezelInsetForRows(y,y+LAYOUT->lineHeight-1)+MARGIN;
+                int xStart = (X_START<xMargin)?xMargin:X_START;
+                int available = ST7789_WIDTH-xMargin-xStart;
+                int lineEnd = position;
+                int lineWidth = 0;
+                int scan = position;
+
+                //Take whole words while they fit
+                while((scan<textLength)&&(text[scan]!='\n'))
+                {
+                        int wordEnd = scan;
+                        int wordWidth = 0;
+                        while((wordEnd<textLength)&&(text[wordEnd]==' '))
+                        {
+                                wordEnd++;
+                        }
+                        while((wordEnd<textLength)&&(text[wordEnd]!=' ')&&(text[wordEnd]!='\n'))
+                        {
+                                wordEnd++;
+                        }
+                        wordWidth = displayTextMeasure(text,scan,wordEnd,KERNING_SIZE);
+                        if((lineWidth+wordWidth)>available)
+                        {
+                                if(lineEnd==position)
+                                {
+                                        //A word longer than the whole line is split,
+                                        //always taking at least one character
+                                        do
+                                        {
+                                                lineWidth += displayTextAdvance(text[lineEnd],KERNING_SIZE);
+                                                lineEnd++;
+                                        }
+                                        while((lineEnd<wordEnd)&&((lineWidth+displayTextAdvance(text[lineEnd],KERNING_SIZE))<=available));
+                                }
+                                break;
+                        }
+                        lineWidth += wordWidth;
+                        lineEnd = wordEnd;
+                        scan = wordEnd;
+                }
+                line->start = position;
+                line->length = lineEnd-position;
+                line->xStart = xStart;
+                line->width = lineWidth;
+                line->available = available;
+                line->hasEllipsis = false;
+                LAYOUT->lineCount++;
+                position = lineEnd;
+                if((position<textLength)&&(text[position]=='\n'))
+                {
+                        position++;
+                }
+                while((position<textLength)&&(text[position]==' '))
+                {
+                        position++;
+                }
+        }
+        if(((position<textLength)||isCut)&&(LAYOUT->lineCount>0))
+        {
+                //Make room for the ellipsis on the last line
+                displayTextLine_t *line = &LAYOUT->lines[LAYOUT->lineCount-1];
+                int ellipsisWidth = 3*displayTextAdvance('.',KERNING_SIZE);
+                while((line->length>0)&&
+                      (((line->width+ellipsisWidth)>line->available)||(text[line->start+line->length-1]==' ')))
+                {
+                        line->length--;
+                        line->width -= displayTextAdvance(text[line->start+line->length],KERNING_SIZE);
+                }
+                line->width += ellipsisWidth;
+                line->hasEllipsis = true;
+                LAYOUT->isTruncated = true;
+        }
+        displayTextStats.layoutsComputed++;
+}
+//Layout of TEXT from the cache, laid out again only if the text, its
+//placement or the font changed
+const displayTextLayout_t *displayTextGetLayout(const char TEXT[], int X_START, int Y_START, int KERNING_SIZE, int MARGIN, int MAX_LINES)
+{
+        displayTextLayout_t *oldestLayout = &displayTextCache[0];
+        uint32_t hash = displayTextHash(TEXT);
+        //Clamped the way displayTextLayout stores it, or an overlong
+        //MAX_LINES would never match its own cached layout
+        int maxLines = (MAX_LINES>DISPLAY_TEXT_MAX_LINES)?DISPLAY_TEXT_MAX_LINES:MAX_LINES;
+
+        for(int i=0;i<DISPLAY_TEXT_CACHED_LAYOUTS;i++)
+        {
+                displayTextLayout_t *layout = &displayTextCache[i];
+                if((layout->hash==hash)&&(layout->xStart==X_START)&&(layout->yStart==Y_START)&&(layout->kerning==KERNING_SIZE)&&
+                   (layout->margin==MARGIN)&&(layout->maxLines==maxLines)&&(layout->fontAddress==displayGlyphAtlasAddress())&&
+                   (layout->lineCount>0)&&(strncmp(layout->text,TEXT,DISPLAY_TEXT_MAX_LENGTH)==0))
+                {
+                        layout->lastUsed = displayTextClock++;
+                        displayTextStats.layoutCacheHits++;
+                        return layout;
+                }
+                if(layout->lastUsed<oldestLayout->lastUsed)
+                {
+                        oldestLayout = layout;
+                }
+        }
+        displayTextLayout(oldestLayout,TEXT,X_START,Y_START,KERNING_SIZE,MARGIN,maxLines);
+        oldestLayout->lastUsed = displayTextClock++;
+        return oldestLayout;
+}
+int displayTextPageCount(const displayTextLayout_t *LAYOUT)
+{
+        return (LAYOUT->lineCount+LAYOUT->linesPerPage-1)/LAYOUT->linesPerPage;
+}
+//Draws the lines of one page, each as a single text line burst
+void displayTextDrawPage(const displayTextLayout_t *LAYOUT, int PAGE)
+{
+        int firstLine = PAGE*LAYOUT->linesPerPage;
+
+        for(int i=firstLine;(i<firstLine+LAYOUT->linesPerPage)&&(i<LAYOUT->lineCount);i++)
+        {
+                const displayTextLine_t *line = &LAYOUT->lines[i];
+                int x = line->xStart;
+                int y = LAYOUT->yTop+((i-firstLine)*LAYOUT->lineHeight);
+
+                displayTextLineBegin();
+                for(int j=0;j<line->length;j++)
+                {
+                        x += displayDrawCharacter(x,y,LAYOUT->text[line->start+j])+LAYOUT->kerning;
+                }
+                for(int j=0;line->hasEllipsis&&(j<3);j++)
+                {
+                        x += displayDrawCharacter(x,y,'.')+LAYOUT->kerning;
+                }
+                displayTextLineEnd();
+                displayTextStats.linesDrawn++;
+        }
+}
+void displayGetTextStats(displayTextStats_t *STATS)
+{
+        *STATS = displayTextStats;
+}
+void displayResetTextStats(void)
+{
+        memset(&displayTextStats,0,sizeof(displayTextStats));
+}
@@ -0,0 +1,64 @@
+/*
+ * displayText.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef DISPLAYTEXT_H_
+#define DISPLAYTEXT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DISPLAY_TEXT_MAX_LENGTH 255
+#define DISPLAY_TEXT_MAX_LINES 32
+//Messages whose layout is kept, e.g. a notification title and body
+#define DISPLAY_TEXT_CACHED_LAYOUTS 2
+
+//One laid out line, LENGTH bytes of the text from START drawn from
+//XSTART. AVAILABLE is how wide the line was allowed to be
+typedef struct
+{
+        uint16_t start;
+        uint16_t length;
+        int16_t xStart;
+        int16_t width;
+        int16_t available;
+        bool hasEllipsis;
+} displayTextLine_t;
+
+typedef struct
+{
+        char text[DISPLAY_TEXT_MAX_LENGTH+1];
+        uint32_t hash;
+        int16_t xStart;
+        int16_t yStart;
+        int16_t yTop;
+        int16_t kerning;
+        int16_t margin;
+        int16_t maxLines;
+        int16_t lineHeight;
+        int16_t linesPerPage;
+        int16_t lineCount;
+        int32_t fontAddress;
+        uint32_t lastUsed;
+        bool isTruncated;
+        displayTextLine_t lines[DISPLAY_TEXT_MAX_LINES];
+} displayTextLayout_t;
+
+typedef struct
+{
+        uint32_t layoutsComputed;
+        uint32_t layoutCacheHits;
+        uint32_t linesDrawn;
+} displayTextStats_t;
+
+void displayTextLayout(displayTextLayout_t *LAYOUT, const char TEXT[], int X_START, int Y_START, int KERNING_SIZE, int MARGIN, int MAX_LINES);
+const displayTextLayout_t *displayTextGetLayout(const char TEXT[], int X_START, int Y_START, int KERNING_SIZE, int MARGIN, int MAX_LINES);
+int displayTextPageCount(const displayTextLayout_t *LAYOUT);
+void displayTextDrawPage(const displayTextLayout_t *LAYOUT, int PAGE);
+void displayGetTextStats(displayTextStats_t *STATS);
+void displayResetTextStats(void);
+
+#endif /* DISPLAYTEXT_H_ */
@@ -17,12 +17,74 @@
 #include "sys_watchdog.h"
 #include "displayDriver.h"
 #include "displayFonts.h"
+#include "displayGlyphs.h"
+#include "displayHandSprite.h"
+#include "displayImage.h"
+#include "displayAssets.h"
+#include "displayDamage.h"
+#include "displayList.h"
+#include "displayBezel.h"
 #include "watchAnimations.h"
 #include "ad_spi.h"
 #include "miniDB.h"
 #include "imageOffsets.h"
 
 #define UPDATE_DISPLAY_MASK (1<<0)
+#define WATCH_TICK_MS 1000
+
+static bool watchIsRunning = false;
+
+//Moves the hands, only what they swept since the last tick is sent
+static void updateWatch(void)
+{
+        uint32_t seconds = getWatchTime()/1000;
+        displayWatchUpdate((seconds/3600)%12,(seconds/60)%60,seconds%60);
+}
+//Puts the face up. The hands only go on once the time of day is known,
+//until then the face is shown as it is
+static void drawWatch(void)
+{
+        watchIsRunning = getWatchTimeValid();
+        if(watchIsRunning)
+        {
+                //The first update after this draws the whole face and the
+                //hands, every one after only redraws what the hands moved over
+                displayWatchBegin(WATCH_FACE_ASSET,DISPLAY_WHITE,DISPLAY_WHITE,display24to16Color(0xFF0000));
+                updateWatch();
+        }
+        else
+        {
+                displayImageFromAsset(0,0,WATCH_FACE_ASSET);
+        }
+}
+//Redraw callback for the face without the clock running
+static void redrawWatchFace(const displayRect_t *RECT, void *USER_DATA)
+{
+        displayPartialImageFromAsset(RECT->xStart,RECT->yStart,RECT->xStart,RECT->yStart,RECT->xEnd-RECT->xStart+1,RECT->yEnd-RECT->yStart+1,
+                                     WATCH_FACE_ASSET);
+}
+//Finds everything in the active bank and puts the face up. Run at start
+//and again when the loader switches banks, so whatever was decoded or
+//indexed from the old bank is dropped first
+static void loadWatchAssets(void)
+{
+        displayImageInvalidate();
+        displayAssetsLoad();
+        displayGlyphUseDefault();
+#ifdef FONT_GLYPHS_ASSET
+        //Fonts packed with their glyph table replace the built in one
+        if(displayAssetAddress(FONT_GLYPHS_ASSET)>=0)
+        {
+                displayGlyphLoad(displayAssetAddress(FONT_GLYPHS_ASSET));
+        }
+#endif
+#ifdef WATCH_HANDS_ASSET
+        //Hands rasterized by the packer, used by the clock when present.
+        //Without them any from the old bank are dropped too
+        displayHandSpritesLoad(displayAssetAddress(WATCH_HANDS_ASSET));
+#endif
+        drawWatch();
+}
 
 void display_task(void *params)
 {
@@ -34,7 +96,10 @@ void display_task(void *params)
         //In order to use the PLL as the source clock for the SPI bus
         ad_spi_init();
         displayInit();
-        displayFillScreenBuf(display24to16Color(0x000000));
+        //Nothing behind the bezel is ever seen, so it is never sent
+        displaySetRoundMask(true);
+        //Everything else in flash is found through the pack's directory
+        loadWatchAssets();
 //        bool firstRun = true;
 //        char messageFromTitle[]="FROM";
 //        char messageContentTitle[]="MESSAGE";
@@ -79,28 +144,61 @@ void display_task(void *params)
 //                }
 
                 OS_BASE_TYPE ret;
-                uint32_t notif;
+                uint32_t notif = 0;
 
                 /*
-                 * Wait on any of the notification bits, then clear them all
+                 * Wait on any of the notification bits, then clear them all.
+                 * Once the time is set, nothing by the next second is a clock tick
                  */
-                ret = OS_TASK_NOTIFY_WAIT(0, OS_TASK_NOTIFY_ALL_BITS, &notif, OS_TASK_NOTIFY_FOREVER);
-                OS_ASSERT(ret == OS_OK);
+                if (watchIsRunning)
+                {
+                        ret = OS_TASK_NOTIFY_WAIT(0, OS_TASK_NOTIFY_ALL_BITS, &notif,
+                                                  OS_MS_2_TICKS(WATCH_TICK_MS-(getWatchTime()%WATCH_TICK_MS)));
+                }
+                else
+                {
+                        ret = OS_TASK_NOTIFY_WAIT(0, OS_TASK_NOTIFY_ALL_BITS, &notif, OS_TASK_NOTIFY_FOREVER);
+                }
+                if (ret != OS_OK)
+                {
+                        updateWatch();
+                        continue;
+                }
 
+                /* Notified from the loader, a new pack is active */
+                if (notif & DISPLAY_ASSETS_CHANGED_MASK)
+                {
+                        loadWatchAssets();
+                        //The old bank is free for the next load
+                        setAssetsReloadPending(false);
+                }
+                /* Notified with a new time of day, the hands start from it */
+                else if (notif & WATCH_TIME_CHANGED_MASK)
+                {
+                        drawWatch();
+                }
                 /* Notified from BLE manager, can get event */
                 if (notif & UPDATE_DISPLAY_MASK)
                 {
 //                        displayImageFromMemory(0,0,MARISSA_OFFSET);
 //                        displayImageFromMemory(0,175,NEW_MESSAGE_OFFSET);
 //                        OS_DELAY_MS(2500);
-                        displayClearBuf();
+                        //Only the text is drawn over the clock, the damage
+                        //tracker remembers where so just that gets restored.
+                        //The glyphs are composited over the face in RAM and
+                        //go out as one window of full bands
+                        displayDamageReset();
+                        displayDamageTrack(true);
+                        displayListBeginOverImage(WATCH_FACE_ASSET);
 //                        displayDrawString(ST7789_XSTART, ST7789_YSTART, 10, 0, 0xC618, messageFromTitle);//Ends at 20+10+5 = 35
 //                        displayDrawString(ST7789_XSTART, 35, 10, 0, DISPLAY_WHITE, getANCSTitle());//Ends at 35+10+5+10+5 = 65
                         displayDrawString(0,0,2,0, getANCSTitle());//Ends at 35+10+5+10+5 = 65
 //                        displayDrawString(ST7789_XSTART, 65, 10, 0, messageContentTitle);//Ends at 65+10+5=80
                         displayDrawString(0,70,2,0, getANCSMessage());
+                        displayListEnd();
+                        displayDamageTrack(false);
                         OS_DELAY_MS(4500);
-                        displayImageFromMemory(0,0,WATCH_FACE_OFFSET);
+                        displayDamageFlush(watchIsRunning?displayWatchRedraw:redrawWatchFace,NULL);
                 }
         }
 }
@@ -0,0 +1,26 @@
+/*
+ * fixedMath.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef FIXEDMATH_H_
+#define FIXEDMATH_H_
+
+#include <stdint.h>
+
+//Angles are in tenths of a degree, sines and cosines are Q15
+#define FIXED_Q15_ONE 32768
+#define FIXED_DEGREES(DEGREES) ((DEGREES)*10)
+#define FIXED_FULL_TURN FIXED_DEGREES(360)
+#define FIXED_QUARTER_TURN FIXED_DEGREES(90)
+
+int32_t fixedSin(int ANGLE);
+int32_t fixedCos(int ANGLE);
+int32_t fixedMultiply(int32_t VALUE, int32_t Q15);
+void    fixedPolarToCartesian(int CENTER_X, int CENTER_Y, int RADIUS, int ANGLE, int *X, int *Y);
+int32_t fixedDdaStep(int DELTA, int STEPS);
+uint32_t fixedSqrt(uint32_t VALUE);
+
+#endif /* FIXEDMATH_H_ */
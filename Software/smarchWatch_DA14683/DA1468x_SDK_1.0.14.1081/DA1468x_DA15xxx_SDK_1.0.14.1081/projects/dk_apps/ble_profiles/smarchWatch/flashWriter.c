@@ -0,0 +1,162 @@
+/*
+ * flashWriter.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "ad_nvms.h"
+#include "flashWriter.h"
+#include "displayAssets.h"
+
+//Writing into erased flash lets NVMS program straight away instead of
+//reading, erasing and rewriting the sector around every write
+static flashWriterStats_t flashWriterStats = {0};
+
+//Reads back everything written since the last verified point. The page
+//buffer is empty by now so it holds the read back
+static bool flashWriterVerify(flashWriter_t *WRITER)
+{
+        uint32_t crc = 0;
+        for(uint32_t position=WRITER->verifiedEnd;position<WRITER->address;position+=FLASH_WRITER_PAGE_SIZE)
+        {
+                uint32_t chunkSize = ((WRITER->address-position)>FLASH_WRITER_PAGE_SIZE)?FLASH_WRITER_PAGE_SIZE:(WRITER->address-position);
+                ad_nvms_read(WRITER->flash, position, WRITER->page, chunkSize);
+                crc = displayAssetCrc32(crc,WRITER->page,chunkSize);
+        }
+        if(crc!=WRITER->sectorCrc)
+        {
+                flashWriterStats.verifyFailures++;
+                WRITER->failed = true;
+                return false;
+        }
+        flashWriterStats.sectorsVerified++;
+        WRITER->verifiedEnd = WRITER->address;
+        WRITER->sectorCrc = 0;
+        return true;
+}
+static bool flashWriterProgram(flashWriter_t *WRITER, const uint8_t DATA[], uint32_t SIZE)
+{
+        while((WRITER->address+SIZE)>WRITER->erasedEnd)
+        {
+                if(!ad_nvms_erase_region(WRITER->flash, WRITER->erasedEnd, FLASH_WRITER_SECTOR_SIZE))
+                {
+                        WRITER->failed = true;
+                        return false;
+                }
+                flashWriterStats.sectorsErased++;
+                WRITER->erasedEnd += FLASH_WRITER_SECTOR_SIZE;
+        }
+        if(ad_nvms_write(WRITER->flash, WRITER->address, DATA, SIZE)!=(int)SIZE)
+        {
+                WRITER->failed = true;
+                return false;
+        }
+        flashWriterStats.pagesWritten++;
+        WRITER->sectorCrc = displayAssetCrc32(WRITER->sectorCrc,DATA,SIZE);
+        WRITER->address += SIZE;
+        if((WRITER->address%FLASH_WRITER_SECTOR_SIZE)==0)
+        {
+                return flashWriterVerify(WRITER);
+        }
+        return true;
+}
+//ADDRESS has to start a sector, whatever was in the sectors written
+//from there on is lost
+bool flashWriterBegin(flashWriter_t *WRITER, nvms_t FLASH_MEMORY, uint32_t ADDRESS)
+{
+        memset(WRITER,0,sizeof(*WRITER));
+        WRITER->flash = FLASH_MEMORY;
+        WRITER->address = ADDRESS;
+        WRITER->erasedEnd = ADDRESS;
+        WRITER->verifiedEnd = ADDRESS;
+        WRITER->failed = (ADDRESS%FLASH_WRITER_SECTOR_SIZE)!=0;
+        return !WRITER->failed;
+}
+//Full pages of DATA go straight to flash, the rest is held until its
+//page fills up or the writer ends. Once a write fails the writer stays
+//failed until it is begun again
+bool flashWriterWrite(flashWriter_t *WRITER, const uint8_t DATA[], uint32_t SIZE)
+{
+        while(!WRITER->failed&&(SIZE>0))
+        {
+                uint32_t chunkSize = FLASH_WRITER_PAGE_SIZE-WRITER->pageFill;
+                if((WRITER->pageFill==0)&&(SIZE>=FLASH_WRITER_PAGE_SIZE))
+                {
+                        flashWriterProgram(WRITER,DATA,FLASH_WRITER_PAGE_SIZE);
+                        DATA += FLASH_WRITER_PAGE_SIZE;
+                        SIZE -= FLASH_WRITER_PAGE_SIZE;
+                        continue;
+                }
+                chunkSize = (SIZE<chunkSize)?SIZE:chunkSize;
+                memcpy(&WRITER->page[WRITER->pageFill],DATA,chunkSize);
+                WRITER->pageFill += chunkSize;
+                DATA += chunkSize;
+                SIZE -= chunkSize;
+                if(WRITER->pageFill==FLASH_WRITER_PAGE_SIZE)
+                {
+                        WRITER->pageFill = 0;
+                        flashWriterProgram(WRITER,WRITER->page,FLASH_WRITER_PAGE_SIZE);
+                }
+        }
+        return !WRITER->failed;
+}
+//Writes the part page that is left, just the bytes that were given,
+//and checks the last sector
+bool flashWriterEnd(flashWriter_t *WRITER)
+{
+        if(!WRITER->failed&&(WRITER->pageFill>0))
+        {
+                uint16_t pageFill = WRITER->pageFill;
+                WRITER->pageFill = 0;
+                flashWriterProgram(WRITER,WRITER->page,pageFill);
+        }
+        if(!WRITER->failed&&(WRITER->verifiedEnd!=WRITER->address))
+        {
+                flashWriterVerify(WRITER);
+        }
+        return !WRITER->failed;
+}
+//CRC32 of SIZE bytes of flash from ADDRESS, e.g. to compare sectors
+//with what a host has
+uint32_t flashWriterCrc(nvms_t FLASH_MEMORY, uint32_t ADDRESS, uint32_t SIZE)
+{
+        uint8_t chunk[FLASH_WRITER_PAGE_SIZE] __attribute__((aligned(4)));
+        uint32_t crc = 0;
+        while(SIZE>0)
+        {
+                uint32_t chunkSize = (SIZE>sizeof(chunk))?sizeof(chunk):SIZE;
+                ad_nvms_read(FLASH_MEMORY, ADDRESS, chunk, chunkSize);
+                crc = displayAssetCrc32(crc,chunk,chunkSize);
+                ADDRESS += chunkSize;
+                SIZE -= chunkSize;
+        }
+        return crc;
+}
+//Where the next byte given will go
+uint32_t flashWriterOffset(const flashWriter_t *WRITER)
+{
+        return WRITER->address+WRITER->pageFill;
+}
+//Everything before this has been programmed, the part page still in
+//RAM isn't
+uint32_t flashWriterProgrammed(const flashWriter_t *WRITER)
+{
+        return WRITER->address;
+}
+//Everything before this has been read back and found right
+uint32_t flashWriterVerified(const flashWriter_t *WRITER)
+{
+        return WRITER->verifiedEnd;
+}
+void flashWriterGetStats(flashWriterStats_t *STATS)
+{
+        *STATS = flashWriterStats;
+}
+void flashWriterResetStats(void)
+{
+        memset(&flashWriterStats,0,sizeof(flashWriterStats));
+}
@@ -0,0 +1,53 @@
+/*
+ * flashWriter.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef FLASHWRITER_H_
+#define FLASHWRITER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ad_nvms.h"
+
+//QSPI flash erases in sectors and programs in pages
+#define FLASH_WRITER_SECTOR_SIZE 4096
+#define FLASH_WRITER_PAGE_SIZE 256
+
+//Writes a stream into flash from a sector boundary on. Each sector is
+//erased once before its first page goes in, pages are only programmed
+//whole, apart from the last, and a finished sector is read back and
+//checked against the CRC32 of what was written to it
+typedef struct
+{
+        nvms_t flash;
+        uint32_t address;
+        uint32_t erasedEnd;
+        uint32_t verifiedEnd;
+        uint32_t sectorCrc;
+        uint16_t pageFill;
+        bool failed;
+        uint8_t page[FLASH_WRITER_PAGE_SIZE] __attribute__((aligned(4)));
+} flashWriter_t;
+
+typedef struct
+{
+        uint32_t sectorsErased;
+        uint32_t pagesWritten;
+        uint32_t sectorsVerified;
+        uint32_t verifyFailures;
+} flashWriterStats_t;
+
+bool flashWriterBegin(flashWriter_t *WRITER, nvms_t FLASH_MEMORY, uint32_t ADDRESS);
+bool flashWriterWrite(flashWriter_t *WRITER, const uint8_t DATA[], uint32_t SIZE);
+bool flashWriterEnd(flashWriter_t *WRITER);
+uint32_t flashWriterCrc(nvms_t FLASH_MEMORY, uint32_t ADDRESS, uint32_t SIZE);
+uint32_t flashWriterOffset(const flashWriter_t *WRITER);
+uint32_t flashWriterProgrammed(const flashWriter_t *WRITER);
+uint32_t flashWriterVerified(const flashWriter_t *WRITER);
+void flashWriterGetStats(flashWriterStats_t *STATS);
+void flashWriterResetStats(void);
+
+#endif /* FLASHWRITER_H_ */
@@ -8,17 +8,17 @@
 #ifndef IMAGEOFFSETS_H_
 #define IMAGEOFFSETS_H_
 
-#define WATCH_FACE_OFFSET 0
-#define TZIPI_OFFSET 115202
-#define NEW_MESSAGE_OFFSET 230404
-#define NEW_MAIL_OFFSET 261606
-#define MARISSA_OFFSET 292808
-#define HOME_OFFSET 408010
-#define FONT_OFFSET 523212
+#define WATCH_FACE_ASSET 0x52805E0C
+#define TZIPI_ASSET 0x89442BE1
+#define NEW_MESSAGE_ASSET 0x2A61E611
+#define NEW_MAIL_ASSET 0x38C4E509
+#define MARISSA_ASSET 0xCCCB8B4F
+#define HOME_ASSET 0x10B8C84E
+#define FONT_ASSET 0x64A04790
 
-#define TOTAL_MEMORY_USED 582014
-#define TOTAL_MEMORY_AVAILABLE 16195202
-#define TOTAL_MEMORY_PERCENT USED 3
-//Time to load all data at 115200 baud: 40 seconds
+#define TOTAL_MEMORY_USED 582198
+#define TOTAL_MEMORY_AVAILABLE 7740874
+#define TOTAL_MEMORY_PERCENT USED 6
+//Time to load all data with assetLoader at 921600 baud: 6 seconds
 
 #endif /* IMAGEOFFSETS_H_ */
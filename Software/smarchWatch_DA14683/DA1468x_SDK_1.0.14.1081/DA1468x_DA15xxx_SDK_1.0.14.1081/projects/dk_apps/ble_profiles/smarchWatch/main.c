@@ -50,8 +50,8 @@ static void prvSetupHardware( void );
         void storeInFlash_task(void *params);
 #else
         void ancs_task(void *params);
-        void display_task(void *params);
 #endif
+        void display_task(void *params);
 
 static OS_TASK handle;
 
@@ -147,6 +147,17 @@ static void system_init( void *pvParameters )
                                mainFLASH_TASK_PRIORITY,         /* The priority assigned to the task. */
                                handle);                            /* The task handle. */
                 OS_ASSERT(handle);
+
+                /* The face keeps running from the active bank while a new one loads */
+                OS_TASK_CREATE("Display Task",                     /* The text name assigned to the task, for
+                                                                      debug only; not used by the kernel. */
+                               display_task,                          /* The function that implements the task. */
+                               NULL,                               /* The parameter passed to the task. */
+                               4096,                               /* The number of bytes to allocate to the
+                                                                      stack of the task. */
+                               mainDISPLAY_TASK_PRIORITY,         /* The priority assigned to the task. */
+                               handle);                            /* The task handle. */
+                OS_ASSERT(handle);
         #else
                 pm_set_sleep_mode(pm_mode_extended_sleep);
                 /* Initialize BLE Manager */
@@ -7,11 +7,17 @@
 
 #include "miniDB.h"
 
+#define WATCH_DAY_MS (24*60*60*1000)
+
 TaskHandle_t DisplayTaskHandle;
 TaskHandle_t ANCSTaskHandle;
 char titleBuffer[50];
 char messageBuffer[250];
 bool imageLoaderIsDone;
+bool assetsReloadIsPending;
+uint32_t watchTimeAtSet;
+uint32_t watchTicksAtSet;
+bool watchTimeIsValid;
 
 void setDisplayTaskHandle(TaskHandle_t TASK_HANDLE)
 {
@@ -53,3 +59,31 @@ bool getImageLoaderComplete(void)
 {
         return imageLoaderIsDone;
 }
+//Set by the loader when it switches banks, cleared by the display task
+//once nothing it draws comes from the old bank any more
+void setAssetsReloadPending(bool IS_SET)
+{
+        assetsReloadIsPending = IS_SET;
+}
+bool getAssetsReloadPending(void)
+{
+        return assetsReloadIsPending;
+}
+//Time of day in milliseconds since midnight. It is kept against the tick
+//count, so getWatchTime carries on from whatever was last set
+void setWatchTime(uint32_t MILLISECONDS)
+{
+        watchTimeAtSet = MILLISECONDS%WATCH_DAY_MS;
+        watchTicksAtSet = OS_TICKS_2_MS(OS_GET_TICK_COUNT());
+        watchTimeIsValid = true;
+}
+uint32_t getWatchTime(void)
+{
+        uint32_t elapsed = OS_TICKS_2_MS(OS_GET_TICK_COUNT())-watchTicksAtSet;
+        return (watchTimeAtSet+(elapsed%WATCH_DAY_MS))%WATCH_DAY_MS;
+}
+//False until the time of day has been set once
+bool getWatchTimeValid(void)
+{
+        return watchTimeIsValid;
+}
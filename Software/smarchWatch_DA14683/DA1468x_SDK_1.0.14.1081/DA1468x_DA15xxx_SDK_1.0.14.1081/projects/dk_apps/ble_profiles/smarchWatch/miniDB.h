@@ -11,6 +11,11 @@
 #include "osal.h"
 #include "resmgmt.h"
 
+//Sent to the display task once the loader has switched asset banks
+#define DISPLAY_ASSETS_CHANGED_MASK (1<<1)
+//Sent to the display task by whatever sets the time of day
+#define WATCH_TIME_CHANGED_MASK (1<<2)
+
 void            setDisplayTaskHandle(TaskHandle_t TASK_HANDLE);
 TaskHandle_t    getDisplayTaskHandle();
 void            setANCSTaskHandle(TaskHandle_t TASK_HANDLE);
@@ -26,5 +31,12 @@ int             getANCSMessage(void);
 void            setImageLoaderComplete(bool IS_SET);
 bool            getImageLoaderComplete(void);
 
+void            setAssetsReloadPending(bool IS_SET);
+bool            getAssetsReloadPending(void);
+
+void            setWatchTime(uint32_t MILLISECONDS);
+uint32_t        getWatchTime(void);
+bool            getWatchTimeValid(void);
+
 
 #endif /* MINIDB_H_ */
@@ -21,60 +21,392 @@
 #include "sys_power_mgr.h"
 #include "ad_nvms.h"
 #include "miniDB.h"
+#include "displayImage.h"
+#include "displayAssets.h"
+#include "flashWriter.h"
 
-#define UART_RECEIVE_BUFFER_LENGTH 1
-#define MEMORY_BUFFER_SIZE 128
+#include "hw_uart.h"
+#include "ad_uart.h"
 
-char buf[UART_RECEIVE_BUFFER_LENGTH];
+//Assets come in as frames of {header, payload, CRC32 of both}. Every
+//frame from the host is answered with an ACK or a NAK whose offset is
+//how much of the pack is safely in flash, so a host that loses the
+//link or sees a NAK carries on from there.
+//A delta load instead asks for the CRC32 of each sector the pack
+//covers and only sends the sectors that differ, in any order.
+//Packs always go into the bank the display isn't reading, and only
+//become the active one once the whole pack checks out
+#define LOADER_SOF 0xA5
+#define LOADER_FRAME_HELLO 0x01 //{packSize, packCrc, baudRate, flags}
+#define LOADER_FRAME_DATA 0x02 //Pack bytes from offset
+#define LOADER_FRAME_END 0x03 //{packSize, packCrc}
+#define LOADER_FRAME_HASHES 0x04 //{end}, sector CRCs from offset up to end
+#define LOADER_FRAME_ACK 0x80
+#define LOADER_FRAME_NAK 0x81
+#define LOADER_HELLO_DELTA 0x01
+//Sector CRCs answered per HASHES frame
+#define LOADER_MAX_HASHES 256
+//One flash sector per frame
+#define LOADER_MAX_PAYLOAD FLASH_WRITER_SECTOR_SIZE
+#define LOADER_CRC_SIZE 4
+#define LOADER_FRAME_TIMEOUT_MS 2000
+//How long to wait for the host at a new baud rate before going back
+#define LOADER_BAUD_TIMEOUT_MS 3000
+#define LOADER_DEFAULT_BAUD 115200
+
+typedef struct
+{
+        uint8_t sof;
+        uint8_t type;
+        uint16_t length;
+        uint32_t offset;
+} loaderFrameHeader_t;
+
+typedef struct
+{
+        uint32_t packSize;
+        uint32_t packCrc;
+        uint32_t baudRate;
+        uint32_t flags;
+} loaderHello_t;
+
+typedef struct
+{
+        uint32_t baudRate;
+        uint16_t maxPayload;
+        uint16_t reserved;
+} loaderHelloReply_t;
+
+typedef enum
+{
+        LOADER_READ_TIMEOUT,
+        LOADER_READ_BAD,
+        LOADER_READ_OK
+} loaderReadResult_t;
+
+//Rates the host may ask for, fastest first
+static const struct
+{
+        uint32_t baudRate;
+        HW_UART_BAUDRATE setting;
+} loaderBaudRates[] =
+{
+        {1000000,HW_UART_BAUDRATE_1000000},
+        {921600,HW_UART_BAUDRATE_921600},
+        {500000,HW_UART_BAUDRATE_500000},
+        {230400,HW_UART_BAUDRATE_230400},
+        {115200,HW_UART_BAUDRATE_115200},
+};
+
+static uint8_t loaderFrame[sizeof(loaderFrameHeader_t)+LOADER_MAX_PAYLOAD+LOADER_CRC_SIZE] __attribute__((aligned(4)));
+static uart_device_config loaderUartConfig;
+//The pack being loaded and how much of it the writer has taken. Kept
+//while the task runs, so a host that starts the same pack again picks
+//it up here
+static uint32_t loaderPackSize = 0;
+static uint32_t loaderPackCrc = 0;
+static uint32_t loaderCommitted = 0;
+static bool loaderIsDelta = false;
+static flashWriter_t loaderWriter;
+//Bank being written, and the active bank a delta load is compared with
+static int loaderBank = 0;
+static int loaderSourceBank = 0;
+//Sectors a delta load has sent, one bit each
+static uint8_t loaderSectorSent[(DISPLAY_ASSET_BANK_SIZE/FLASH_WRITER_SECTOR_SIZE)/8];
+static uint8_t loaderReplyFrame[sizeof(loaderFrameHeader_t)+(LOADER_MAX_HASHES*sizeof(uint32_t))+LOADER_CRC_SIZE] __attribute__((aligned(4)));
+
+static uart_device loaderSetBaud(uart_device DEV, uint32_t BAUD_RATE)
+{
+        loaderUartConfig = *(const uart_device_config *)SERIAL2;
+        for(int i=0;i<(int)(sizeof(loaderBaudRates)/sizeof(loaderBaudRates[0]));i++)
+        {
+                if(loaderBaudRates[i].baudRate==BAUD_RATE)
+                {
+                        loaderUartConfig.hw_init.baud_rate = loaderBaudRates[i].setting;
+                }
+        }
+        ad_uart_close(DEV);
+        return ad_uart_open(&loaderUartConfig);
+}
+//Fastest rate both ends can do
+static uint32_t loaderNegotiateBaud(uint32_t REQUESTED)
+{
+        for(int i=0;i<(int)(sizeof(loaderBaudRates)/sizeof(loaderBaudRates[0]));i++)
+        {
+                if(loaderBaudRates[i].baudRate<=REQUESTED)
+                {
+                        return loaderBaudRates[i].baudRate;
+                }
+        }
+        return LOADER_DEFAULT_BAUD;
+}
+//Where OFFSET in the pack being loaded goes in flash
+static uint32_t loaderAddress(uint32_t OFFSET)
+{
+        return displayAssetBankAddress(loaderBank)+OFFSET;
+}
+//Starts a new pack in whichever bank isn't active, the first one ever
+//goes in bank 0 and has nothing to be compared with but itself
+static void loaderBeginPack(nvms_t FLASH_MEMORY)
+{
+        int activeBank = displayAssetActiveBank();
+
+        loaderBank = (activeBank==DISPLAY_ASSET_NO_BANK)?0:((activeBank+1)%DISPLAY_ASSET_BANKS);
+        loaderSourceBank = (activeBank==DISPLAY_ASSET_NO_BANK)?loaderBank:activeBank;
+        loaderCommitted = 0;
+        memset(loaderSectorSent,0,sizeof(loaderSectorSent));
+        flashWriterBegin(&loaderWriter,FLASH_MEMORY,loaderAddress(0));
+}
+//A delta load only sends what changed from the active bank, the rest of
+//the pack is copied across from there through BUFFER. Sectors that are
+//already the same in both banks aren't rewritten
+static bool loaderCopyUnsent(nvms_t FLASH_MEMORY, uint8_t BUFFER[])
+{
+        uint32_t source = displayAssetBankAddress(loaderSourceBank);
+
+        if(loaderSourceBank==loaderBank)
+        {
+                return true;
+        }
+        for(uint32_t offset=0;offset<loaderPackSize;offset+=FLASH_WRITER_SECTOR_SIZE)
+        {
+                uint32_t sector = offset/FLASH_WRITER_SECTOR_SIZE;
+                uint32_t sectorSize = ((loaderPackSize-offset)>FLASH_WRITER_SECTOR_SIZE)?FLASH_WRITER_SECTOR_SIZE:(loaderPackSize-offset);
+                if(((loaderSectorSent[sector/8]&(1<<(sector%8)))!=0)||
+                   (flashWriterCrc(FLASH_MEMORY,source+offset,sectorSize)==flashWriterCrc(FLASH_MEMORY,loaderAddress(offset),sectorSize)))
+                {
+                        continue;
+                }
+                ad_nvms_read(FLASH_MEMORY, source+offset, BUFFER, sectorSize);
+                if(!flashWriterBegin(&loaderWriter,FLASH_MEMORY,loaderAddress(offset))||
+                   !flashWriterWrite(&loaderWriter,BUFFER,sectorSize)||!flashWriterEnd(&loaderWriter))
+                {
+                        return false;
+                }
+        }
+        return true;
+}
+static loaderReadResult_t loaderReadFrame(uart_device DEV, int TIMEOUT_MS)
+{
+        loaderFrameHeader_t *header = (loaderFrameHeader_t *)loaderFrame;
+        uint32_t crc = 0;
+
+        //Anything before the start of a frame is line noise or the tail
+        //of a frame that was given up on
+        do
+        {
+                if(ad_uart_read(DEV,(char *)loaderFrame,1,OS_MS_2_TICKS(TIMEOUT_MS))!=1)
+                {
+                        return LOADER_READ_TIMEOUT;
+                }
+        } while(loaderFrame[0]!=LOADER_SOF);
+        if(ad_uart_read(DEV,(char *)&loaderFrame[1],sizeof(*header)-1,OS_MS_2_TICKS(LOADER_FRAME_TIMEOUT_MS))!=(int)(sizeof(*header)-1))
+        {
+                return LOADER_READ_BAD;
+        }
+        if(header->length>LOADER_MAX_PAYLOAD)
+        {
+                return LOADER_READ_BAD;
+        }
+        //Payload and CRC come in as one DMA transfer
+        if(ad_uart_read(DEV,(char *)&loaderFrame[sizeof(*header)],header->length+LOADER_CRC_SIZE,
+                        OS_MS_2_TICKS(LOADER_FRAME_TIMEOUT_MS))!=(header->length+LOADER_CRC_SIZE))
+        {
+                return LOADER_READ_BAD;
+        }
+        memcpy(&crc,&loaderFrame[sizeof(*header)+header->length],sizeof(crc));
+        if(displayAssetCrc32(0,loaderFrame,sizeof(*header)+header->length)!=crc)
+        {
+                return LOADER_READ_BAD;
+        }
+        return LOADER_READ_OK;
+}
+static void loaderReply(uart_device DEV, uint8_t TYPE, const void *PAYLOAD, int LENGTH)
+{
+        loaderFrameHeader_t header = {LOADER_SOF,TYPE,LENGTH,loaderCommitted};
+        uint32_t crc = 0;
+
+        memcpy(loaderReplyFrame,&header,sizeof(header));
+        memcpy(&loaderReplyFrame[sizeof(header)],PAYLOAD,LENGTH);
+        crc = displayAssetCrc32(0,loaderReplyFrame,sizeof(header)+LENGTH);
+        memcpy(&loaderReplyFrame[sizeof(header)+LENGTH],&crc,sizeof(crc));
+        ad_uart_write(DEV,(const char *)loaderReplyFrame,sizeof(header)+LENGTH+LOADER_CRC_SIZE);
+}
 
 void storeInFlash_task(void *params)
 {
         setImageLoaderComplete(false);
 
-        uint8_t memoryBuffer[MEMORY_BUFFER_SIZE]={0};
-
         uart_device uartDev;
         ad_uart_init();
         uartDev = ad_uart_open(SERIAL2);
 
-        OS_TICK_TIME xNextWakeTime;
-
-        xNextWakeTime = OS_GET_TICK_COUNT();
-
         OS_DELAY_MS(1000);
 
         /* Initialize NVMS */
         ad_nvms_init();
         nvms_t flashMemory = ad_nvms_open(NVMS_FLASH_STORAGE);
-        int characterCounter = 0;
-        int currentAddress = 0;
+        uint32_t baudRate = LOADER_DEFAULT_BAUD;
+        loaderFrameHeader_t *header = (loaderFrameHeader_t *)loaderFrame;
+        uint8_t *payload = &loaderFrame[sizeof(loaderFrameHeader_t)];
+
+        loaderBeginPack(flashMemory);
 
         ad_uart_write(uartDev,"\r\nReady for new data\r\n",22);
         for(;;)
         {
-                if(!getImageLoaderComplete())
+                loaderReadResult_t result = loaderReadFrame(uartDev,(baudRate==LOADER_DEFAULT_BAUD)?LOADER_FRAME_TIMEOUT_MS:LOADER_BAUD_TIMEOUT_MS);
+                if(result==LOADER_READ_TIMEOUT)
                 {
-                        if(ad_uart_read(uartDev,&buf,UART_RECEIVE_BUFFER_LENGTH,10000))
+                        //The host went quiet, so it may be gone or may not have
+                        //followed a baud change. Either way it starts again slowly
+                        if(baudRate!=LOADER_DEFAULT_BAUD)
                         {
-                                ad_uart_write(uartDev,buf,UART_RECEIVE_BUFFER_LENGTH);
-                                if(characterCounter>=MEMORY_BUFFER_SIZE)
-                                {
-                                        ad_nvms_write(flashMemory, currentAddress, (uint8_t *) memoryBuffer, MEMORY_BUFFER_SIZE);
-                                        characterCounter = 0;
-                                        currentAddress+=MEMORY_BUFFER_SIZE;
-                                }
-                                memoryBuffer[characterCounter] = buf[0];
-                                characterCounter++;
+                                baudRate = LOADER_DEFAULT_BAUD;
+                                uartDev = loaderSetBaud(uartDev,baudRate);
+                        }
+                        continue;
+                }
+                if(result==LOADER_READ_BAD)
+                {
+                        loaderReply(uartDev,LOADER_FRAME_NAK,NULL,0);
+                        continue;
+                }
+                if((header->type==LOADER_FRAME_HELLO)&&(header->length==sizeof(loaderHello_t)))
+                {
+                        loaderHello_t hello;
+                        loaderHelloReply_t reply = {0};
+                        memcpy(&hello,payload,sizeof(hello));
+                        //The bank a new pack would go into is the one the display is
+                        //still drawing from until it has moved to the new one
+                        if((hello.packSize>DISPLAY_ASSET_BANK_SIZE)||getAssetsReloadPending())
+                        {
+                                loaderReply(uartDev,LOADER_FRAME_NAK,NULL,0);
+                                continue;
+                        }
+                        //Only the same pack can carry on where it stopped
+                        if((hello.packSize!=loaderPackSize)||(hello.packCrc!=loaderPackCrc)||getImageLoaderComplete()||
+                           ((hello.flags&LOADER_HELLO_DELTA)!=0)||loaderIsDelta)
+                        {
+                                loaderPackSize = hello.packSize;
+                                loaderPackCrc = hello.packCrc;
+                                loaderBeginPack(flashMemory);
+                        }
+                        loaderIsDelta = (hello.flags&LOADER_HELLO_DELTA)!=0;
+                        setImageLoaderComplete(false);
+                        reply.baudRate = loaderNegotiateBaud(hello.baudRate);
+                        reply.maxPayload = LOADER_MAX_PAYLOAD;
+                        loaderReply(uartDev,LOADER_FRAME_ACK,&reply,sizeof(reply));
+                        if(reply.baudRate!=baudRate)
+                        {
+                                //Let the reply leave at the old rate before switching
+                                OS_DELAY_MS(10);
+                                baudRate = reply.baudRate;
+                                uartDev = loaderSetBaud(uartDev,baudRate);
+                        }
+                }
+                else if((header->type==LOADER_FRAME_HASHES)&&(header->length==sizeof(uint32_t))&&
+                        ((header->offset%FLASH_WRITER_SECTOR_SIZE)==0))
+                {
+                        //Worked out into the request's payload, which has been read.
+                        //They are of the active bank, what the new pack replaces
+                        uint32_t *hashes = (uint32_t *)payload;
+                        uint32_t source = displayAssetBankAddress(loaderSourceBank);
+                        uint32_t end = 0;
+                        int hashCount = 0;
+                        memcpy(&end,payload,sizeof(end));
+                        end = (end>DISPLAY_ASSET_BANK_SIZE)?DISPLAY_ASSET_BANK_SIZE:end;
+                        for(uint32_t address=header->offset;(address<end)&&(hashCount<LOADER_MAX_HASHES);address+=FLASH_WRITER_SECTOR_SIZE)
+                        {
+                                uint32_t sectorSize = ((end-address)>FLASH_WRITER_SECTOR_SIZE)?FLASH_WRITER_SECTOR_SIZE:(end-address);
+                                hashes[hashCount++] = flashWriterCrc(flashMemory,source+address,sectorSize);
+                        }
+                        loaderReply(uartDev,LOADER_FRAME_ACK,hashes,hashCount*sizeof(uint32_t));
+                }
+                else if(loaderIsDelta&&(header->type==LOADER_FRAME_DATA))
+                {
+                        //Each changed sector is rewritten on its own, whole or up to
+                        //the end of the pack
+                        if(((header->offset%FLASH_WRITER_SECTOR_SIZE)!=0)||((header->offset+header->length)>loaderPackSize)||
+                           ((header->length!=FLASH_WRITER_SECTOR_SIZE)&&((header->offset+header->length)!=loaderPackSize))||
+                           !flashWriterBegin(&loaderWriter,flashMemory,loaderAddress(header->offset))||
+                           !flashWriterWrite(&loaderWriter,payload,header->length)||!flashWriterEnd(&loaderWriter))
+                        {
+                                loaderReply(uartDev,LOADER_FRAME_NAK,NULL,0);
+                                continue;
+                        }
+                        loaderSectorSent[(header->offset/FLASH_WRITER_SECTOR_SIZE)/8] |= 1<<((header->offset/FLASH_WRITER_SECTOR_SIZE)%8);
+                        loaderCommitted = header->offset+header->length;
+                        loaderReply(uartDev,LOADER_FRAME_ACK,NULL,0);
+                }
+                else if(header->type==LOADER_FRAME_DATA)
+                {
+                        //The writer may hold a part page past what the host was told is
+                        //in flash, so a frame from there on only adds what is new to it.
+                        //A repeat of a frame whose ACK was lost is just acknowledged
+                        //again, anything past what the writer has is out of order
+                        uint32_t taken = flashWriterOffset(&loaderWriter)-loaderAddress(0);
+                        if((header->offset+header->length)<=taken)
+                        {
+                                loaderReply(uartDev,LOADER_FRAME_ACK,NULL,0);
+                        }
+                        else if((header->offset>taken)||((header->offset+header->length)>loaderPackSize))
+                        {
+                                loaderReply(uartDev,LOADER_FRAME_NAK,NULL,0);
+                        }
+                        else if(!flashWriterWrite(&loaderWriter,&payload[taken-header->offset],header->offset+header->length-taken)||
+                                //The last part page goes in as soon as the whole pack is here
+                                (((header->offset+header->length)==loaderPackSize)&&!flashWriterEnd(&loaderWriter)))
+                        {
+                                //A sector that didn't read back right is written again
+                                //from its start
+                                loaderCommitted = flashWriterVerified(&loaderWriter)-loaderAddress(0);
+                                flashWriterBegin(&loaderWriter,flashMemory,loaderAddress(loaderCommitted));
+                                loaderReply(uartDev,LOADER_FRAME_NAK,NULL,0);
+                        }
+                        else
+                        {
+                                //Only what is programmed is reported, a part page in RAM
+                                //would be lost with a reset
+                                loaderCommitted = flashWriterProgrammed(&loaderWriter)-loaderAddress(0);
+                                loaderReply(uartDev,LOADER_FRAME_ACK,NULL,0);
+                        }
+                }
+                else if((header->type==LOADER_FRAME_END)&&(header->length==(2*sizeof(uint32_t))))
+                {
+                        uint32_t packSize = 0;
+                        uint32_t packCrc = 0;
+                        memcpy(&packSize,payload,sizeof(packSize));
+                        memcpy(&packCrc,&payload[sizeof(packSize)],sizeof(packCrc));
+                        if((packSize!=loaderPackSize)||(!loaderIsDelta&&(loaderCommitted!=loaderPackSize))||!flashWriterEnd(&loaderWriter)||
+                           (loaderIsDelta&&!loaderCopyUnsent(flashMemory,payload))||
+                           (flashWriterCrc(flashMemory,loaderAddress(0),packSize)!=packCrc)||
+                           !displayAssetsCommit(loaderBank,packSize,packCrc))
+                        {
+                                //Whatever is in the bank can't be trusted, so the next HELLO
+                                //starts over. The active bank was never touched
+                                loaderBeginPack(flashMemory);
+                                loaderReply(uartDev,LOADER_FRAME_NAK,NULL,0);
+                                continue;
+                        }
+                        //The display carries on from the old bank until it picks up
+                        //the new one between frames
+                        if(getDisplayTaskHandle()!=NULL)
+                        {
+                                setAssetsReloadPending(true);
+                                OS_TASK_NOTIFY(getDisplayTaskHandle(),DISPLAY_ASSETS_CHANGED_MASK,OS_NOTIFY_SET_BITS);
                         }
                         else
                         {
-                                if(characterCounter>0)
-                                {
-                                        ad_nvms_write(flashMemory, currentAddress, (uint8_t *) memoryBuffer, MEMORY_BUFFER_SIZE);
-                                }
-                                ad_uart_write(uartDev,"\r\nTransmission Finished\r\n",25);
-                                setImageLoaderComplete(true);
+                                displayImageInvalidate();
+                                displayAssetsLoad();
                         }
+                        setImageLoaderComplete(true);
+                        loaderReply(uartDev,LOADER_FRAME_ACK,NULL,0);
+                }
+                else
+                {
+                        loaderReply(uartDev,LOADER_FRAME_NAK,NULL,0);
                 }
         }
 }
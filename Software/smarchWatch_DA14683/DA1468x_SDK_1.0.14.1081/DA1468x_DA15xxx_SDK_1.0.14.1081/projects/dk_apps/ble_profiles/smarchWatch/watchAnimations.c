@@ -5,51 +5,212 @@
  *      Author: samsonm
  */
 
+#include <stdint.h>
+#include <stdbool.h>
 #include "watchAnimations.h"
 #include "displayDriver.h"
-#include "math.h"
+#include "displaySpan.h"
+#include "displayPolygon.h"
+#include "fixedMath.h"
+#include "displayDamage.h"
+#include "displayList.h"
+#include "displayHandSprite.h"
 
-void displayDrawWatchHand(int RADIUS, int ANGLE, int HAND_COLOR)
+//The hand is one tapered quad, as wide at the hub as the two side
+//strokes used to be and as wide at the tip as the center stroke
+static void displayWatchHandShape(int X_CENTER, int Y_CENTER, int RADIUS, int ANGLE, displayPoint_t HAND[4])
 {
-    int baseAngleLeft = ANGLE-90;
-    int baseAngleRight = ANGLE+90;
-    int baseLength = RADIUS/25;
+    int32_t handCos = fixedCos(FIXED_DEGREES(ANGLE));
+    int32_t handSin = fixedSin(FIXED_DEGREES(ANGLE));
+    int baseHalfWidth = (RADIUS*DISPLAY_SUBPIXEL)/25;
+    int tipHalfWidth = (RADIUS*DISPLAY_SUBPIXEL)/40;
+    int centerX = DISPLAY_PIXEL_CENTER(X_CENTER);
+    int centerY = DISPLAY_PIXEL_CENTER(Y_CENTER);
+    int tipX = centerX+fixedMultiply(RADIUS*DISPLAY_SUBPIXEL,handCos);
+    int tipY = centerY+fixedMultiply(RADIUS*DISPLAY_SUBPIXEL,handSin);
 
-    displayDrawLinePolarThickness(WATCH_CENTER,WATCH_CENTER,RADIUS,ANGLE,HAND_COLOR,RADIUS/20);
+    if(tipHalfWidth<DISPLAY_SUBPIXEL/2)
+    {
+        tipHalfWidth = DISPLAY_SUBPIXEL/2;
+    }
+    HAND[0].x = centerX-fixedMultiply(baseHalfWidth,handSin);
+    HAND[0].y = centerY+fixedMultiply(baseHalfWidth,handCos);
+    HAND[1].x = tipX-fixedMultiply(tipHalfWidth,handSin);
+    HAND[1].y = tipY+fixedMultiply(tipHalfWidth,handCos);
+    HAND[2].x = tipX+fixedMultiply(tipHalfWidth,handSin);
+    HAND[2].y = tipY-fixedMultiply(tipHalfWidth,handCos);
+    HAND[3].x = centerX+fixedMultiply(baseHalfWidth,handSin);
+    HAND[3].y = centerY-fixedMultiply(baseHalfWidth,handCos);
+}
+static void displayFillWatchHand(int X_CENTER, int Y_CENTER, int RADIUS, int ANGLE, int HAND_COLOR)
+{
+    displayPoint_t hand[4];
 
+    displayWatchHandShape(X_CENTER,Y_CENTER,RADIUS,ANGLE,hand);
+    displayFillPolygon(hand,4,HAND_COLOR);
+}
+void displayDrawWatchHand(int RADIUS, int ANGLE, int HAND_COLOR)
+{
+    displayFillWatchHand(WATCH_CENTER,WATCH_CENTER,RADIUS,ANGLE,HAND_COLOR);
+}
 
-    float newAngleLeft = 3.1416*baseAngleLeft/180;
-    float newAngleRight = 3.1416*baseAngleRight/180;
-    float pointAngle = 2;
 
-    int baseAngleLeftX = WATCH_CENTER+baseLength*cos(newAngleLeft);
-    int baseAngleLeftY = WATCH_CENTER+baseLength*sin(newAngleLeft);
-    displayDrawLinePolarThickness(baseAngleLeftX,baseAngleLeftY,RADIUS,ANGLE+pointAngle,HAND_COLOR,RADIUS/60);
-    int baseAngleRightX = WATCH_CENTER+baseLength*cos(newAngleRight);
-    int baseAngleRightY = WATCH_CENTER+baseLength*sin(newAngleRight);
-    displayDrawLinePolarThickness(baseAngleRightX,baseAngleRightY,RADIUS,ANGLE-pointAngle,HAND_COLOR,RADIUS/60);
+void displayDrawSecondWatchHand(int RADIUS, int ANGLE, int HAND_COLOR, int X_CENTER, int Y_CENTER)
+{
+    displayFillWatchHand(X_CENTER,Y_CENTER,RADIUS,ANGLE,HAND_COLOR);
 }
+//Clock hands kept between updates so only what moved is redrawn. A
+//hand that moves damages the rows its old and new shapes cover, cut
+//into slabs so a diagonal hand doesn't damage its whole bounding box
+typedef struct
+{
+    int radius;
+    int color;
+    int angle;
+} watchHand_t;
 
+typedef struct
+{
+    int16_t xStart[WATCH_DAMAGE_SLABS];
+    int16_t xEnd[WATCH_DAMAGE_SLABS];
+} watchHandDamage_t;
 
-void displayDrawSecondWatchHand(int RADIUS, int ANGLE, int HAND_COLOR, int X_CENTER, int Y_CENTER)
+static watchHand_t watchHands[WATCH_HAND_COUNT];
+//The face is looked up on every redraw, the loader may have moved it to
+//the other bank since the last one
+static uint32_t watchFaceAsset = 0;
+static bool watchIsDrawn = false;
+
+//A loaded sprite set with a sprite for every hand replaces the drawn
+//hands, in the same order
+static bool watchUsesSprites(void)
+{
+    return displayHandSpriteCount()>=WATCH_HAND_COUNT;
+}
+static void watchHandDamageSpan(int Y, int XSTART, int XEND, int COLOR, void *USER_DATA)
 {
-    int baseAngleLeft = ANGLE-90;
-    int baseAngleRight = ANGLE+90;
-    int baseLength = RADIUS/25;
+    watchHandDamage_t *damage = (watchHandDamage_t *)USER_DATA;
+    int slab = Y/WATCH_DAMAGE_SLAB_ROWS;
 
-    displayDrawLinePolarThickness(X_CENTER,Y_CENTER,RADIUS,ANGLE,HAND_COLOR,RADIUS/20);
+    if((Y<ST7789_YSTART)||(Y>ST7789_HEIGHT-1))
+    {
+        return;
+    }
+    if(XSTART<damage->xStart[slab])
+    {
+        damage->xStart[slab] = XSTART;
+    }
+    if(XEND>damage->xEnd[slab])
+    {
+        damage->xEnd[slab] = XEND;
+    }
+}
+static void watchHandAddShape(watchHandDamage_t *DAMAGE, int HAND, int ANGLE)
+{
+    displayPoint_t hand[4];
 
-    float newAngleLeft = 3.1416*baseAngleLeft/180;
-    float newAngleRight = 3.1416*baseAngleRight/180;
+    if(watchUsesSprites())
+    {
+        displayHandSpriteSpans(HAND,ANGLE,WATCH_CENTER,WATCH_CENTER,watchHandDamageSpan,DAMAGE);
+        return;
+    }
+    displayWatchHandShape(WATCH_CENTER,WATCH_CENTER,watchHands[HAND].radius,ANGLE,hand);
+    displayPolygonRasterize(hand,4,ST7789_YSTART,ST7789_HEIGHT-1,0,watchHandDamageSpan,DAMAGE);
+}
+static void watchHandDamage(int HAND, int OLD_ANGLE, int NEW_ANGLE)
+{
+    watchHandDamage_t damage;
 
-    float pointAngle = 2;
+    for(int i=0;i<WATCH_DAMAGE_SLABS;i++)
+    {
+        damage.xStart[i] = ST7789_WIDTH;
+        damage.xEnd[i] = -1;
+    }
+    watchHandAddShape(&damage,HAND,OLD_ANGLE);
+    watchHandAddShape(&damage,HAND,NEW_ANGLE);
+    for(int i=0;i<WATCH_DAMAGE_SLABS;i++)
+    {
+        if(damage.xStart[i]<=damage.xEnd[i])
+        {
+            displayDamageAdd(damage.xStart[i],damage.xEnd[i],i*WATCH_DAMAGE_SLAB_ROWS,(i+1)*WATCH_DAMAGE_SLAB_ROWS-1);
+        }
+    }
+}
+//Redraw callback for the clock, the face under RECT with every hand that
+//crosses it on top, sent as one window. Also usable to put the clock
+//back after something else was drawn over it
+void displayWatchRedraw(const displayRect_t *RECT, void *USER_DATA)
+{
+    displayListBeginOverImage(watchFaceAsset);
+    displayListSetRegion(RECT);
+    for(int i=0;i<WATCH_HAND_COUNT;i++)
+    {
+        if(watchUsesSprites())
+        {
+            displayDrawHandSprite(i,watchHands[i].angle,WATCH_CENTER,WATCH_CENTER);
+        }
+        else
+        {
+            displayFillWatchHand(WATCH_CENTER,WATCH_CENTER,watchHands[i].radius,watchHands[i].angle,watchHands[i].color);
+        }
+    }
+    displayListEnd();
+}
+//The colors are for drawn hands, sprites keep the colors they were
+//packed with
+void displayWatchBegin(uint32_t FACE_ASSET, int HOUR_COLOR, int MINUTE_COLOR, int SECOND_COLOR)
+{
+    watchFaceAsset = FACE_ASSET;
+    watchHands[WATCH_HAND_HOUR].radius = WATCH_HOUR_RADIUS;
+    watchHands[WATCH_HAND_HOUR].color = HOUR_COLOR;
+    watchHands[WATCH_HAND_MINUTE].radius = WATCH_MINUTE_RADIUS;
+    watchHands[WATCH_HAND_MINUTE].color = MINUTE_COLOR;
+    watchHands[WATCH_HAND_SECOND].radius = WATCH_SECOND_RADIUS;
+    watchHands[WATCH_HAND_SECOND].color = SECOND_COLOR;
+    watchIsDrawn = false;
+}
+//Moves the hands to the given time. The first update after
+//displayWatchBegin draws the whole face, after that only the rows the
+//moving hands swept are read back from flash and sent. Anything else
+//waiting in the damage list is flushed with the clock. Returns the
+//pixel bytes sent
+int displayWatchUpdate(int HOURS, int MINUTES, int SECONDS)
+{
+    int newAngles[WATCH_HAND_COUNT];
 
-    int baseAngleLeftX = X_CENTER+baseLength*cos(newAngleLeft);
-    int baseAngleLeftY = Y_CENTER+baseLength*sin(newAngleLeft);
-    displayDrawLinePolarThickness(baseAngleLeftX,baseAngleLeftY,RADIUS,ANGLE+pointAngle,HAND_COLOR,RADIUS/60);
-    int baseAngleRightX = X_CENTER+baseLength*cos(newAngleRight);
-    int baseAngleRightY = Y_CENTER+baseLength*sin(newAngleRight);
-    displayDrawLinePolarThickness(baseAngleRightX,baseAngleRightY,RADIUS,ANGLE-pointAngle,HAND_COLOR,RADIUS/60);
+    //Angle 0 is three o'clock so twelve is at 270
+    newAngles[WATCH_HAND_HOUR] = (((HOURS%12)*30)+((MINUTES%60)/2)+270)%360;
+    newAngles[WATCH_HAND_MINUTE] = (((MINUTES%60)*6)+270)%360;
+    newAngles[WATCH_HAND_SECOND] = (((SECONDS%60)*6)+270)%360;
+    if(watchUsesSprites())
+    {
+        //Snap to the sprites so a hand only counts as moved when its
+        //sprite changes
+        for(int i=0;i<WATCH_HAND_COUNT;i++)
+        {
+            newAngles[i] = (displayHandSpriteIndex(newAngles[i])*360)/displayHandSpriteAngles();
+        }
+    }
+    if(!watchIsDrawn)
+    {
+        displayDamageAdd(ST7789_XSTART,ST7789_WIDTH-1,ST7789_YSTART,ST7789_HEIGHT-1);
+        watchIsDrawn = true;
+    }
+    else
+    {
+        for(int i=0;i<WATCH_HAND_COUNT;i++)
+        {
+            if(newAngles[i]!=watchHands[i].angle)
+            {
+                watchHandDamage(i,watchHands[i].angle,newAngles[i]);
+            }
+        }
+    }
+    for(int i=0;i<WATCH_HAND_COUNT;i++)
+    {
+        watchHands[i].angle = newAngles[i];
+    }
+    return displayDamageFlush(displayWatchRedraw,NULL);
 }
 //void displayClearWatchHandBMP(int RADIUS, int ANGLE, char *FILENAME, int NAME_SIZE)
 //{
@@ -96,19 +257,21 @@ void displayDrawSecondWatchHand(int RADIUS, int ANGLE, int HAND_COLOR, int X_CEN
 
 void displayDrawWatchFace(int BACKGROUND_COLOR, int TICK_COLOR)
 {
+    displaySpanBegin();
     displayFillScreen(BACKGROUND_COLOR);
     for(int tickAngle=0;tickAngle<360;tickAngle+=30)
     {
         displayDrawLinePolarThickness(WATCH_CENTER,WATCH_CENTER,WATCH_CENTER,tickAngle,TICK_COLOR,WATCH_CENTER/30);
         displayDrawLinePolarThickness(WATCH_CENTER,WATCH_CENTER,WATCH_CENTER-TICK_LENGTH,tickAngle,BACKGROUND_COLOR,WATCH_CENTER/20);
     }
+    displaySpanEnd();
 }
 void displayDrawWatchNumbers(int BACKGROUND_COLOR, int NUMBER_COLOR)
 {
+    displaySpanBegin();
     int offsetFromEdge = 25;
     int polarX = 0;
     int polarY = 0;
-    float polarAngle = 0;
     displayFillScreen(BACKGROUND_COLOR);
 //    displayDrawCircle(WATCH_CENTER,WATCH_CENTER,WATCH_CENTER-offsetFromEdge-24,NUMBER_COLOR);
 //    displayDrawCircle(WATCH_CENTER,WATCH_CENTER,WATCH_CENTER-offsetFromEdge-25,NUMBER_COLOR);
@@ -120,14 +283,10 @@ void displayDrawWatchNumbers(int BACKGROUND_COLOR, int NUMBER_COLOR)
     displayDrawLineThickness(125, 125, offsetFromEdge, offsetFromEdge+10, NUMBER_COLOR, 3);
     displayDrawLineThickness(130, 130, offsetFromEdge, offsetFromEdge+10, NUMBER_COLOR, 3);
     //I
-    polarAngle = 3.1416*300/180;
-    polarX = WATCH_CENTER+(120-offsetFromEdge)*cos(polarAngle);
-    polarY = WATCH_CENTER+(120-offsetFromEdge)*sin(polarAngle);
+    fixedPolarToCartesian(WATCH_CENTER,WATCH_CENTER,120-offsetFromEdge,FIXED_DEGREES(300),&polarX,&polarY);
     displayDrawLineThickness(polarX, polarX, polarY-5, polarY+5, NUMBER_COLOR, 3);
     //II
-    polarAngle = 3.1416*330/180;
-    polarX = WATCH_CENTER+(120-offsetFromEdge)*cos(polarAngle);
-    polarY = WATCH_CENTER+(120-offsetFromEdge)*sin(polarAngle);
+    fixedPolarToCartesian(WATCH_CENTER,WATCH_CENTER,120-offsetFromEdge,FIXED_DEGREES(330),&polarX,&polarY);
     displayDrawLineThickness(polarX-5, polarX-5, polarY-5, polarY+5, NUMBER_COLOR, 3);
     displayDrawLineThickness(polarX, polarX, polarY-5, polarY+5, NUMBER_COLOR, 3);
     //III
@@ -135,16 +294,12 @@ void displayDrawWatchNumbers(int BACKGROUND_COLOR, int NUMBER_COLOR)
     displayDrawLineThickness(235-offsetFromEdge, 235-offsetFromEdge, 115, 125, NUMBER_COLOR, 3);
     displayDrawLineThickness(240-offsetFromEdge, 240-offsetFromEdge, 115, 125, NUMBER_COLOR, 3);
     //IV
-    polarAngle = 3.1416*30/180;
-    polarX = WATCH_CENTER+(120-offsetFromEdge)*cos(polarAngle);
-    polarY = WATCH_CENTER+(120-offsetFromEdge)*sin(polarAngle);
+    fixedPolarToCartesian(WATCH_CENTER,WATCH_CENTER,120-offsetFromEdge,FIXED_DEGREES(30),&polarX,&polarY);
     displayDrawLineThickness(polarX-10, polarX-10, polarY+5, polarY-5, NUMBER_COLOR, 3);
     displayDrawLineThickness(polarX-5, polarX, polarY-5, polarY+5, NUMBER_COLOR, 3);
     displayDrawLineThickness(polarX, polarX+5, polarY+5, polarY-5, NUMBER_COLOR, 3);
     //V
-    polarAngle = 3.1416*60/180;
-    polarX = WATCH_CENTER+(120-offsetFromEdge)*cos(polarAngle);
-    polarY = WATCH_CENTER+(120-offsetFromEdge)*sin(polarAngle);
+    fixedPolarToCartesian(WATCH_CENTER,WATCH_CENTER,120-offsetFromEdge,FIXED_DEGREES(60),&polarX,&polarY);
     displayDrawLineThickness(polarX-5, polarX, polarY-5, polarY+5, NUMBER_COLOR, 3);
     displayDrawLineThickness(polarX, polarX+5, polarY+5, polarY-5, NUMBER_COLOR, 3);
     //VI
@@ -152,17 +307,13 @@ void displayDrawWatchNumbers(int BACKGROUND_COLOR, int NUMBER_COLOR)
     displayDrawLineThickness(115, WATCH_CENTER, 240-offsetFromEdge, 230-offsetFromEdge, NUMBER_COLOR, 3);
     displayDrawLineThickness(130, 130, 230-offsetFromEdge, 240-offsetFromEdge, NUMBER_COLOR, 3);
     //VII
-    polarAngle = 3.1416*120/180;
-    polarX = WATCH_CENTER+(120-offsetFromEdge)*cos(polarAngle);
-    polarY = WATCH_CENTER+(120-offsetFromEdge)*sin(polarAngle);
+    fixedPolarToCartesian(WATCH_CENTER,WATCH_CENTER,120-offsetFromEdge,FIXED_DEGREES(120),&polarX,&polarY);
     displayDrawLineThickness(polarX+5, polarX, polarY-5, polarY+5, NUMBER_COLOR, 3);
     displayDrawLineThickness(polarX, polarX-5, polarY+5, polarY-5, NUMBER_COLOR, 3);
     displayDrawLineThickness(polarX+10, polarX+10, polarY+5, polarY-5, NUMBER_COLOR, 3);
     displayDrawLineThickness(polarX+15, polarX+15, polarY+5, polarY-5, NUMBER_COLOR, 3);
     //VIII
-    polarAngle = 3.1416*150/180;
-    polarX = WATCH_CENTER+(120-offsetFromEdge)*cos(polarAngle);
-    polarY = WATCH_CENTER+(120-offsetFromEdge)*sin(polarAngle);
+    fixedPolarToCartesian(WATCH_CENTER,WATCH_CENTER,120-offsetFromEdge,FIXED_DEGREES(150),&polarX,&polarY);
     displayDrawLineThickness(polarX+5, polarX, polarY-5, polarY+5, NUMBER_COLOR, 3);
     displayDrawLineThickness(polarX, polarX-5, polarY+5, polarY-5, NUMBER_COLOR, 3);
     displayDrawLineThickness(polarX+10, polarX+10, polarY+5, polarY-5, NUMBER_COLOR, 3);
@@ -173,16 +324,13 @@ void displayDrawWatchNumbers(int BACKGROUND_COLOR, int NUMBER_COLOR)
     displayDrawLineThickness(5+offsetFromEdge, 15+offsetFromEdge, 115, 125, NUMBER_COLOR, 3);
     displayDrawLineThickness(5+offsetFromEdge, 15+offsetFromEdge, 125, 115, NUMBER_COLOR, 3);
     //X
-    polarAngle = 3.1416*210/180;
-    polarX = WATCH_CENTER+(120-offsetFromEdge)*cos(polarAngle);
-    polarY = WATCH_CENTER+(120-offsetFromEdge)*sin(polarAngle);
+    fixedPolarToCartesian(WATCH_CENTER,WATCH_CENTER,120-offsetFromEdge,FIXED_DEGREES(210),&polarX,&polarY);
     displayDrawLineThickness(polarX-5, polarX+5, polarY-5, polarY+5, NUMBER_COLOR, 3);
     displayDrawLineThickness(polarX-5, polarX+5, polarY+5, polarY-5, NUMBER_COLOR, 3);
     //XI
-    polarAngle = 3.1416*240/180;
-    polarX = WATCH_CENTER+(120-offsetFromEdge)*cos(polarAngle);
-    polarY = WATCH_CENTER+(120-offsetFromEdge)*sin(polarAngle);
+    fixedPolarToCartesian(WATCH_CENTER,WATCH_CENTER,120-offsetFromEdge,FIXED_DEGREES(240),&polarX,&polarY);
     displayDrawLineThickness(polarX-5, polarX+5, polarY-5, polarY+5, NUMBER_COLOR, 3);
     displayDrawLineThickness(polarX-5, polarX+5, polarY+5, polarY-5, NUMBER_COLOR, 3);
     displayDrawLineThickness(polarX+10, polarX+10, polarY+5, polarY-5, NUMBER_COLOR, 3);
+    displaySpanEnd();
 }
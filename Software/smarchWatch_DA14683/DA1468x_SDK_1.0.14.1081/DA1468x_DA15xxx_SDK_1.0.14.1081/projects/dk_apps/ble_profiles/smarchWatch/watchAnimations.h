@@ -11,10 +11,33 @@
 #define WATCH_CENTER 120
 #define TICK_LENGTH 20
 
+#include "displayDriver.h"
+#include "displayDamage.h"
+
+//Clock hand lengths
+#define WATCH_HOUR_RADIUS 60
+#define WATCH_MINUTE_RADIUS 90
+#define WATCH_SECOND_RADIUS 100
+//Rows per slice when working out what a moving hand damaged
+#define WATCH_DAMAGE_SLAB_ROWS 16
+#define WATCH_DAMAGE_SLABS ((ST7789_HEIGHT+WATCH_DAMAGE_SLAB_ROWS-1)/WATCH_DAMAGE_SLAB_ROWS)
+
+//Hands in drawing order, later ones are on top
+typedef enum
+{
+    WATCH_HAND_HOUR,
+    WATCH_HAND_MINUTE,
+    WATCH_HAND_SECOND,
+    WATCH_HAND_COUNT
+} watchHandIndex_t;
+
 void displayDrawWatchHand(int RADIUS, int ANGLE, int HAND_COLOR);
 void displayDrawSecondWatchHand(int RADIUS, int ANGLE, int HAND_COLOR, int X_CENTER, int Y_CENTER);
 void displayDrawWatchFace(int BACKGROUND_COLOR, int TICK_COLOR);
 void displayDrawWatchNumbers(int BACKGROUND_COLOR, int NUMBER_COLOR);
+void displayWatchBegin(uint32_t FACE_ASSET, int HOUR_COLOR, int MINUTE_COLOR, int SECOND_COLOR);
+int  displayWatchUpdate(int HOURS, int MINUTES, int SECONDS);
+void displayWatchRedraw(const displayRect_t *RECT, void *USER_DATA);
 
 void displayDrawCharacterFromArray(int X_START, int Y_START, int COLOR, char CHARACTER);
 